@@ -5,6 +5,7 @@
 #include "hardware/gpio.h"
 #include "hardware/timer.h"
 #include "hardware/i2c.h"
+#include "hardware/sync.h"
 
 // --- Inclusão da Biblioteca OLED ---
 #include "ssd1306.h"
@@ -22,12 +23,51 @@
 #define OLED_WIDTH 128
 #define OLED_HEIGHT 64
 
+// Desenho e envio do display dentro das interrupções, como na versão
+// anterior: só para comparar as medidas (-DCONTADOR_DISPLAY_NA_ISR=ON)
+#ifndef CONTADOR_DISPLAY_NA_ISR
+#define CONTADOR_DISPLAY_NA_ISR 0
+#endif
+
+// --- Medidas ---
+// Sonda: timer periódico que mede o próprio atraso; uma interrupção longa de
+// mesma prioridade (display na ISR) aparece como atraso da sonda
+// Acorda o __wfe 1000 vezes por segundo, então só entra na medição
+// (-DCONTADOR_SONDA=ON)
+#ifndef CONTADOR_SONDA
+#define CONTADOR_SONDA 0
+#endif
+#define SONDA_PERIODO_US 1000
+
+// --- Fila de Eventos (interrupção -> laço principal) ---
+#define FILA_EVENTOS 16 // Potência de 2
+
 // Protótipos de funções da biblioteca OLED (exemplo)
 // void oled_init(i2c_inst_t *i2c, uint8_t address);
 // void oled_clear();
 // void oled_draw_string(int x, int y, int font_size, char *text);
 // void oled_show();
 
+// Eventos postados pelas interrupções; o laço principal aplica cada um ao
+// estado da contagem e redesenha o display uma vez por rodada
+typedef enum {
+    EVENTO_BOTAO_A,
+    EVENTO_BOTAO_B,
+    EVENTO_SEGUNDO       // Tick de 1 s do timer da contagem
+} tipo_evento_t;
+
+typedef struct {
+    uint8_t tipo;
+    uint8_t sessao;      // Contagem que gerou o tick (ticks de contagens antigas são ignorados)
+} evento_t;
+
+// Tempo gasto dentro de um tratador de interrupção
+typedef struct {
+    uint32_t chamadas;
+    uint32_t max_us;
+    uint64_t soma_us;
+} medida_isr_t;
+
 // --- Variáveis Globais ---
 volatile int countdown_value = 0;
 volatile int button_b_presses = 0;
@@ -39,9 +79,64 @@ volatile uint32_t last_b_press_time = 0;
 ssd1306_t oled_display;
 
 struct repeating_timer countdown_timer;
+#if CONTADOR_SONDA
+struct repeating_timer probe_timer;
+#endif
+
+// Fila de eventos: 'fila_cabeca' só é escrita em interrupção, 'fila_cauda'
+// só pelo laço. As interrupções do timer e do GPIO têm a mesma prioridade
+// (padrão do SDK) e não se aninham: há um único produtor por vez, sem trava
+static evento_t fila[FILA_EVENTOS];
+static volatile uint32_t fila_cabeca = 0;
+static volatile uint32_t fila_cauda = 0;
+static volatile uint32_t eventos_perdidos = 0;
+
+static volatile uint8_t sessao_contagem = 0;  // Incrementada a cada reinício pelo botão A
+
+static medida_isr_t medida_timer;
+static medida_isr_t medida_gpio;
+#if CONTADOR_SONDA
+static volatile uint32_t sonda_ultima_us = 0;
+static volatile uint32_t sonda_atraso_max_us = 0;
+#endif
 
 // --- Funções ---
 
+// Registra o tempo de um tratador de interrupção iniciado em 'inicio'
+static void medir_isr(medida_isr_t *m, uint32_t inicio) {
+    uint32_t duracao = time_us_32() - inicio;
+    m->chamadas++;
+    m->soma_us += duracao;
+    if (duracao > m->max_us) {
+        m->max_us = duracao;
+    }
+}
+
+// Posta um evento (só em contexto de interrupção) e acorda o __wfe do laço
+static void postar_evento(tipo_evento_t tipo, uint8_t sessao) {
+    uint32_t c = fila_cabeca;
+    if (c - fila_cauda == FILA_EVENTOS) {
+        eventos_perdidos++;
+        return;
+    }
+    fila[c % FILA_EVENTOS] = (evento_t){ (uint8_t)tipo, sessao };
+    __dmb();             // Evento gravado antes de publicar a cabeça
+    fila_cabeca = c + 1;
+    __sev();
+}
+
+// Retira o próximo evento (só no laço principal)
+static bool retirar_evento(evento_t *e) {
+    uint32_t t = fila_cauda;
+    if (t == fila_cabeca) {
+        return false;
+    }
+    *e = fila[t % FILA_EVENTOS];
+    __dmb();             // Evento lido antes de liberar a posição
+    fila_cauda = t + 1;
+    return true;
+}
+
 // Atualiza o display OLED com os valores atuais
 void update_oled_display() {
     char line1[20];
@@ -54,14 +149,67 @@ void update_oled_display() {
     ssd1306_fill(&oled_display, false); // Limpa o buffer (fundo preto)
     ssd1306_draw_string_large(&oled_display, line1, 0, 0); // Linha 1 (Contador)
     ssd1306_draw_string_large(&oled_display, line2, 0, 20); // Linha 2 (Botao B)
+
+    // Contagem parada: mostra as medidas (pior ISR e pior atraso da sonda)
+    if (!counting_active && countdown_value == 0) {
+        char line3[20];
+        sprintf(line3, "isr %lu us", (unsigned long)(medida_timer.max_us > medida_gpio.max_us ?
+                                                      medida_timer.max_us : medida_gpio.max_us));
+        ssd1306_draw_string(&oled_display, line3, 0, 44);
+#if CONTADOR_SONDA
+        char line4[20];
+        sprintf(line4, "lat %lu us", (unsigned long)sonda_atraso_max_us);
+        ssd1306_draw_string(&oled_display, line4, 0, 54);
+#endif
+    }
     ssd1306_send_data(&oled_display); // Envia o buffer para o display físico
 
     // Saída de depuração no terminal serial
     printf("Atualizacao do display -> Cont: %d, bot b: %d, Contando: %s\n", countdown_value, button_b_presses, counting_active ? "Sim" : "Nao");
 }
 
+// Imprime as medidas de interrupção acumuladas desde o boot
+void report_measurements() {
+    uint32_t estado = save_and_disable_interrupts();
+    medida_isr_t timer = medida_timer;
+    medida_isr_t gpio = medida_gpio;
+#if CONTADOR_SONDA
+    uint32_t atraso = sonda_atraso_max_us;
+#endif
+    restore_interrupts(estado);
+
+    printf("ISR timer: %lu chamadas, max %lu us, media %lu us\n", (unsigned long)timer.chamadas,
+           (unsigned long)timer.max_us, (unsigned long)(timer.chamadas ? timer.soma_us / timer.chamadas : 0));
+    printf("ISR GPIO: %lu chamadas, max %lu us, media %lu us\n", (unsigned long)gpio.chamadas,
+           (unsigned long)gpio.max_us, (unsigned long)(gpio.chamadas ? gpio.soma_us / gpio.chamadas : 0));
+#if CONTADOR_SONDA
+    printf("Pior atraso de interrupcao (sonda de %d us): %lu us\n", SONDA_PERIODO_US, (unsigned long)atraso);
+#endif
+    printf("Eventos perdidos: %lu\n", (unsigned long)eventos_perdidos);
+}
+
+#if CONTADOR_SONDA
+// Sonda de latência: o intervalo entre duas chamadas menos o período é o
+// atraso causado por interrupções que a seguraram
+bool probe_timer_callback(struct repeating_timer *t) {
+    uint32_t agora = time_us_32();
+    if (sonda_ultima_us != 0) {
+        int32_t atraso = (int32_t)(agora - sonda_ultima_us) - SONDA_PERIODO_US;
+        if (atraso > (int32_t)sonda_atraso_max_us) {
+            sonda_atraso_max_us = (uint32_t)atraso;
+        }
+    }
+    sonda_ultima_us = agora;
+    return true;
+}
+#endif
+
 // Callback do Timer (executado a cada 1 segundo)
+// Só posta o tick; a contagem e o display ficam no laço principal
 bool repeating_timer_callback(struct repeating_timer *t) {
+    uint32_t inicio = time_us_32();
+#if CONTADOR_DISPLAY_NA_ISR
+    bool continuar = true;
     if (counting_active) {
         if (countdown_value > 0) {
             countdown_value--;
@@ -71,13 +219,48 @@ bool repeating_timer_callback(struct repeating_timer *t) {
             counting_active = false;
             update_oled_display(); // Mostra o estado final
             printf("Contagem finalizada.\n");
-            return false; // Para o timer
+            report_measurements();
+            continuar = false; // Para o timer
         }
     }
-    return true; // Continua o timer
+    medir_isr(&medida_timer, inicio);
+    return continuar;
+#else
+    postar_evento(EVENTO_SEGUNDO, (uint8_t)(uintptr_t)t->user_data);
+    medir_isr(&medida_timer, inicio);
+    return true; // O laço cancela o timer no fim da contagem
+#endif
+}
+
+// Aplica o botão A: reinicia a contagem e o timer de 1 segundo
+void start_countdown() {
+    printf("Botao A pressionado!\n");
+
+    cancel_repeating_timer(&countdown_timer); // Cancela timer anterior
+
+    // Reinicia estado da contagem
+    countdown_value = 9;
+    button_b_presses = 0;
+    counting_active = true;
+    sessao_contagem++;
+
+    // Inicia novo timer de 1 segundo; ticks do timer anterior já na fila
+    // carregam a sessão antiga e são descartados
+    add_repeating_timer_ms(-1000, repeating_timer_callback, (void *)(uintptr_t)sessao_contagem, &countdown_timer);
+}
+
+// Aplica o botão B: conta o clique durante a contagem
+void count_button_b() {
+    if (counting_active) {
+        button_b_presses++;
+        printf("Botao B pressionado durante contagem! Total: %d\n", button_b_presses);
+    } else {
+        printf("Botao B pressionado fora da contagem (ignorado).\n");
+    }
 }
 
 // Callback de Interrupção GPIO (para ambos os botões)
+// Debounce pelo instante da borda; o resto fica no laço principal
 void gpio_callback(uint gpio, uint32_t events) {
     uint32_t now = time_us_32();
 
@@ -85,33 +268,57 @@ void gpio_callback(uint gpio, uint32_t events) {
     if (gpio == BUTTON_A_PIN && (events & GPIO_IRQ_EDGE_FALL)) {
         if ((now - last_a_press_time) > (DEBOUNCE_TIME_MS * 1000)) { // Debounce
             last_a_press_time = now;
-            printf("Botao A pressionado!\n");
-
-            cancel_repeating_timer(&countdown_timer); // Cancela timer anterior
-
-            // Reinicia estado da contagem
-            countdown_value = 9;
-            button_b_presses = 0;
-            counting_active = true;
-
-            // Inicia novo timer de 1 segundo
-            add_repeating_timer_ms(-1000, repeating_timer_callback, NULL, &countdown_timer);
-
+#if CONTADOR_DISPLAY_NA_ISR
+            start_countdown();
             update_oled_display(); // Atualiza display com estado inicial
+#else
+            postar_evento(EVENTO_BOTAO_A, 0);
+#endif
         }
     // Tratamento Botão B
     } else if (gpio == BUTTON_B_PIN && (events & GPIO_IRQ_EDGE_FALL)) {
          if ((now - last_b_press_time) > (DEBOUNCE_TIME_MS * 1000)) { // Debounce
             last_b_press_time = now;
-             if (counting_active) {
-                button_b_presses++;
-                printf("Botao B pressionado durante contagem! Total: %d\n", button_b_presses);
+#if CONTADOR_DISPLAY_NA_ISR
+            count_button_b();
+            if (counting_active) {
                 update_oled_display(); // Atualiza display com novo total
-             } else {
-                 printf("Botao B pressionado fora da contagem (ignorado).\n");
-             }
+            }
+#else
+            postar_evento(EVENTO_BOTAO_B, 0);
+#endif
          }
     }
+    medir_isr(&medida_gpio, now);
+}
+
+// Aplica um evento ao estado; retorna true se o display precisa ser redesenhado
+bool handle_event(const evento_t *e) {
+    switch (e->tipo) {
+        case EVENTO_BOTAO_A:
+            start_countdown();
+            return true;
+
+        case EVENTO_BOTAO_B:
+            count_button_b();
+            return counting_active;
+
+        case EVENTO_SEGUNDO:
+            if (e->sessao != sessao_contagem || !counting_active) {
+                return false; // Tick de uma contagem já reiniciada ou encerrada
+            }
+            if (countdown_value > 0) {
+                countdown_value--;
+            }
+            if (countdown_value == 0) {
+                counting_active = false;
+                cancel_repeating_timer(&countdown_timer); // Para o timer
+                printf("Contagem finalizada.\n");
+                report_measurements();
+            }
+            return true;
+    }
+    return false;
 }
 
 // Configuração dos GPIOs para os botões
@@ -161,11 +368,27 @@ int main() {
 
     setup_gpio();
     setup_oled();
+#if CONTADOR_SONDA
+    add_repeating_timer_us(-SONDA_PERIODO_US, probe_timer_callback, NULL, &probe_timer);
+#endif
 
     printf("Sistema pronto. Aguardando Botao A...\n");
 
-    // Loop principal vazio; a lógica é controlada por interrupções e timers
+    // Despachante: aplica os eventos das interrupções e redesenha o display
+    // uma vez por rodada (vários eventos seguidos viram um único envio I2C)
     while (1) {
-        tight_loop_contents(); // Mantém o processador ocupado ou __wfi(); para baixo consumo
+        evento_t e;
+        bool redesenhar = false;
+
+        while (retirar_evento(&e)) {
+            redesenhar |= handle_event(&e);
+        }
+        if (redesenhar) {
+            update_oled_display();
+        }
+
+        // Dorme até o próximo evento: postar_evento faz __sev, então um
+        // evento postado depois do último teste da fila não é perdido
+        __wfe();
     }
-}
\ No newline at end of file
+}
@@ -4,6 +4,8 @@
 #include "hardware/i2c.h"           
 #include "ssd1306.h"              
 #include "font.h"                 
+#include "adc_amostrador.h"       // Amostragem contínua do ADC por DMA
+#include "joystick_filtro.h"      // Filtro, calibração automática e eventos de direção
 
 // --- Configurações do Hardware ---
 
@@ -16,8 +18,18 @@
 
 #define SSD1306_I2C_ADDR 0x3C   // Endereço I2C do display OLED
 
-#define ADC_CENTER_X 1998       // Valor ADC central calibrado para o eixo X
-#define ADC_CENTER_Y 2018       // Valor ADC central calibrado para o eixo Y
+#define PERIODO_AMOSTRA_MS 10   // Intervalo entre amostras entregues ao filtro
+#define PERIODO_DISPLAY_MS 200  // Intervalo entre atualizações do display
+
+#define ADC_TAXA_HZ 32000       // Conversões por segundo nos dois eixos (16 kHz por eixo)
+
+static const char *nomes_direcao[] = {"centro", "direita", "esquerda", "baixo", "cima"};
+
+// Chamada pelo filtro a cada direção confirmada (após o debounce)
+static void evento_joystick(joystick_dir_t direcao, uint32_t instante_ms, void *contexto) {
+    (void)contexto;
+    printf("%lu ms: %s\n", (unsigned long)instante_ms, nomes_direcao[direcao]);
+}
 
 // --- Função Principal ---
 int main() {
@@ -28,7 +40,8 @@ int main() {
     adc_init();                 // Inicializa o hardware ADC
     adc_gpio_init(26 + JOYSTICK_X_CHANNEL); // Configura pino GPIO do eixo X como entrada ADC
     adc_gpio_init(26 + JOYSTICK_Y_CHANNEL); // Configura pino GPIO do eixo Y como entrada ADC
-    printf("ADC inicializado.\n");
+    adc_amostrador_iniciar((1u << JOYSTICK_X_CHANNEL) | (1u << JOYSTICK_Y_CHANNEL), ADC_TAXA_HZ); // Round-robin + DMA contínuo
+    printf("ADC inicializado (amostragem continua a %d Hz).\n", ADC_TAXA_HZ);
 
     i2c_init(I2C_PORT, 400 * 1000); // Inicializa I2C1 com clock de 400kHz
     gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C); // Define função do pino SDA como I2C
@@ -46,31 +59,37 @@ int main() {
 
     char buffer[32];            // Buffer para formatar strings de texto
 
+    joystick_filtro_t filtro;   // O centro é aprendido nas primeiras amostras com o joystick solto
+    joystick_filtro_iniciar(&filtro, evento_joystick, NULL);
+    uint32_t proximo_display = 0;
+
     printf("Entrando no loop principal.\n");
     while (true) {              // Loop infinito principal
-        adc_select_input(JOYSTICK_X_CHANNEL); // Seleciona canal ADC do eixo X
-        uint16_t x_value_raw = adc_read();      // Lê valor raw do ADC X (0-4095)
-
-        adc_select_input(JOYSTICK_Y_CHANNEL); // Seleciona canal ADC do eixo Y
-        uint16_t y_value_raw = adc_read();      // Lê valor raw do ADC Y (0-4095)
-        
-        // Calcula valores ajustados subtraindo o centro calibrado (resultado pode ser negativo)
-        int x_adjusted = (int)x_value_raw - ADC_CENTER_X;
-        int y_adjusted = (int)y_value_raw - ADC_CENTER_Y;
-        
-        // Opcional: Imprimir leituras no terminal serial para depuração
-        // printf("ADC Raw(X:%d, Y:%d) Adj(X:%d, Y:%d)\n", x_value_raw, y_value_raw, x_adjusted, y_adjusted);
- 
-        ssd1306_fill(&ssd, false); // Limpa o buffer local antes de desenhar
-
-        snprintf(buffer, sizeof(buffer), "X:%5d", x_adjusted); // Formata string do eixo X
-        ssd1306_draw_string(&ssd, buffer, 0, 0); // Desenha string X no buffer local (Y=0)
-
-        snprintf(buffer, sizeof(buffer), "Y:%5d", y_adjusted); // Formata string do eixo Y
-        ssd1306_draw_string(&ssd, buffer, 0, 16);// Desenha string Y no buffer local (Y=16)
-
-        ssd1306_send_data(&ssd);    // Envia o buffer local atualizado para o display OLED via I2C
-        
-        sleep_ms(200);              // Pausa antes da próxima iteração
+        uint32_t agora = to_ms_since_boot(get_absolute_time());
+        uint16_t x_value_raw = adc_amostrador_ler(JOYSTICK_X_CHANNEL); // Média das últimas 16 amostras do eixo X (0-4095)
+        uint16_t y_value_raw = adc_amostrador_ler(JOYSTICK_Y_CHANNEL); // Média das últimas 16 amostras do eixo Y (0-4095)
+        joystick_dir_t direcao = joystick_filtro_amostra(&filtro, x_value_raw, y_value_raw, agora); // Eventos saem pelo callback
+
+        if ((int32_t)(agora - proximo_display) >= 0) {
+            proximo_display = agora + PERIODO_DISPLAY_MS;
+
+            // Desvio filtrado em relação ao centro aprendido (pode ser negativo)
+            int32_t x_adjusted, y_adjusted;
+            joystick_filtro_desvio(&filtro, &x_adjusted, &y_adjusted);
+
+            ssd1306_fill(&ssd, false); // Limpa o buffer local antes de desenhar
+
+            snprintf(buffer, sizeof(buffer), "X:%5ld", (long)x_adjusted); // Formata string do eixo X
+            ssd1306_draw_string(&ssd, buffer, 0, 0); // Desenha string X no buffer local (Y=0)
+
+            snprintf(buffer, sizeof(buffer), "Y:%5ld", (long)y_adjusted); // Formata string do eixo Y
+            ssd1306_draw_string(&ssd, buffer, 0, 16);// Desenha string Y no buffer local (Y=16)
+
+            ssd1306_draw_string(&ssd, filtro.calibrado ? nomes_direcao[direcao] : "calibrando", 0, 32); // Direção confirmada
+
+            ssd1306_send_data(&ssd);    // Envia o buffer local atualizado para o display OLED via I2C
+        }
+
+        sleep_ms(PERIODO_AMOSTRA_MS); // Pausa até a próxima amostra do filtro
     } 
 } 
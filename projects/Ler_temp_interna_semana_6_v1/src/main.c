@@ -1,40 +1,101 @@
-#include <stdio.h>          
-#include "pico/stdlib.h"    
-#include "hardware/adc.h"     
+#include <stdio.h>
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "temperatura.h"      // Conversão em ponto fixo e fluxo com média (comum/temperatura)
+#include "temperatura_adc.h"  // Rajadas de 256 leituras por FIFO + DMA
+#include "serie.h"            // Registro compacto das médias (comum/serie)
+#include "serie_flash.h"      // Páginas do registro no fim da flash
 
 
-#define ADC_TEMP_CHANNEL 4    // Canal ADC correspondente ao sensor de temperatura interno
+#define PERIODO_CONVERSAO_MS 100    // Uma rajada sobreamostrada a cada 100 ms
+#define PERIODO_SAIDA_MS     1000   // Média das conversões, impressa uma vez por segundo
+#define PASSO_RESUMO_MS      60000  // Média por minuto no comando 'r'
+#define PERIODO_SELO_MS      600000 // Sela a página aberta a cada 10 min: um reset perde no máximo isso
 
-// Função para converter o valor lido do ADC para temperatura em graus Celsius
-float adc_to_temperature(uint16_t adc_value) {
-    // Fator de conversão: 3.3V dividido pela resolução do ADC (12 bits: 4096 níveis)
-    const float conversion_factor = 3.3f / (1 << 12);  // Define o fator de conversão de tensão (3.3 / 4096)
-    float voltage = adc_value * conversion_factor;      // Converte o valor ADC lido para tensão.
+static serie_t registro;            // Médias de 1 s: ~2 bytes cada, páginas de 10 min, ~10 h em 256 KB de flash
+static serie_meio_t flash;
 
-    // Fórmula para converter a tensão em temperatura (conforme datasheet do RP2040)
-    float temperature_celsius = 27.0f - (voltage - 0.706f) / 0.001721f; // Calcula a temperatura em Celsius usando a fórmula do datasheet.
-    return temperature_celsius; // Retorna a temperatura calculada.
+// Imprime o registro em CSV (instante_ms,centesimos), da mais antiga à mais nova
+// O instante é o do registro: cada boot continua do último gravado
+static void imprimir_registro(uint32_t passo_ms) {
+    serie_consulta_t consulta;
+    serie_amostra_t amostra;
+
+    serie_consulta_iniciar(&consulta, &registro, 0, UINT32_MAX, passo_ms);
+    while (serie_consulta_proxima(&consulta, &amostra, NULL)) {
+        printf("%lu,%ld\n", (unsigned long)amostra.instante_ms, (long)amostra.valores[0]);
+    }
+    printf("%lu amostras nesta sessao (%u, desde %lu ms), %lu paginas na flash\n",
+           (unsigned long)registro.metricas.amostras, registro.sessao, (unsigned long)registro.base_ms,
+           (unsigned long)registro.meio_total);
+}
+
+// Comandos pela serial: 'd' imprime tudo, 'r' a média por minuto,
+// 's' sela a página aberta (antes de desligar), 'x' apaga
+static void tratar_comando(void) {
+    int c = getchar_timeout_us(0);
+
+    if (c == 'd') {
+        imprimir_registro(0);
+    } else if (c == 'r') {
+        imprimir_registro(PASSO_RESUMO_MS);
+    } else if (c == 's') {
+        serie_selar(&registro);
+        while (serie_descarregar(&registro)) {
+        }
+        printf("Registro selado\n");
+    } else if (c == 'x') {
+        if (serie_flash_apagar()) {
+            serie_iniciar(&registro, 1, &flash);
+            printf("Registro apagado\n");
+        } else {
+            printf("ERRO: flash ocupada, registro mantido\n");
+        }
+    }
 }
 
 // Função principal do programa.
 int main() {
     stdio_init_all();           // Inicializa todas as interfaces de E/S padrão (incluindo USB para printf).
 
-    adc_init();                 // Inicializa o hardware do ADC.
+    temperatura_adc_iniciar();  // Liga o sensor interno, o FIFO do ADC e o canal de DMA.
 
-    adc_set_temp_sensor_enabled(true); // Habilita o sensor de temperatura interno do RP2040.
+    serie_flash_meio(&flash);
+    serie_iniciar(&registro, 1, &flash);    // Continua o registro gravado antes do reset.
 
-    adc_select_input(ADC_TEMP_CHANNEL); // Seleciona o canal ADC a ser lido (sensor de temperatura).
+    temperatura_fluxo_t fluxo;
+    temperatura_fluxo_iniciar(&fluxo, PERIODO_SAIDA_MS);
+
+    absolute_time_t proxima = get_absolute_time();
+    uint32_t selado_ms = to_ms_since_boot(proxima);
+    temperatura_adc_disparar(); // Primeira rajada.
 
     // Loop infinito para leitura contínua da temperatura.
     while (true) {
-        uint16_t adc_value = adc_read(); // Lê o valor digital bruto do canal ADC selecionado.
-
-        float temperature = adc_to_temperature(adc_value); // Converte o valor ADC lido para temperatura em graus Celsius.
+        uint16_t codigo;
+        if (temperatura_adc_pronta(&codigo)) {  // Rajada concluída: código sobreamostrado (leitura * 16).
+            int32_t media;
+            int32_t centi = temperatura_centi(codigo);  // Centésimos de grau, sem float.
 
-        printf("Temperatura interna: %.2f °C\n", temperature); // Imprime a temperatura formatada na saída padrão (USB/Serial).
+            if (temperatura_fluxo_amostra(&fluxo, centi, to_ms_since_boot(get_absolute_time()), &media)) {
+                // Imprime a média da última janela com duas casas, só com inteiros.
+                printf("Temperatura interna: %s%ld.%02ld °C\n", media < 0 ? "-" : "",
+                       labs(media) / 100, labs(media) % 100);
+                uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+                serie_acrescentar(&registro, agora_ms, &media);
+                if (agora_ms - selado_ms >= PERIODO_SELO_MS) {
+                    serie_selar(&registro);     // Página de 10 min vai para a flash mesmo sem encher.
+                    selado_ms = agora_ms;
+                }
+                serie_descarregar(&registro);   // Página selada vai para a flash (~45 ms).
+            }
+            tratar_comando();
 
-        sleep_ms(1000);         // Pausa a execução por 1000 milissegundos (1 segundo).
-    } 
+            proxima = delayed_by_ms(proxima, PERIODO_CONVERSAO_MS);
+            sleep_until(proxima);       // Pausa até a próxima conversão.
+            temperatura_adc_disparar();
+        }
+        tight_loop_contents();  // A rajada leva ~2,6 ms.
+    }
 
-} 
+}
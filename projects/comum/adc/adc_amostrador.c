@@ -0,0 +1,93 @@
+// Amostrador contínuo do ADC por round-robin + DMA (ver adc_amostrador.h)
+// O canal de dados copia do FIFO do ADC para o anel, uma volta por disparo,
+// e ao terminar dispara o canal de controle, que escreve o início do anel no
+// registrador de endereço com gatilho do canal de dados (o contador de
+// transferências é recarregado a cada disparo); o laço segue sem a CPU
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include "adc_amostrador.h"
+
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+
+// Anel de amostras: grupo g, entrada na posição p -> amostras[g * entradas + p]
+static volatile uint16_t amostras[ADC_AMOSTRADOR_MAX_ENTRADAS * ADC_AMOSTRADOR_GRUPOS];
+static uint16_t *inicio_anel;         // Lido pelo canal de controle a cada volta
+static uint32_t total_amostras;       // Amostras por volta do anel
+static uint total_entradas;
+static int8_t posicao_entrada[ADC_AMOSTRADOR_MAX_ENTRADAS];   // -1: fora da máscara
+static int canal_dados = -1;
+static int canal_controle = -1;
+
+// Próxima posição que o DMA vai escrever (0 a total_amostras - 1)
+// No instante da recarga o contador volta ao total e a posição a 0
+static uint32_t posicao_escrita(void) {
+    uint32_t restantes = dma_channel_hw_addr(canal_dados)->transfer_count;
+    return (total_amostras - restantes) % total_amostras;
+}
+
+void adc_amostrador_iniciar(uint mascara, uint32_t taxa_hz) {
+    total_entradas = 0;
+    for (uint i = 0; i < ADC_AMOSTRADOR_MAX_ENTRADAS; i++) {
+        posicao_entrada[i] = (mascara & (1u << i)) ? (int8_t)total_entradas++ : -1;
+    }
+    total_amostras = total_entradas * ADC_AMOSTRADOR_GRUPOS;
+    inicio_anel = (uint16_t *)amostras;
+
+    // Rodízio a partir da menor entrada: a ordem no grupo é a crescente
+    adc_run(false);
+    adc_select_input(__builtin_ctz(mascara));
+    adc_set_round_robin(mascara);
+    adc_fifo_setup(true, true, 1, false, false);     // DREQ a cada amostra, 12 bits
+    adc_fifo_drain();
+    adc_set_clkdiv((float)(clock_get_hz(clk_adc) / taxa_hz - 1u));   // Período = 1 + div ciclos
+
+    canal_dados = dma_claim_unused_channel(true);
+    canal_controle = dma_claim_unused_channel(true);
+
+    // Dados: FIFO do ADC -> anel, 16 bits, no ritmo do DREQ; encadeia no controle
+    dma_channel_config c = dma_channel_get_default_config(canal_dados);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    channel_config_set_chain_to(&c, canal_controle);
+    dma_channel_configure(canal_dados, &c, inicio_anel, &adc_hw->fifo, total_amostras, false);
+
+    // Controle: uma palavra (início do anel) no endereço de escrita com gatilho
+    dma_channel_config k = dma_channel_get_default_config(canal_controle);
+    channel_config_set_transfer_data_size(&k, DMA_SIZE_32);
+    channel_config_set_read_increment(&k, false);
+    channel_config_set_write_increment(&k, false);
+    dma_channel_configure(canal_controle, &k, &dma_hw->ch[canal_dados].al2_write_addr_trig,
+                          &inicio_anel, 1, false);
+
+    dma_channel_start(canal_dados);
+    adc_run(true);
+
+    // Primeira volta: espera os grupos que a leitura soma
+    while (posicao_escrita() < (ADC_AMOSTRADOR_SOBREAMOSTRAGEM + 1) * total_entradas) {
+        tight_loop_contents();
+    }
+}
+
+uint16_t adc_amostrador_ler_16bits(uint entrada) {
+    if (entrada >= ADC_AMOSTRADOR_MAX_ENTRADAS || posicao_entrada[entrada] < 0) {
+        return 0;
+    }
+    // O grupo em escrita pode estar incompleto: começa pelo anterior
+    uint32_t grupo = posicao_escrita() / total_entradas;
+    uint32_t soma = 0;
+    for (uint32_t k = 1; k <= ADC_AMOSTRADOR_SOBREAMOSTRAGEM; k++) {
+        uint32_t g = (grupo + ADC_AMOSTRADOR_GRUPOS - k) % ADC_AMOSTRADOR_GRUPOS;
+        soma += amostras[g * total_entradas + (uint32_t)posicao_entrada[entrada]];
+    }
+    return (uint16_t)soma;
+}
+
+uint16_t adc_amostrador_ler(uint entrada) {
+    return (uint16_t)((adc_amostrador_ler_16bits(entrada) + ADC_AMOSTRADOR_SOBREAMOSTRAGEM / 2) /
+                      ADC_AMOSTRADOR_SOBREAMOSTRAGEM);
+}
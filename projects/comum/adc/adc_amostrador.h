@@ -0,0 +1,40 @@
+// Amostrador contínuo do ADC do RP2040 por round-robin + DMA
+// O ADC converte em rodízio as entradas da máscara (adc_set_round_robin) no
+// ritmo do divisor de clock; o FIFO pede DMA a cada amostra e o DMA grava num
+// anel de grupos (uma amostra por entrada, na ordem crescente das entradas)
+// Um segundo canal de DMA, encadeado ao primeiro, rearma o endereço do anel
+// ao fim de cada volta: depois de iniciado, nada passa pela CPU (sem IRQ)
+// A leitura é sem trava: soma as ADC_AMOSTRADOR_SOBREAMOSTRAGEM amostras mais
+// recentes da entrada a partir da posição atual do DMA; uma posição do anel
+// sempre guarda uma amostra válida da mesma entrada
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef ADC_AMOSTRADOR_H
+#define ADC_AMOSTRADOR_H
+
+#include <stdint.h>
+#include "pico/types.h"
+
+// Entradas do ADC: GPIO 26 a 29 e sensor de temperatura interno (4)
+#define ADC_AMOSTRADOR_MAX_ENTRADAS 5
+
+// Grupos no anel e amostras somadas por leitura (16x: +2 bits efetivos com
+// ruído suficiente); o anel tem folga para o DMA não alcançar a leitura
+#define ADC_AMOSTRADOR_GRUPOS       32
+#define ADC_AMOSTRADOR_SOBREAMOSTRAGEM 16
+
+// Inicia a conversão contínua das entradas em 'mascara' (bit n = entrada n),
+// com 'taxa_hz' conversões por segundo somando todas as entradas (até 500 kHz)
+// As GPIOs já devem estar em modo ADC (adc_gpio_init); o sensor de
+// temperatura precisa de adc_set_temp_sensor_enabled
+// Retorna depois de o anel ter amostras suficientes para a primeira leitura
+void adc_amostrador_iniciar(uint mascara, uint32_t taxa_hz);
+
+// Média das amostras mais recentes da entrada, em 12 bits (0-4095)
+uint16_t adc_amostrador_ler(uint entrada);
+
+// Soma das amostras mais recentes da entrada (0 a 16 * 4095): resolução
+// estendida da sobreamostragem, sem descartar os bits abaixo do LSB
+uint16_t adc_amostrador_ler_16bits(uint entrada);
+
+#endif // ADC_AMOSTRADOR_H
@@ -0,0 +1,160 @@
+// Debounce por instantes e gestos dos botões (ver botoes_gestos.h)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include "botoes_gestos.h"
+
+#include <string.h>
+
+static void emitir(botoes_gestos_t *g, botao_gesto_t gesto, uint8_t botao, uint64_t instante_us) {
+    botao_evento_t evento = { gesto, botao, instante_us };
+
+    if (g->emitir != NULL) {
+        g->emitir(&evento, g->contexto);
+    }
+}
+
+// Emite a pressão (retida ou não) com o instante da borda original
+static void confirmar_pressao(botoes_gestos_t *g, uint8_t i) {
+    botao_estado_t *b = &g->botoes[i];
+
+    b->retido = false;
+    emitir(g, BOTAO_PRESSIONADO, i, b->pressionado_us);
+    if (b->duplo) {
+        emitir(g, BOTAO_DUPLO, i, b->pressionado_us);
+    }
+}
+
+// Os outros botões do acorde estão retidos e dentro da janela
+static bool acorde_completo(const botoes_gestos_t *g, uint8_t i, uint64_t instante_us) {
+    for (uint8_t j = 0; j < g->total; j++) {
+        const botao_estado_t *b = &g->botoes[j];
+        if (j == i || !(g->mascara_acorde & (1u << j))) {
+            continue;
+        }
+        if (!b->retido || instante_us - b->pressionado_us > BOTOES_ACORDE_US) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void pressionar(botoes_gestos_t *g, uint8_t i, uint64_t instante_us) {
+    botao_estado_t *b = &g->botoes[i];
+
+    b->pressionado_us = instante_us;
+    b->longo_emitido = false;
+    b->em_acorde = false;
+    b->duplo = b->clique_curto && instante_us - b->solto_us <= BOTOES_DUPLO_US;
+
+    if (!(g->mascara_acorde & (1u << i))) {
+        confirmar_pressao(g, i);
+        return;
+    }
+    if (acorde_completo(g, i, instante_us)) {
+        for (uint8_t j = 0; j < g->total; j++) {
+            if (g->mascara_acorde & (1u << j)) {
+                g->botoes[j].retido = false;
+                g->botoes[j].em_acorde = true;
+            }
+        }
+        emitir(g, BOTAO_ACORDE, i, instante_us);
+        return;
+    }
+    b->retido = true;           // Espera o parceiro até BOTOES_ACORDE_US
+}
+
+static void soltar(botoes_gestos_t *g, uint8_t i, uint64_t instante_us) {
+    botao_estado_t *b = &g->botoes[i];
+
+    if (b->retido) {
+        confirmar_pressao(g, i);    // Solto antes do parceiro: clique simples
+    }
+    emitir(g, BOTAO_SOLTO, i, instante_us);
+    b->clique_curto = !b->longo_emitido && !b->em_acorde && !b->duplo;
+    b->solto_us = instante_us;
+}
+
+// Transição aceita: abre a janela de ressalto a partir do instante dela
+static void aceitar(botoes_gestos_t *g, uint8_t i, bool pressionado, uint64_t instante_us) {
+    botao_estado_t *b = &g->botoes[i];
+
+    b->pressionado = pressionado;
+    b->bloqueio_ate_us = instante_us + BOTOES_DEBOUNCE_US;
+    if (pressionado) {
+        pressionar(g, i, instante_us);
+    } else {
+        soltar(g, i, instante_us);
+    }
+}
+
+void botoes_gestos_iniciar(botoes_gestos_t *g, uint8_t total, uint8_t mascara_acorde,
+                           uint8_t pressionados, botoes_emitir_t emitir, void *contexto) {
+    memset(g, 0, sizeof(*g));
+    g->total = total > BOTOES_MAX ? BOTOES_MAX : total;
+    g->mascara_acorde = mascara_acorde;
+    g->emitir = emitir;
+    g->contexto = contexto;
+    for (uint8_t i = 0; i < g->total; i++) {
+        botao_estado_t *b = &g->botoes[i];
+        b->pressionado = b->bruto = (pressionados >> i) & 1u;
+        b->longo_emitido = b->pressionado;
+    }
+}
+
+void botoes_gestos_borda(botoes_gestos_t *g, uint8_t botao, bool pressionado, uint64_t instante_us) {
+    if (botao >= g->total) {
+        return;
+    }
+    // Prazos vencidos antes desta borda saem antes dela
+    botoes_gestos_tempo(g, instante_us);
+
+    botao_estado_t *b = &g->botoes[botao];
+    b->bruto = pressionado;
+    b->borda_bruta_us = instante_us;
+    if (instante_us < b->bloqueio_ate_us) {
+        return;                 // Ressalto: o nível final é conferido no fim da janela
+    }
+    if (pressionado != b->pressionado) {
+        aceitar(g, botao, pressionado, instante_us);
+    }
+}
+
+void botoes_gestos_tempo(botoes_gestos_t *g, uint64_t agora_us) {
+    for (uint8_t i = 0; i < g->total; i++) {
+        botao_estado_t *b = &g->botoes[i];
+
+        // Fim da janela com o nível diferente: a última borda do ressalto vale
+        if (b->bruto != b->pressionado && agora_us >= b->bloqueio_ate_us) {
+            aceitar(g, i, b->bruto, b->borda_bruta_us);
+        }
+        if (b->retido && agora_us >= b->pressionado_us + BOTOES_ACORDE_US) {
+            confirmar_pressao(g, i);
+        }
+        if (b->pressionado && !b->retido && !b->longo_emitido && !b->em_acorde &&
+            agora_us >= b->pressionado_us + BOTOES_LONGO_US) {
+            b->longo_emitido = true;
+            emitir(g, BOTAO_LONGO, i, b->pressionado_us + BOTOES_LONGO_US);
+        }
+    }
+}
+
+uint64_t botoes_gestos_prazo(const botoes_gestos_t *g) {
+    uint64_t prazo = BOTOES_SEM_PRAZO;
+
+    for (uint8_t i = 0; i < g->total; i++) {
+        const botao_estado_t *b = &g->botoes[i];
+        uint64_t p = BOTOES_SEM_PRAZO;
+
+        if (b->bruto != b->pressionado) {
+            p = b->bloqueio_ate_us;
+        } else if (b->retido) {
+            p = b->pressionado_us + BOTOES_ACORDE_US;
+        } else if (b->pressionado && !b->longo_emitido && !b->em_acorde) {
+            p = b->pressionado_us + BOTOES_LONGO_US;
+        }
+        if (p < prazo) {
+            prazo = p;
+        }
+    }
+    return prazo;
+}
@@ -0,0 +1,86 @@
+// Debounce por instantes e detecção de gestos dos botões
+// Recebe as bordas já com o instante da interrupção (botoes_irq.c) e decide
+// tudo pelos instantes, sem ler o GPIO de novo: a primeira borda depois de
+// um período estável é aceita na hora, com o seu instante; as bordas dentro
+// da janela de debounce são ressalto e só o nível final conta, conferido no
+// fim da janela
+// Gestos: pressionado, solto, longo (segurado por BOTOES_LONGO_US), duplo
+// (segunda pressão curta logo após soltar) e acorde (todos os botões da
+// máscara pressionados dentro de BOTOES_ACORDE_US). Um botão que participa de
+// acorde tem a pressão retida por BOTOES_ACORDE_US esperando o parceiro;
+// os demais não têm atraso
+// Sem dependência de hardware: testado no host (host/botoes_teste.c)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#ifndef BOTOES_GESTOS_H
+#define BOTOES_GESTOS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BOTOES_MAX              4
+
+// Tempos dos gestos, em microssegundos
+#define BOTOES_DEBOUNCE_US      20000   // Janela de ressalto após uma borda aceita
+#define BOTOES_LONGO_US         800000  // Pressão longa
+#define BOTOES_DUPLO_US         300000  // Soltar -> pressionar de novo
+#define BOTOES_ACORDE_US        50000   // Diferença máxima entre as pressões do acorde
+
+// Sem prazo pendente (botoes_gestos_prazo)
+#define BOTOES_SEM_PRAZO        UINT64_MAX
+
+typedef enum {
+    BOTAO_PRESSIONADO,          // Instante da borda de pressão
+    BOTAO_SOLTO,                // Instante da borda de soltura
+    BOTAO_LONGO,                // Pressão + BOTOES_LONGO_US, ainda segurado
+    BOTAO_DUPLO,                // Logo após o PRESSIONADO da segunda pressão
+    BOTAO_ACORDE                // Instante da última pressão do acorde
+} botao_gesto_t;
+
+typedef struct {
+    botao_gesto_t gesto;
+    uint8_t botao;              // Índice do botão (no acorde, o último pressionado)
+    uint64_t instante_us;       // Instante em que o gesto aconteceu
+} botao_evento_t;
+
+// Chamada para cada gesto detectado, em ordem
+typedef void (*botoes_emitir_t)(const botao_evento_t *evento, void *contexto);
+
+typedef struct {
+    bool pressionado;           // Estado após o debounce
+    bool bruto;                 // Nível da última borda recebida
+    uint64_t borda_bruta_us;    // Instante da última borda recebida
+    uint64_t bloqueio_ate_us;   // Fim da janela de ressalto
+    uint64_t pressionado_us;    // Instante da pressão atual
+    uint64_t solto_us;          // Instante da última soltura
+    bool retido;                // Pressão esperando o parceiro do acorde
+    bool duplo;                 // Pressão atual é a segunda de um duplo
+    bool longo_emitido;
+    bool em_acorde;
+    bool clique_curto;          // Última pressão foi curta e fora de acorde
+} botao_estado_t;
+
+typedef struct {
+    botao_estado_t botoes[BOTOES_MAX];
+    uint8_t total;
+    uint8_t mascara_acorde;     // Bit n = botão n participa do acorde (0: sem acorde)
+    botoes_emitir_t emitir;
+    void *contexto;
+} botoes_gestos_t;
+
+// Prepara o detector; 'pressionados' (bit n = botão n) é o nível na partida
+// Um botão já pressionado na partida não gera PRESSIONADO nem LONGO
+void botoes_gestos_iniciar(botoes_gestos_t *g, uint8_t total, uint8_t mascara_acorde,
+                           uint8_t pressionados, botoes_emitir_t emitir, void *contexto);
+
+// Entrega uma borda, na ordem em que aconteceram
+void botoes_gestos_borda(botoes_gestos_t *g, uint8_t botao, bool pressionado, uint64_t instante_us);
+
+// Avança o tempo até 'agora_us': fim de janelas de ressalto, acorde e longo
+// Chamar depois de entregar as bordas até esse instante
+void botoes_gestos_tempo(botoes_gestos_t *g, uint64_t agora_us);
+
+// Próximo instante em que botoes_gestos_tempo() pode emitir algo
+uint64_t botoes_gestos_prazo(const botoes_gestos_t *g);
+
+#endif // BOTOES_GESTOS_H
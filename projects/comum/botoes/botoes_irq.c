@@ -0,0 +1,177 @@
+// Botões por interrupção de borda (ver botoes_irq.h)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include "botoes_irq.h"
+
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+typedef struct {
+    uint64_t instante_us;
+    uint8_t botao;
+    bool pressionado;
+} borda_t;
+
+// Anel de bordas: 'cabeca' só é escrita pela interrupção, 'cauda' só pelo laço
+static borda_t anel[BOTOES_ANEL_BORDAS];
+static volatile uint32_t cabeca;
+static volatile uint32_t cauda;
+
+static uint pinos_botoes[BOTOES_MAX];
+static uint32_t mascara_pinos;
+static botoes_gestos_t gestos;
+
+// Fila de gestos prontos, preenchida e lida só pelo laço
+static botao_evento_t fila[BOTOES_FILA_GESTOS];
+static uint32_t fila_inicio, fila_total;
+
+static botoes_metricas_t metricas;
+
+static void tratar_borda(void) {
+    uint64_t agora = time_us_64();
+
+    for (uint8_t i = 0; i < gestos.total; i++) {
+        uint32_t eventos = gpio_get_irq_event_mask(pinos_botoes[i]);
+        if (eventos == 0) {
+            continue;
+        }
+        gpio_acknowledge_irq(pinos_botoes[i], eventos);
+        metricas.bordas++;
+
+        // As duas bordas travadas juntas: vale o nível atual
+        bool pressionado;
+        if (eventos == GPIO_IRQ_EDGE_FALL) {
+            pressionado = true;
+        } else if (eventos == GPIO_IRQ_EDGE_RISE) {
+            pressionado = false;
+        } else {
+            pressionado = !gpio_get(pinos_botoes[i]);
+        }
+
+        uint32_t c = cabeca;
+        if (c - cauda == BOTOES_ANEL_BORDAS) {
+            metricas.bordas_perdidas++;
+            continue;
+        }
+        anel[c % BOTOES_ANEL_BORDAS] = (borda_t){ agora, i, pressionado };
+        __dmb();                // Entrada gravada antes de publicar a cabeça
+        cabeca = c + 1;
+    }
+}
+
+static void enfileirar(const botao_evento_t *evento, void *contexto) {
+    (void)contexto;
+    if (fila_total == BOTOES_FILA_GESTOS) {
+        metricas.gestos_perdidos++;
+        return;
+    }
+    fila[(fila_inicio + fila_total) % BOTOES_FILA_GESTOS] = *evento;
+    fila_total++;
+}
+
+void botoes_iniciar(const uint *pinos, uint8_t total, uint8_t mascara_acorde) {
+    uint8_t pressionados = 0;
+
+    if (total > BOTOES_MAX) {
+        total = BOTOES_MAX;
+    }
+    mascara_pinos = 0;
+    for (uint8_t i = 0; i < total; i++) {
+        pinos_botoes[i] = pinos[i];
+        mascara_pinos |= 1u << pinos[i];
+        gpio_init(pinos[i]);
+        gpio_set_dir(pinos[i], GPIO_IN);
+        gpio_pull_up(pinos[i]);
+    }
+    sleep_us(10);               // Pull-up estabiliza antes do nível inicial
+    for (uint8_t i = 0; i < total; i++) {
+        pressionados |= (uint8_t)(!gpio_get(pinos[i]) << i);
+    }
+    botoes_gestos_iniciar(&gestos, total, mascara_acorde, pressionados, enfileirar, NULL);
+
+    // Tratador bruto só para estes pinos: convive com gpio_set_irq_callback
+    gpio_add_raw_irq_handler_masked(mascara_pinos, tratar_borda);
+    for (uint8_t i = 0; i < total; i++) {
+        gpio_acknowledge_irq(pinos[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE);
+        gpio_set_irq_enabled(pinos[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+    }
+    irq_set_enabled(IO_IRQ_BANK0, true);
+}
+
+bool botoes_ler(botao_evento_t *evento) {
+    // Instante lido antes de esvaziar o anel: nenhuma borda até ele fica para trás
+    uint64_t agora = time_us_64();
+
+    while (cauda != cabeca) {
+        uint32_t t = cauda;
+        borda_t b = anel[t % BOTOES_ANEL_BORDAS];
+        __dmb();                // Entrada lida antes de liberar a posição
+        cauda = t + 1;
+        botoes_gestos_borda(&gestos, b.botao, b.pressionado, b.instante_us);
+    }
+    botoes_gestos_tempo(&gestos, agora);
+
+    if (fila_total == 0) {
+        return false;
+    }
+    *evento = fila[fila_inicio];
+    fila_inicio = (fila_inicio + 1) % BOTOES_FILA_GESTOS;
+    fila_total--;
+
+    uint64_t entrega = time_us_64();
+    uint32_t latencia = entrega > evento->instante_us ? (uint32_t)(entrega - evento->instante_us) : 0;
+    metricas.gestos++;
+    metricas.latencia_soma_us += latencia;
+    if (latencia > metricas.latencia_max_us) {
+        metricas.latencia_max_us = latencia;
+    }
+    return true;
+}
+
+static int64_t alarme_despertar(alarm_id_t id, void *contexto) {
+    (void)id;
+    (void)contexto;
+    return 0;                   // Só acorda o __wfi
+}
+
+void botoes_esperar(uint64_t limite_us) {
+    uint64_t prazo = botoes_gestos_prazo(&gestos);
+    alarm_id_t alarme = 0;
+
+    if (limite_us < prazo) {
+        prazo = limite_us;
+    }
+    if (fila_total > 0 || prazo <= time_us_64()) {
+        return;
+    }
+    if (prazo != BOTOES_SEM_PRAZO) {
+        alarme = add_alarm_at(from_us_since_boot(prazo), alarme_despertar, NULL, true);
+        if (alarme <= 0) {
+            return;             // Prazo já passou ou sem alarme livre
+        }
+    }
+
+    // Com as interrupções mascaradas uma borda entre o teste e o __wfi fica
+    // pendente e acorda o __wfi na hora
+    uint32_t estado = save_and_disable_interrupts();
+    if (cauda == cabeca) {
+        __wfi();
+    }
+    restore_interrupts(estado);
+
+    if (alarme > 0) {
+        cancel_alarm(alarme);
+    }
+}
+
+bool botoes_pressionado(uint8_t botao) {
+    return botao < gestos.total && gestos.botoes[botao].pressionado;
+}
+
+void botoes_metricas(botoes_metricas_t *m) {
+    uint32_t estado = save_and_disable_interrupts();
+    *m = metricas;
+    restore_interrupts(estado);
+}
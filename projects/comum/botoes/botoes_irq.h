@@ -0,0 +1,53 @@
+// Botões por interrupção de borda, com fila de bordas marcadas no tempo
+// A interrupção do GPIO (as duas bordas) grava o instante (time_us_64) e o
+// nível num anel de produtor único (a interrupção) e consumidor único (o
+// laço principal), sem trava; o laço entrega as bordas a botoes_gestos.c,
+// que resolve o debounce pelos instantes e gera os gestos
+// Nada de gpio_get() no laço: uma pressão é vista mesmo com o laço preso num
+// envio I2C, e o laço pode dormir (__wfi) até a próxima borda ou prazo
+// A latência de cada gesto (instante do gesto -> botoes_ler) é medida
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#ifndef BOTOES_IRQ_H
+#define BOTOES_IRQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/types.h"
+#include "botoes_gestos.h"
+
+// Bordas guardadas entre duas chamadas de botoes_ler (potência de 2)
+#define BOTOES_ANEL_BORDAS      64
+
+// Gestos prontos esperando botoes_ler
+#define BOTOES_FILA_GESTOS      16
+
+typedef struct {
+    uint32_t bordas;            // Bordas recebidas pela interrupção
+    uint32_t bordas_perdidas;   // Anel cheio
+    uint32_t gestos;            // Gestos entregues por botoes_ler
+    uint32_t gestos_perdidos;   // Fila de gestos cheia
+    uint32_t latencia_max_us;   // Instante do gesto -> entrega
+    uint64_t latencia_soma_us;
+} botoes_metricas_t;
+
+// Configura os pinos (entrada com pull-up, pressionado = nível baixo) e a
+// interrupção das duas bordas no núcleo que chamar
+// 'mascara_acorde': bit n = pinos[n] participa do acorde (0: sem acorde)
+void botoes_iniciar(const uint *pinos, uint8_t total, uint8_t mascara_acorde);
+
+// Entrega as bordas pendentes, vence os prazos e retorna o próximo gesto
+bool botoes_ler(botao_evento_t *evento);
+
+// Dorme (__wfi) até chegar uma borda, vencer um prazo de gesto ou chegar
+// 'limite_us' (instante absoluto; BOTOES_SEM_PRAZO: sem limite)
+// Qualquer outra interrupção também acorda: chamar botoes_ler em seguida
+void botoes_esperar(uint64_t limite_us);
+
+// Estado após o debounce
+bool botoes_pressionado(uint8_t botao);
+
+// Cópia das métricas acumuladas
+void botoes_metricas(botoes_metricas_t *metricas);
+
+#endif // BOTOES_IRQ_H
@@ -0,0 +1,345 @@
+// Formatação só com inteiros (ver formato.h)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include "formato.h"
+
+#include <stdarg.h>
+
+// Maior texto de um número: 20 dígitos (%llu) ou sinal, 10 dígitos, ponto
+// e 9 casas
+#define MAX_NUMERO      21
+
+static const uint32_t potencias_10[] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+void formato_iniciar(formato_t *f, char *buffer, size_t tamanho) {
+    f->inicio = buffer;
+    f->p = buffer;
+    f->fim = buffer + tamanho - 1;
+    f->cortado = false;
+    *buffer = '\0';
+}
+
+void formato_caractere(formato_t *f, char c) {
+    if (f->p == f->fim) {
+        f->cortado = true;
+        return;
+    }
+    *f->p++ = c;
+    *f->p = '\0';
+}
+
+void formato_texto(formato_t *f, const char *texto) {
+    char *p = f->p;
+
+    while (*texto) {
+        if (p == f->fim) {
+            f->cortado = true;
+            break;
+        }
+        *p++ = *texto++;
+    }
+    *p = '\0';
+    f->p = p;
+}
+
+static void repetir(formato_t *f, char c, int n) {
+    while (n-- > 0) {
+        formato_caractere(f, c);
+    }
+}
+
+// Dígitos decimais de 'v' do fim para o começo; retorna o primeiro
+static char *digitos_decimais(char *fim, uint32_t v) {
+    do {
+        *--fim = (char)('0' + v % 10u);
+        v /= 10u;
+    } while (v != 0);
+    return fim;
+}
+
+// O mesmo para 64 bits (%lld): blocos de 9 dígitos até caber em 32 bits,
+// então só os valores grandes pagam a divisão de 64 bits
+static char *digitos_decimais_64(char *fim, uint64_t v) {
+    while (v > UINT32_MAX) {
+        uint32_t bloco = (uint32_t)(v % 1000000000u);
+        v /= 1000000000u;
+        for (int i = 0; i < 9; i++) {
+            *--fim = (char)('0' + bloco % 10u);
+            bloco /= 10u;
+        }
+    }
+    return digitos_decimais(fim, (uint32_t)v);
+}
+
+// Escreve sinal + dígitos com largura mínima: com '0' os zeros vão entre o
+// sinal e os dígitos, com ' ' os espaços vão antes do sinal
+static void alinhar(formato_t *f, bool negativo, const char *digitos, int n, uint8_t largura,
+                    char preenchimento, bool esquerda) {
+    int falta = (int)largura - n - (negativo ? 1 : 0);
+
+    if (!esquerda && preenchimento != '0') {
+        repetir(f, ' ', falta);
+    }
+    if (negativo) {
+        formato_caractere(f, '-');
+    }
+    if (!esquerda && preenchimento == '0') {
+        repetir(f, '0', falta);
+    }
+    for (int i = 0; i < n; i++) {
+        formato_caractere(f, digitos[i]);
+    }
+    if (esquerda) {
+        repetir(f, ' ', falta);
+    }
+}
+
+static void escrever_natural(formato_t *f, uint32_t valor, bool negativo, uint8_t largura,
+                             char preenchimento, bool esquerda) {
+    char texto[MAX_NUMERO];
+    char *fim = texto + sizeof(texto);
+    char *d = digitos_decimais(fim, valor);
+
+    alinhar(f, negativo, d, (int)(fim - d), largura, preenchimento, esquerda);
+}
+
+static void escrever_natural_64(formato_t *f, uint64_t valor, bool negativo, uint8_t largura,
+                                char preenchimento, bool esquerda) {
+    char texto[MAX_NUMERO];
+    char *fim = texto + sizeof(texto);
+    char *d = digitos_decimais_64(fim, valor);
+
+    alinhar(f, negativo, d, (int)(fim - d), largura, preenchimento, esquerda);
+}
+
+void formato_natural(formato_t *f, uint32_t valor, uint8_t largura, char preenchimento) {
+    escrever_natural(f, valor, false, largura, preenchimento, false);
+}
+
+void formato_inteiro(formato_t *f, int32_t valor, uint8_t largura, char preenchimento) {
+    // Módulo em uint32_t: INT32_MIN não cabe em int32_t positivo
+    uint32_t modulo = valor < 0 ? 0u - (uint32_t)valor : (uint32_t)valor;
+
+    escrever_natural(f, modulo, valor < 0, largura, preenchimento, false);
+}
+
+static void escrever_hex(formato_t *f, uint64_t valor, uint8_t digitos, bool minusculo) {
+    const char *simbolos = minusculo ? "0123456789abcdef" : "0123456789ABCDEF";
+
+    for (int i = (int)digitos - 1; i >= 0; i--) {
+        formato_caractere(f, simbolos[(i < 16 ? valor >> (4 * i) : 0u) & 0xFu]);
+    }
+}
+
+void formato_hex(formato_t *f, uint32_t valor, uint8_t digitos) {
+    escrever_hex(f, valor, digitos, false);
+}
+
+void formato_decimal(formato_t *f, int32_t valor, uint8_t casas, uint8_t largura) {
+    char texto[MAX_NUMERO];
+    char *fim = texto + sizeof(texto);
+    uint32_t modulo = valor < 0 ? 0u - (uint32_t)valor : (uint32_t)valor;
+
+    if (casas > 9) {
+        casas = 9;
+    }
+    char *d = fim;
+    if (casas > 0) {
+        uint32_t fracao = modulo % potencias_10[casas];
+        for (uint8_t i = 0; i < casas; i++) {
+            *--d = (char)('0' + fracao % 10u);
+            fracao /= 10u;
+        }
+        *--d = '.';
+    }
+    d = digitos_decimais(d, modulo / potencias_10[casas]);
+    alinhar(f, valor < 0, d, (int)(fim - d), largura, ' ', false);
+}
+
+// Tamanho do argumento pelo modificador: 'H' = hh, 'q' = ll; os demais são
+// a própria letra (h l j z t L) ou '\0' sem modificador
+static long long ler_inteiro(va_list *args, char tamanho) {
+    switch (tamanho) {
+        case 'H': return (signed char)va_arg(*args, int);
+        case 'h': return (short)va_arg(*args, int);
+        case 'l': return va_arg(*args, long);
+        case 'q': return va_arg(*args, long long);
+        case 'j': return va_arg(*args, intmax_t);
+        case 'z': return (ptrdiff_t)va_arg(*args, size_t);      // %zd: size_t com sinal
+        case 't': return va_arg(*args, ptrdiff_t);
+        default:  return va_arg(*args, int);
+    }
+}
+
+static unsigned long long ler_natural(va_list *args, char tamanho) {
+    switch (tamanho) {
+        case 'H': return (unsigned char)va_arg(*args, unsigned int);
+        case 'h': return (unsigned short)va_arg(*args, unsigned int);
+        case 'l': return va_arg(*args, unsigned long);
+        case 'q': return va_arg(*args, unsigned long long);
+        case 'j': return va_arg(*args, uintmax_t);
+        case 'z': return va_arg(*args, size_t);
+        case 't': return (size_t)va_arg(*args, ptrdiff_t);
+        default:  return va_arg(*args, unsigned int);
+    }
+}
+
+int formato_snprintf(char *buffer, size_t tamanho, const char *formato, ...) {
+    formato_t f;
+    va_list args;
+
+    formato_iniciar(&f, buffer, tamanho);
+    va_start(args, formato);
+    for (const char *c = formato; *c; c++) {
+        if (*c != '%') {
+            formato_caractere(&f, *c);
+            continue;
+        }
+
+        bool esquerda = false;
+        char preenchimento = ' ';
+        char modificador = '\0';
+        int largura = 0;
+        int precisao = -1;              // Só usada no %s
+
+        c++;
+        // '+', ' ' e '#' são aceitos e ignorados
+        for (; *c == '-' || *c == '0' || *c == '+' || *c == ' ' || *c == '#'; c++) {
+            if (*c == '-') {
+                esquerda = true;
+            } else if (*c == '0') {
+                preenchimento = '0';
+            }
+        }
+        if (*c == '*') {
+            largura = va_arg(args, int);
+            if (largura < 0) {          // Largura negativa vale como '-'
+                esquerda = true;
+                largura = -largura;
+            }
+            c++;
+        }
+        for (; *c >= '0' && *c <= '9'; c++) {
+            largura = largura * 10 + (*c - '0');
+        }
+        if (largura > UINT8_MAX) {
+            largura = UINT8_MAX;
+        }
+        if (*c == '.') {
+            precisao = 0;
+            if (*++c == '*') {
+                precisao = va_arg(args, int);
+                c++;
+            }
+            for (; *c >= '0' && *c <= '9'; c++) {
+                precisao = precisao * 10 + (*c - '0');
+            }
+        }
+        if (*c == 'h' || *c == 'l') {
+            modificador = *c++;
+            if (*c == modificador) {
+                modificador = modificador == 'h' ? 'H' : 'q';
+                c++;
+            }
+        } else if (*c == 'j' || *c == 'z' || *c == 't' || *c == 'L') {
+            modificador = *c++;
+        }
+
+        switch (*c) {
+            case 'd':
+            case 'i': {
+                long long v = ler_inteiro(&args, modificador);
+                uint64_t modulo = v < 0 ? 0u - (uint64_t)v : (uint64_t)v;
+                escrever_natural_64(&f, modulo, v < 0, (uint8_t)largura, preenchimento, esquerda);
+                break;
+            }
+            case 'u':
+                escrever_natural_64(&f, ler_natural(&args, modificador), false, (uint8_t)largura,
+                                    preenchimento, esquerda);
+                break;
+            case 'x':
+            case 'X': {
+                unsigned long long v = ler_natural(&args, modificador);
+                int n = 1;
+                while (n < 16 && (v >> (4 * n)) != 0) {
+                    n++;
+                }
+                if (!esquerda) {
+                    repetir(&f, preenchimento, largura - n);
+                }
+                escrever_hex(&f, v, (uint8_t)n, *c == 'x');
+                if (esquerda) {
+                    repetir(&f, ' ', largura - n);
+                }
+                break;
+            }
+            case 'o':
+                (void)ler_natural(&args, modificador);  // Só consome
+                formato_caractere(&f, '?');
+                break;
+            case 'c':
+                formato_caractere(&f, (char)va_arg(args, int));
+                break;
+            case 's': {
+                const char *s = va_arg(args, const char *);
+                if (modificador == 'l') {
+                    formato_caractere(&f, '?');         // wchar_t *: só consome
+                    break;
+                }
+                if (s == NULL) {
+                    s = "(null)";
+                }
+                int n = 0;
+                while (s[n] && (precisao < 0 || n < precisao)) {
+                    n++;
+                }
+                if (!esquerda) {
+                    repetir(&f, ' ', largura - n);
+                }
+                for (int i = 0; i < n; i++) {
+                    formato_caractere(&f, s[i]);
+                }
+                if (esquerda) {
+                    repetir(&f, ' ', largura - n);
+                }
+                break;
+            }
+            case '%':
+                formato_caractere(&f, '%');
+                break;
+            case '\0':
+                c--;                    // '%' no fim da string
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                // Só consome: ponto fixo vai por formato_decimal
+                if (modificador == 'L') {
+                    (void)va_arg(args, long double);
+                } else {
+                    (void)va_arg(args, double);
+                }
+                formato_caractere(&f, '?');
+                break;
+            case 'p':
+                (void)va_arg(args, void *);
+                formato_caractere(&f, '?');
+                break;
+            case 'n':
+                (void)va_arg(args, void *);     // Consome sem gravar a contagem
+                break;
+            default:
+                formato_caractere(&f, '?');     // Fora do C99: o -Wformat já avisa
+                break;
+        }
+    }
+    va_end(args);
+    return (int)formato_tamanho(&f);
+}
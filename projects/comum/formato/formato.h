@@ -0,0 +1,65 @@
+// Formatação de texto só com inteiros, para telas e linhas de log
+// Substitui sprintf/snprintf/printf nos caminhos quentes: sem float por
+// software, sem locale, sem heap e com pouca pilha; escreve direto no buffer
+// do chamador, sempre terminado em '\0', cortando o que não couber
+// Duas formas:
+// - construtor tipado (formato_t + formato_texto/inteiro/decimal/hex): cada
+//   campo tem a sua função, então o tipo de cada argumento é conferido pelo
+//   compilador e não há string de formato para interpretar
+// - formato_snprintf: subconjunto do printf (%d %i %u %x %X %c %s %%, com
+//   '-', '0', largura e precisão com '*' e os modificadores hh h l ll j z t),
+//   marcado com o atributo format
+//   do GCC para que o -Wformat confira a string contra os argumentos na
+//   compilação; números com casas decimais vão como inteiro escalado pelo
+//   construtor (formato_decimal), nunca %f
+// Sem dependência de hardware: testado no host (host/formato_teste.c)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#ifndef FORMATO_H
+#define FORMATO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    char *inicio;
+    char *p;                    // Próxima posição livre (sempre com '\0')
+    char *fim;                  // Última posição, reservada para o '\0'
+    bool cortado;               // Algo não coube
+} formato_t;
+
+// Prepara o construtor sobre 'buffer' ('tamanho' >= 1) e o deixa vazio
+void formato_iniciar(formato_t *f, char *buffer, size_t tamanho);
+
+// Caracteres escritos até agora (sem o '\0')
+static inline size_t formato_tamanho(const formato_t *f) {
+    return (size_t)(f->p - f->inicio);
+}
+
+void formato_texto(formato_t *f, const char *texto);
+void formato_caractere(formato_t *f, char c);
+
+// Inteiro em decimal com largura mínima; 'preenchimento' ' ' alinha à
+// direita e '0' completa com zeros depois do sinal (como %5d e %05d)
+void formato_inteiro(formato_t *f, int32_t valor, uint8_t largura, char preenchimento);
+void formato_natural(formato_t *f, uint32_t valor, uint8_t largura, char preenchimento);
+
+// Hexadecimal maiúsculo com exatamente 'digitos' dígitos (como %02X para 2)
+void formato_hex(formato_t *f, uint32_t valor, uint8_t digitos);
+
+// Ponto fixo: 'valor' escalado por 10^casas (centésimos com casas = 2),
+// com largura mínima alinhada à direita: (-105, 2, 0) -> "-1.05"
+void formato_decimal(formato_t *f, int32_t valor, uint8_t casas, uint8_t largura);
+
+// Subconjunto do snprintf descrito acima; retorna os caracteres escritos
+// (depois do corte, diferente do snprintf). As outras conversões do C99
+// (%f %e %g %a %o %p) consomem o argumento e escrevem '?'; %n consome o
+// ponteiro sem gravar nada e %s com NULL escreve "(null)". A precisão só
+// vale no %s (%.2d a ignora) e os sinalizadores '+', ' ' e '#' são ignorados
+// O -Wformat confere os argumentos como no printf: aceita %f ou %p aqui, e
+// o '?' só aparece na execução, sem desalinhar os argumentos seguintes
+int formato_snprintf(char *buffer, size_t tamanho, const char *formato, ...)
+    __attribute__((format(printf, 3, 4)));
+
+#endif // FORMATO_H
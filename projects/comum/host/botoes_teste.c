@@ -0,0 +1,136 @@
+// Verificação do debounce e dos gestos dos botões no host
+// Cada cenário é uma lista de bordas marcadas no tempo (como as gravadas pela
+// interrupção, com ressalto); o tempo avança em passos de 1 ms, entregando as
+// bordas vencidas e depois os prazos, e a sequência de gestos é conferida
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include <stdio.h>
+#include "botoes_gestos.h"
+
+#define PASSO_US        1000
+#define MAX_BORDAS      16
+#define MAX_GESTOS      12
+
+static const char *nomes[] = {"pressionado", "solto", "longo", "duplo", "acorde"};
+
+typedef struct {
+    uint8_t botao;
+    bool pressionado;
+    uint64_t instante_us;
+} borda_t;
+
+typedef struct {
+    botao_gesto_t gesto;
+    uint8_t botao;
+    uint64_t instante_us;
+} esperado_t;
+
+typedef struct {
+    const char *nome;
+    uint8_t mascara_acorde;
+    uint8_t pressionados;       // Nível na partida
+    borda_t bordas[MAX_BORDAS];
+    int total_bordas;
+    esperado_t esperados[MAX_GESTOS];
+    int total_esperados;
+    uint64_t duracao_us;
+} cenario_t;
+
+#define P(b, t) { b, true, t }
+#define S(b, t) { b, false, t }
+
+static const cenario_t cenarios[] = {
+    { "ressalto", 0, 0,
+      { P(0, 1000), S(0, 1200), P(0, 1500), S(0, 2500), P(0, 3000),
+        S(0, 200000), P(0, 200300), S(0, 200800) }, 8,
+      { {BOTAO_PRESSIONADO, 0, 1000}, {BOTAO_SOLTO, 0, 200000} }, 2, 400000 },
+    { "pulso curto", 0, 0,
+      { P(0, 1000), S(0, 1500) }, 2,
+      { {BOTAO_PRESSIONADO, 0, 1000}, {BOTAO_SOLTO, 0, 1500} }, 2, 100000 },
+    { "longo", 0, 0,
+      { P(1, 1000), S(1, 1000000) }, 2,
+      { {BOTAO_PRESSIONADO, 1, 1000}, {BOTAO_LONGO, 1, 801000}, {BOTAO_SOLTO, 1, 1000000} }, 3, 1200000 },
+    { "duplo e triplo", 0, 0,
+      { P(0, 1000), S(0, 100000), P(0, 250000), S(0, 350000), P(0, 500000), S(0, 600000) }, 6,
+      { {BOTAO_PRESSIONADO, 0, 1000}, {BOTAO_SOLTO, 0, 100000},
+        {BOTAO_PRESSIONADO, 0, 250000}, {BOTAO_DUPLO, 0, 250000}, {BOTAO_SOLTO, 0, 350000},
+        {BOTAO_PRESSIONADO, 0, 500000}, {BOTAO_SOLTO, 0, 600000} }, 7, 1000000 },
+    { "acorde A+B", 0x3, 0,
+      { P(0, 1000), S(0, 1300), P(0, 1600), P(1, 21000), S(0, 500000), S(1, 510000) }, 6,
+      { {BOTAO_ACORDE, 1, 21000}, {BOTAO_SOLTO, 0, 500000}, {BOTAO_SOLTO, 1, 510000} }, 3, 1200000 },
+    { "acorde incompleto", 0x3, 0,
+      { P(0, 1000), S(0, 200000), P(1, 400000), S(1, 500000) }, 4,
+      { {BOTAO_PRESSIONADO, 0, 1000}, {BOTAO_SOLTO, 0, 200000},
+        {BOTAO_PRESSIONADO, 1, 400000}, {BOTAO_SOLTO, 1, 500000} }, 4, 700000 },
+    { "parceiro atrasado", 0x3, 0,
+      { P(0, 1000), P(1, 80000), S(1, 150000), S(0, 160000) }, 4,
+      { {BOTAO_PRESSIONADO, 0, 1000}, {BOTAO_PRESSIONADO, 1, 80000},
+        {BOTAO_SOLTO, 1, 150000}, {BOTAO_SOLTO, 0, 160000} }, 4, 300000 },
+    { "preso na partida", 0, 0x1,
+      { S(0, 100000), P(0, 300000), S(0, 400000) }, 3,
+      { {BOTAO_SOLTO, 0, 100000}, {BOTAO_PRESSIONADO, 0, 300000}, {BOTAO_SOLTO, 0, 400000} }, 3, 1500000 },
+};
+
+typedef struct {
+    botao_evento_t gestos[MAX_GESTOS];
+    uint64_t emitido_us[MAX_GESTOS];    // Instante simulado em que saiu
+    int total;
+    uint64_t agora_us;
+} registro_t;
+
+static void registrar(const botao_evento_t *evento, void *contexto) {
+    registro_t *r = contexto;
+    if (r->total < MAX_GESTOS) {
+        r->gestos[r->total] = *evento;
+        r->emitido_us[r->total] = r->agora_us;
+    }
+    r->total++;
+}
+
+static int executar(const cenario_t *c) {
+    botoes_gestos_t g;
+    registro_t r = {0};
+    int proxima = 0;
+    uint64_t atraso_max_us = 0;
+
+    botoes_gestos_iniciar(&g, 2, c->mascara_acorde, c->pressionados, registrar, &r);
+    for (uint64_t t = 0; t <= c->duracao_us; t += PASSO_US) {
+        r.agora_us = t;
+        while (proxima < c->total_bordas && c->bordas[proxima].instante_us <= t) {
+            const borda_t *b = &c->bordas[proxima++];
+            botoes_gestos_borda(&g, b->botao, b->pressionado, b->instante_us);
+        }
+        botoes_gestos_tempo(&g, t);
+    }
+
+    int falhou = r.total != c->total_esperados;
+    for (int i = 0; i < r.total && i < MAX_GESTOS; i++) {
+        if (!falhou) {
+            const esperado_t *e = &c->esperados[i];
+            falhou = r.gestos[i].gesto != e->gesto || r.gestos[i].botao != e->botao ||
+                     r.gestos[i].instante_us != e->instante_us;
+        }
+        // Atraso da detecção além da resolução do passo
+        uint64_t atraso = r.emitido_us[i] - r.gestos[i].instante_us;
+        if (atraso > atraso_max_us) {
+            atraso_max_us = atraso;
+        }
+    }
+
+    printf("%-18s %2d gestos | atraso de deteccao max %5lu us | %s\n", c->nome, r.total,
+           (unsigned long)atraso_max_us, falhou ? "FALHOU" : "ok");
+    for (int i = 0; falhou && i < r.total && i < MAX_GESTOS; i++) {
+        printf("    %8lu us botao %u %s\n", (unsigned long)r.gestos[i].instante_us,
+               r.gestos[i].botao, nomes[r.gestos[i].gesto]);
+    }
+    return falhou;
+}
+
+int main(void) {
+    int falhas = 0;
+
+    for (unsigned i = 0; i < sizeof(cenarios) / sizeof(cenarios[0]); i++) {
+        falhas += executar(&cenarios[i]);
+    }
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,235 @@
+// Benchmark da formatação só com inteiros contra o snprintf da biblioteca C
+// Usa as strings de formato reais dos projetos: cada caso formata a mesma
+// linha pelo snprintf original (com %.1f onde o projeto usa float), pelo
+// construtor tipado e pelo formato_snprintf, e mede tempo e pilha
+// - Pico: ciclos pelo SysTick; pilha pintando 4 KB abaixo do SP com as
+//   interrupções desligadas e procurando a marca mais funda. O snprintf é o
+//   que o SDK liga: pico_printf por padrão (formato_bench) ou o da newlib
+//   (formato_bench_newlib, pico_set_printf_implementation compiler)
+// - host (FORMATO_HOST, glibc): ns por chamada; pilha numa thread com pilha
+//   própria pintada. Só referência: glibc não é newlib e o x86 tem FPU
+// Em ambos, a pilha de uma chamada vazia é descontada
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "formato.h"
+
+#define MARCA           0xA5u
+
+static char linha[64];
+static volatile int32_t entrada = 253;      // Evita que o compilador resolva tudo antes
+
+#ifdef FORMATO_HOST
+#include <pthread.h>
+#include <time.h>
+
+#define REPETICOES      200000u
+#define UNIDADE         "ns"
+#define PILHA_THREAD    (64u * 1024u)
+
+static uint64_t agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t decorrido(uint64_t inicio, uint64_t fim) {
+    return fim - inicio;
+}
+
+static void *executar(void *caso) {
+    ((void (*)(void))caso)();
+    return NULL;
+}
+
+static uint32_t medir_pilha(void (*caso)(void)) {
+    static uint8_t pilha[PILHA_THREAD] __attribute__((aligned(16)));
+    pthread_attr_t atributos;
+    pthread_t thread;
+
+    memset(pilha, MARCA, sizeof(pilha));
+    pthread_attr_init(&atributos);
+    pthread_attr_setstack(&atributos, pilha, sizeof(pilha));
+    pthread_create(&thread, &atributos, executar, (void *)caso);
+    pthread_join(thread, NULL);
+    pthread_attr_destroy(&atributos);
+
+    uint32_t livre = 0;
+    while (livre < sizeof(pilha) && pilha[livre] == MARCA) {
+        livre++;
+    }
+    return (uint32_t)sizeof(pilha) - livre;
+}
+#else
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+#include "hardware/sync.h"
+
+#define REPETICOES      1000u           // Cabe nos 24 bits do SysTick
+#define UNIDADE         "ciclos"
+
+// Fundo da pilha do núcleo 0 no memmap do SDK (o __StackLimit de lá é o fim
+// do heap, não da pilha); o tamanho vem de PICO_STACK_SIZE
+extern uint8_t __StackBottom[];
+
+static uint64_t agora(void) {
+    return systick_hw->cvr;             // Conta para baixo
+}
+
+static uint64_t decorrido(uint64_t inicio, uint64_t fim) {
+    return (inicio - fim) & 0x00FFFFFFu;
+}
+
+// Pinta a pilha livre abaixo do SP, chama o caso e procura a marca mais
+// funda alcançada; noinline para que o quadro desta função fique fora da
+// medida. A pintura para no fundo da pilha para não invadir a SCRATCH_Y
+static uint32_t __attribute__((noinline)) medir_pilha(void (*caso)(void)) {
+    uint8_t *sp;
+    __asm volatile ("mov %0, sp" : "=r"(sp));
+    uint8_t *fundo = __StackBottom;
+
+    uint32_t estado = save_and_disable_interrupts();
+    for (uint8_t *p = fundo; p < sp - 16; p++) {
+        *p = MARCA;
+    }
+    caso();
+    restore_interrupts(estado);
+
+    uint8_t *p = fundo;
+    while (p < sp && *p == MARCA) {
+        p++;
+    }
+    return (uint32_t)(sp - p);
+}
+#endif
+
+// Casos: linhas reais dos projetos
+static void vazio(void) {
+    linha[0] = '\0';
+}
+
+// sintetizador update_display(): "AUDIO: %.1fS"
+static void audio_newlib(void) {
+    snprintf(linha, sizeof(linha), "AUDIO: %.1fS", entrada / 10.0f);
+}
+
+static void audio_formato(void) {
+    formato_t f;
+    formato_iniciar(&f, linha, sizeof(linha));
+    formato_texto(&f, "AUDIO: ");
+    formato_decimal(&f, entrada, 1, 0);
+    formato_caractere(&f, 'S');
+}
+
+// tarefa-iot-security display_show_system_status(): "TEMP: %.1f C"
+static void temp_newlib(void) {
+    snprintf(linha, sizeof(linha), "TEMP: %.1f C", entrada / 10.0f);
+}
+
+static void temp_formato(void) {
+    formato_t f;
+    formato_iniciar(&f, linha, sizeof(linha));
+    formato_texto(&f, "TEMP: ");
+    formato_decimal(&f, entrada, 1, 0);
+    formato_texto(&f, " C");
+}
+
+// sintetizador, tempo de gravação: "%02d:%02d"
+static void relogio_newlib(void) {
+    snprintf(linha, sizeof(linha), "%02d:%02d", (int)(entrada / 60), (int)(entrada % 60));
+}
+
+static void relogio_snprintf(void) {
+    formato_snprintf(linha, sizeof(linha), "%02d:%02d", (int)(entrada / 60), (int)(entrada % 60));
+}
+
+// tarefa_acelerometro / motor: "X:%5d" na tela
+static void eixo_newlib(void) {
+    snprintf(linha, sizeof(linha), "X:%5d", (int)-entrada);
+}
+
+static void eixo_formato(void) {
+    formato_t f;
+    formato_iniciar(&f, linha, sizeof(linha));
+    formato_texto(&f, "X:");
+    formato_inteiro(&f, -entrada, 5, ' ');
+}
+
+// tarefa_acelerometro / motor: linha da serial com três eixos
+static void imu_newlib(void) {
+    snprintf(linha, sizeof(linha), "  X = %7d  Y = %7d  Z = %7d\n",
+             (int)entrada, (int)-entrada * 40, (int)entrada * 64);
+}
+
+static void imu_snprintf(void) {
+    formato_snprintf(linha, sizeof(linha), "  X = %7d  Y = %7d  Z = %7d\n",
+                     (int)entrada, (int)-entrada * 40, (int)entrada * 64);
+}
+
+// tarefa-iot-security: byte cifrado em hexadecimal, "%02X"
+static void hex_newlib(void) {
+    snprintf(linha, sizeof(linha), "%02X", (unsigned)(entrada & 0xFF));
+}
+
+static void hex_formato(void) {
+    formato_t f;
+    formato_iniciar(&f, linha, sizeof(linha));
+    formato_hex(&f, (uint32_t)(entrada & 0xFF), 2);
+}
+
+typedef struct {
+    const char *nome;
+    void (*caso)(void);
+} caso_t;
+
+static const caso_t casos[] = {
+    { "\"AUDIO: %.1fS\"  snprintf",        audio_newlib },
+    { "                formato_decimal",   audio_formato },
+    { "\"TEMP: %.1f C\"  snprintf",        temp_newlib },
+    { "                formato_decimal",   temp_formato },
+    { "\"%02d:%02d\"       snprintf",      relogio_newlib },
+    { "                formato_snprintf",  relogio_snprintf },
+    { "\"X:%5d\"         snprintf",        eixo_newlib },
+    { "                formato_inteiro",   eixo_formato },
+    { "\"X = %7d\" x3    snprintf",        imu_newlib },
+    { "                formato_snprintf",  imu_snprintf },
+    { "\"%02X\"          snprintf",        hex_newlib },
+    { "                formato_hex",       hex_formato },
+};
+
+int main(void) {
+#ifndef FORMATO_HOST
+    stdio_init_all();
+    sleep_ms(2000);
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->csr = 0x5;              // Liga, clock do processador, sem interrupção
+#endif
+    uint32_t base = medir_pilha(vazio);
+
+    printf("%-34s %10s %8s  %s\n", "caso", UNIDADE, "pilha B", "saida");
+    for (unsigned i = 0; i < sizeof(casos) / sizeof(casos[0]); i++) {
+        uint64_t inicio = agora();
+        for (uint32_t r = 0; r < REPETICOES; r++) {
+            casos[i].caso();
+        }
+        double por_chamada = (double)decorrido(inicio, agora()) / REPETICOES;
+        uint32_t pilha = medir_pilha(casos[i].caso);
+
+        // A saída sem o '\n' final da linha do IMU
+        size_t n = strlen(linha);
+        if (n > 0 && linha[n - 1] == '\n') {
+            linha[n - 1] = '\0';
+        }
+        printf("%-34s %10.1f %8lu  \"%s\"\n", casos[i].nome, por_chamada,
+               (unsigned long)(pilha > base ? pilha - base : 0), linha);
+    }
+
+#ifndef FORMATO_HOST
+    while (true) {
+        sleep_ms(1000);
+    }
+#endif
+    return 0;
+}
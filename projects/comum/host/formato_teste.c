@@ -0,0 +1,165 @@
+// Verificação da formatação só com inteiros no host
+// Compara formato_snprintf e o construtor com o snprintf da biblioteca C
+// nas strings de formato usadas pelos projetos e em valores de borda, e o
+// ponto fixo com o %.Nf aplicado ao mesmo valor
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "formato.h"
+
+static const long valores[] = {
+    0, 1, -1, 7, -7, 9, 10, -10, 99, 100, 12345, -12345, 99999, 100000, -100000,
+    32767, -32768, 65535, 2147483647L, -2147483647L - 1
+};
+#define TOTAL_VALORES   (sizeof(valores) / sizeof(valores[0]))
+
+static const long long valores_64[] = {
+    0, -1, 4294967295LL, 4294967296LL, -4294967296LL, 999999999999LL, 1000000000000000000LL,
+    9223372036854775807LL, -9223372036854775807LL - 1
+};
+#define TOTAL_VALORES_64 (sizeof(valores_64) / sizeof(valores_64[0]))
+
+static int falhas;
+
+static void comparar(const char *caso, const char *esperado, const char *obtido) {
+    if (strcmp(esperado, obtido) != 0) {
+        printf("    %s: esperado \"%s\", obtido \"%s\"\n", caso, esperado, obtido);
+        falhas++;
+    }
+}
+
+// Mesma string de formato nos dois; o -Wformat confere as duas chamadas
+#define CONFERIR(tamanho, fmt, ...) do {                                    \
+        char esperado[tamanho], obtido[tamanho];                            \
+        snprintf(esperado, sizeof(esperado), fmt, __VA_ARGS__);             \
+        int n = formato_snprintf(obtido, sizeof(obtido), fmt, __VA_ARGS__); \
+        comparar(fmt, esperado, obtido);                                    \
+        if (n != (int)strlen(obtido)) {                                     \
+            printf("    %s: retorno %d\n", fmt, n);                         \
+            falhas++;                                                       \
+        }                                                                   \
+    } while (0)
+
+static int inteiros(void) {
+    int antes = falhas;
+
+    for (unsigned i = 0; i < TOTAL_VALORES; i++) {
+        int v = (int)valores[i];
+        long l = valores[i];
+        unsigned u = (unsigned)v;
+
+        CONFERIR(32, "X:%5d", v);
+        CONFERIR(64, "  X = %7d  Y = %7d  Z = %7d\n", v, -v / 2, v / 3);
+        CONFERIR(32, "%02d:%02d", (int)(u % 60u), v);
+        CONFERIR(32, "TS: %lu", (unsigned long)(uint32_t)l);
+        CONFERIR(32, "%ld|%-6ld|%06ld", l, l, l);
+        CONFERIR(32, "%u|%08u|%-8u|", u, u, u);
+        CONFERIR(32, "%02X|%x|%8X|%-4x|", u & 0xFFu, u, u, u & 0xFFu);
+        CONFERIR(32, "%c%s%-5s|%5s%%", 'A', "ok", "ab", "cd");
+        CONFERIR(32, "%hd|%hu|%hhd|%05hhu|%hx", v, u, v, u, u);
+    }
+    // 'll' em 64 bits, não truncado para long
+    for (unsigned i = 0; i < TOTAL_VALORES_64; i++) {
+        long long v = valores_64[i];
+        unsigned long long u = (unsigned long long)v;
+
+        CONFERIR(96, "%lld|%-21lld|%022lld|%llu", v, v, v, u);
+        CONFERIR(64, "%llx|%018llX|%-17llx|", u, u, u);
+    }
+    // Corte: o buffer pequeno termina em '\0' e guarda o começo
+    CONFERIR(8, "Motores: A[%s:%d%%]", "FRENTE", 75);
+    return falhas - antes;
+}
+
+// Modificadores j z t, largura e precisão com '*' e conversões fora do
+// subconjunto: cada uma consome o seu argumento, então o %d seguinte sai certo
+static int argumentos(void) {
+    int antes = falhas;
+    char obtido[48];
+    int contagem = -1;
+    const char *volatile nulo = NULL;  // volatile: o GCC não vê o NULL na chamada
+
+    CONFERIR(48, "%zu %d|%zd %d", sizeof(valores), 7, (ptrdiff_t)-3, 8);
+    CONFERIR(48, "%jd|%ju|%td %d", (intmax_t)-9000000000LL, (uintmax_t)42u, (ptrdiff_t)-5, 9);
+    CONFERIR(48, "%*d|%-*d|%*d|%d", 6, -42, 5, 42, -4, 1, 2);
+    CONFERIR(48, "%.*s|%.3s|%-6.2s|%d", 2, "abcdef", "abcdef", "xyz", 3);
+    CONFERIR(48, "%hhx %zx %d", 0x1FFu, (size_t)0xABCu, 4);
+
+    formato_snprintf(obtido, sizeof(obtido), "%p %d", (void *)obtido, 5);
+    comparar("%p %d", "? 5", obtido);
+    formato_snprintf(obtido, sizeof(obtido), "%f|%Lf|%e %d", 1.5, (long double)2.5, 3.5, 6);
+    comparar("%f|%Lf|%e %d", "?|?|? 6", obtido);
+    formato_snprintf(obtido, sizeof(obtido), "%o %d", 8u, 7);
+    comparar("%o %d", "? 7", obtido);
+    formato_snprintf(obtido, sizeof(obtido), "a%nb%d", &contagem, 1);
+    comparar("%n", "ab1", obtido);
+    formato_snprintf(obtido, sizeof(obtido), "[%s|%4.1s]", nulo, "xy");
+    comparar("%s NULL", "[(null)|   x]", obtido);
+    return falhas - antes;
+}
+
+static int construtor(void) {
+    int antes = falhas;
+    char esperado[32], obtido[32];
+    formato_t f;
+
+    for (unsigned i = 0; i < TOTAL_VALORES; i++) {
+        int32_t v = (int32_t)valores[i];
+
+        formato_iniciar(&f, obtido, sizeof(obtido));
+        formato_texto(&f, "X:");
+        formato_inteiro(&f, v, 5, ' ');
+        snprintf(esperado, sizeof(esperado), "X:%5d", (int)v);
+        comparar("formato_inteiro", esperado, obtido);
+
+        formato_iniciar(&f, obtido, sizeof(obtido));
+        formato_inteiro(&f, v, 6, '0');
+        snprintf(esperado, sizeof(esperado), "%06d", (int)v);
+        comparar("formato_inteiro '0'", esperado, obtido);
+
+        formato_iniciar(&f, obtido, sizeof(obtido));
+        formato_hex(&f, (uint32_t)v, 8);
+        snprintf(esperado, sizeof(esperado), "%08X", (unsigned)v);
+        comparar("formato_hex", esperado, obtido);
+
+        // Ponto fixo contra %.Nf do mesmo valor (exato em double)
+        for (uint8_t casas = 0; casas <= 3; casas++) {
+            double divisor = casas == 0 ? 1.0 : casas == 1 ? 10.0 : casas == 2 ? 100.0 : 1000.0;
+            formato_iniciar(&f, obtido, sizeof(obtido));
+            formato_decimal(&f, v, casas, 9);
+            snprintf(esperado, sizeof(esperado), "%9.*f", casas, v / divisor);
+            comparar("formato_decimal", esperado, obtido);
+        }
+    }
+
+    // -0,5 mantém o sinal; largura menor que o texto não corta
+    formato_iniciar(&f, obtido, sizeof(obtido));
+    formato_decimal(&f, -5, 1, 0);
+    comparar("formato_decimal -0.5", "-0.5", obtido);
+
+    char pequeno[6];
+    formato_iniciar(&f, pequeno, sizeof(pequeno));
+    formato_texto(&f, "TEMP: ");
+    formato_decimal(&f, 253, 1, 0);
+    comparar("corte", "TEMP:", pequeno);
+    if (!f.cortado || formato_tamanho(&f) != 5) {
+        printf("    corte: cortado %d, tamanho %zu\n", f.cortado, formato_tamanho(&f));
+        falhas++;
+    }
+    return falhas - antes;
+}
+
+int main(void) {
+    int r;
+
+    r = inteiros();
+    printf("%-22s %s\n", "formato_snprintf", r ? "FALHOU" : "ok");
+    r = argumentos();
+    printf("%-22s %s\n", "argumentos", r ? "FALHOU" : "ok");
+    r = construtor();
+    printf("%-22s %s\n", "construtor", r ? "FALHOU" : "ok");
+    return falhas ? 1 : 0;
+}
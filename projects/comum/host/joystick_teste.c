@@ -0,0 +1,207 @@
+// Verificação do filtro do joystick no host
+// Traços sintéticos de ADC (ruído, picos, deriva, gestos) amostrados a cada
+// 10 ms, como no laço de controle; cada cenário confere a sequência de
+// eventos e a compara com o classificador anterior (uma amostra bruta a cada
+// 100 ms contra limiares fixos em torno de 2048)
+// Com um arquivo de traço ('tempo_ms x y' por linha) só reproduz e imprime
+// os eventos: ./joystick_teste traco.txt
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "joystick_filtro.h"
+
+#define PERIODO_MS      10
+#define MAX_EVENTOS     16
+
+// Classificador anterior (caldeira_main.c até a calibração automática)
+#define ANTERIOR_PERIODO_MS 100
+#define ANTERIOR_MIN    (1800 - 1000)
+#define ANTERIOR_MAX    (2300 + 1000)
+
+static const char *nomes[] = {"centro", "direita", "esquerda", "baixo", "cima"};
+
+// Ruído uniforme determinístico (LCG), reiniciado a cada cenário
+static uint32_t semente;
+
+static int32_t ruido(int32_t amplitude) {
+    semente = semente * 1103515245u + 12345u;
+    return (int32_t)((semente >> 16) % (uint32_t)(2 * amplitude + 1)) - amplitude;
+}
+
+static uint16_t saturar(int32_t v) {
+    return (uint16_t)(v < 0 ? 0 : v > JOYSTICK_ADC_MAX ? JOYSTICK_ADC_MAX : v);
+}
+
+// Geradores de traço: posição dos dois eixos no instante t
+static void repouso(uint32_t t, int32_t *x, int32_t *y) {
+    (void)t;
+    *x = 1998 + ruido(60);
+    *y = 2018 + ruido(60);
+}
+
+static void picos(uint32_t t, int32_t *x, int32_t *y) {
+    repouso(t, x, y);
+    if (t % 250 == 0 && t > 0) {
+        *x = (t % 500 == 0) ? JOYSTICK_ADC_MAX : 0;     // Uma amostra espúria
+    }
+}
+
+static void gesto_direita(uint32_t t, int32_t *x, int32_t *y) {
+    repouso(t, x, y);
+    if (t >= 1000 && t < 1400) {
+        *x = 4000 + ruido(60);
+    }
+}
+
+static void borda_zona_morta(uint32_t t, int32_t *x, int32_t *y) {
+    repouso(t, x, y);
+    if (t >= 1000 && t < 1300) {
+        *x += 1500;
+    } else if (t >= 1300 && t < 3000) {
+        *x += 900 + (int32_t)((t / 100) % 2) * 400;     // Oscila entre 900 e 1300
+    }
+}
+
+static void deriva(uint32_t t, int32_t *x, int32_t *y) {
+    *x = 2048 + (int32_t)(t * 200u / 60000u) + ruido(40);
+    *y = 2048 - (int32_t)(t * 150u / 60000u) + ruido(40);
+}
+
+static void segurado_no_boot(uint32_t t, int32_t *x, int32_t *y) {
+    repouso(t, x, y);
+    if (t < 1000) {
+        *x = JOYSTICK_ADC_MAX;
+    }
+}
+
+static void diagonal(uint32_t t, int32_t *x, int32_t *y) {
+    repouso(t, x, y);
+    if (t >= 1000 && t < 2000) {
+        int32_t k = (int32_t)(t - 1000);                // Direita -> cima em 1 s
+        *x += 1800 * (1000 - k) / 1000;
+        *y += 1800 * k / 1000;
+    }
+}
+
+typedef struct {
+    const char *nome;
+    void (*gerar)(uint32_t t, int32_t *x, int32_t *y);
+    uint32_t duracao_ms;
+    joystick_dir_t esperados[4];
+    int total_esperados;
+    uint32_t gesto_ms;          // Início do primeiro gesto (latência), 0: sem gesto
+} cenario_t;
+
+static const cenario_t cenarios[] = {
+    { "repouso com ruido", repouso,          5000,  {0},                              0, 0 },
+    { "picos isolados",    picos,            5000,  {0},                              0, 0 },
+    { "gesto direita",     gesto_direita,    3000,  {JOY_RIGHT, JOY_CENTER},          2, 1000 },
+    { "borda zona morta",  borda_zona_morta, 4000,  {JOY_RIGHT, JOY_CENTER},          2, 1000 },
+    { "deriva do centro",  deriva,          60000,  {0},                              0, 0 },
+    { "segurado no boot",  segurado_no_boot, 3000,  {JOY_RIGHT, JOY_CENTER},          2, 0 },
+    { "diagonal",          diagonal,         3000,  {JOY_RIGHT, JOY_UP, JOY_CENTER},  3, 1000 },
+};
+
+typedef struct {
+    joystick_dir_t direcoes[MAX_EVENTOS];
+    uint32_t instantes[MAX_EVENTOS];
+    int total;
+} registro_t;
+
+static void registrar(joystick_dir_t direcao, uint32_t instante_ms, void *contexto) {
+    registro_t *r = contexto;
+    if (r->total < MAX_EVENTOS) {
+        r->direcoes[r->total] = direcao;
+        r->instantes[r->total] = instante_ms;
+    }
+    r->total++;
+}
+
+static joystick_dir_t classificar_anterior(uint16_t x, uint16_t y) {
+    if (x > ANTERIOR_MAX) return JOY_RIGHT;
+    if (x < ANTERIOR_MIN) return JOY_LEFT;
+    if (y > ANTERIOR_MAX) return JOY_UP;
+    if (y < ANTERIOR_MIN) return JOY_DOWN;
+    return JOY_CENTER;
+}
+
+static int executar(const cenario_t *c) {
+    joystick_filtro_t j;
+    registro_t r = {0};
+    joystick_dir_t anterior = JOY_CENTER;
+    int eventos_anteriores = 0;
+
+    semente = 1;
+    joystick_filtro_iniciar(&j, registrar, &r);
+    for (uint32_t t = 0; t < c->duracao_ms; t += PERIODO_MS) {
+        int32_t x, y;
+        c->gerar(t, &x, &y);
+        joystick_filtro_amostra(&j, saturar(x), saturar(y), t);
+
+        if (t % ANTERIOR_PERIODO_MS == 0) {
+            joystick_dir_t d = classificar_anterior(saturar(x), saturar(y));
+            if (d != anterior) {
+                eventos_anteriores++;
+                anterior = d;
+            }
+        }
+    }
+
+    int falhou = r.total != c->total_esperados || !j.calibrado;
+    for (int i = 0; !falhou && i < r.total; i++) {
+        falhou = r.direcoes[i] != c->esperados[i];
+    }
+    int32_t latencia_ms = (c->gesto_ms && r.total > 0) ? (int32_t)(r.instantes[0] - c->gesto_ms) : -1;
+
+    printf("%-18s %2d eventos (anterior %2d) | latencia %3ld ms | centro %4ld,%4ld | descartadas %3lu | %s\n",
+           c->nome, r.total, eventos_anteriores, (long)latencia_ms,
+           (long)(j.centro[0] / 16), (long)(j.centro[1] / 16), (unsigned long)j.descartadas,
+           falhou ? "FALHOU" : "ok");
+    for (int i = 0; falhou && i < r.total && i < MAX_EVENTOS; i++) {
+        printf("    %6lu ms %s\n", (unsigned long)r.instantes[i], nomes[r.direcoes[i]]);
+    }
+    return falhou;
+}
+
+// Reproduz um traço gravado e imprime os eventos
+static int reproduzir(const char *caminho) {
+    FILE *f = fopen(caminho, "r");
+    joystick_filtro_t j;
+    char linha[64];
+
+    if (f == NULL) {
+        perror(caminho);
+        return 1;
+    }
+    joystick_filtro_iniciar(&j, NULL, NULL);
+    while (fgets(linha, sizeof(linha), f) != NULL) {
+        unsigned long t, x, y;
+        if (linha[0] == '#' || sscanf(linha, "%lu %lu %lu", &t, &x, &y) != 3) {
+            continue;
+        }
+        joystick_dir_t antes = j.direcao;
+        joystick_dir_t depois = joystick_filtro_amostra(&j, saturar((int32_t)x), saturar((int32_t)y),
+                                                        (uint32_t)t);
+        if (depois != antes) {
+            printf("%8lu ms %s\n", t, nomes[depois]);
+        }
+    }
+    fclose(f);
+    printf("%lu eventos, %lu descartadas, centro %ld,%ld%s\n", (unsigned long)j.eventos,
+           (unsigned long)j.descartadas, (long)(j.centro[0] / 16), (long)(j.centro[1] / 16),
+           j.calibrado ? "" : " (nao calibrado)");
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        return reproduzir(argv[1]);
+    }
+
+    int falhas = 0;
+    for (unsigned i = 0; i < sizeof(cenarios) / sizeof(cenarios[0]); i++) {
+        falhas += executar(&cenarios[i]);
+    }
+    return falhas ? 1 : 0;
+}
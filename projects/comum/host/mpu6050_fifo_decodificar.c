@@ -0,0 +1,54 @@
+// Decodificador de cópias do FIFO do MPU-6050 no host
+// Lê os bytes do FIFO_R_W na ordem em que saíram do sensor (por exemplo a
+// exportação de um analisador lógico) e imprime os quadros em CSV com os
+// instantes reconstruídos pela ODR; a leitura em blocos de 500 bytes parte
+// quadros como os lotes do RP2040
+//   ./mpu6050_fifo_decodificar fifo.bin taxa_hz [origem_us]
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "mpu6050.h"
+
+static void imprimir(const mpu6050_amostra_t *a, void *contexto) {
+    (void)contexto;
+    printf("%llu,%d,%d,%d,%d,%d,%d\n", (unsigned long long)a->instante_us,
+           a->acel[0], a->acel[1], a->acel[2], a->giro[0], a->giro[1], a->giro[2]);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3 && argc != 4) {
+        fprintf(stderr, "uso: %s fifo.bin taxa_hz [origem_us]\n", argv[0]);
+        return 2;
+    }
+    FILE *f = fopen(argv[1], "rb");
+    if (f == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    uint32_t taxa_hz = (uint32_t)strtoul(argv[2], NULL, 0);
+    uint64_t origem_us = argc == 4 ? strtoull(argv[3], NULL, 0) : 0;
+    if (taxa_hz == 0) {
+        fprintf(stderr, "%s: taxa invalida\n", argv[2]);
+        return 2;
+    }
+
+    mpu6050_fifo_t leitor;
+    uint8_t bloco[500];
+    size_t lidos;
+    uint32_t quadros = 0;
+
+    mpu6050_fifo_iniciar(&leitor, taxa_hz, origem_us);
+    printf("instante_us,acel_x,acel_y,acel_z,giro_x,giro_y,giro_z\n");
+    while ((lidos = fread(bloco, 1, sizeof(bloco), f)) > 0) {
+        quadros += mpu6050_fifo_decodificar(&leitor, bloco, (uint32_t)lidos, imprimir, NULL);
+    }
+    fclose(f);
+
+    fprintf(stderr, "%lu quadros a %lu Hz", (unsigned long)quadros, (unsigned long)taxa_hz);
+    if (leitor.parcial_bytes) {
+        fprintf(stderr, ", %u bytes de um quadro incompleto no fim", leitor.parcial_bytes);
+    }
+    fputc('\n', stderr);
+    return 0;
+}
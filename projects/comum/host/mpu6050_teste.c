@@ -0,0 +1,190 @@
+// Verificação da parte sem hardware do MPU-6050 no host
+// Decodificação da rajada de 14 bytes, temperatura em centésimos contra a
+// fórmula em double, taxa de amostras de cada configuração e o leitor do
+// FIFO: quadros partidos entre lotes, instantes pela ODR e realinhamento
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include <math.h>
+#include <stdio.h>
+#include "mpu6050.h"
+
+static int falhas;
+
+#define CONFERIR(cond, ...) do {                \
+        if (!(cond)) {                          \
+            printf("    " __VA_ARGS__);         \
+            printf("\n");                       \
+            falhas++;                           \
+        }                                       \
+    } while (0)
+
+static int rajada(void) {
+    int antes = falhas;
+    // Ordem dos registradores 0x3B..0x48, big-endian
+    const uint8_t bruto[MPU6050_RAJADA_BYTES] = {
+        0x40, 0x00,     // ACCEL_X = 16384 (1 g a ±2 g)
+        0xFF, 0xFE,     // ACCEL_Y = -2
+        0x80, 0x00,     // ACCEL_Z = -32768
+        0xF2, 0x30,     // TEMP = -3536 -> 26,13 °C
+        0x00, 0x83,     // GYRO_X = 131 (1 °/s a ±250 °/s)
+        0x7F, 0xFF,     // GYRO_Y = 32767
+        0x00, 0x00,     // GYRO_Z = 0
+    };
+    mpu6050_amostra_t a;
+
+    mpu6050_decodificar(bruto, &a);
+    CONFERIR(a.acel[0] == 16384 && a.acel[1] == -2 && a.acel[2] == -32768,
+             "acel: %d %d %d", a.acel[0], a.acel[1], a.acel[2]);
+    CONFERIR(a.temperatura == -3536, "temperatura: %d", a.temperatura);
+    CONFERIR(a.giro[0] == 131 && a.giro[1] == 32767 && a.giro[2] == 0,
+             "giro: %d %d %d", a.giro[0], a.giro[1], a.giro[2]);
+    return falhas - antes;
+}
+
+static int temperatura(void) {
+    int antes = falhas;
+
+    for (int32_t bruto = INT16_MIN; bruto <= INT16_MAX; bruto++) {
+        double esperado = (bruto / 340.0 + 36.53) * 100.0;
+        int32_t obtido = mpu6050_temperatura_centi((int16_t)bruto);
+        // Meio centésimo da divisão arredondada
+        if (fabs(obtido - esperado) > 0.5 + 1e-9) {
+            CONFERIR(0, "temperatura %d: esperado %.3f, obtido %d", bruto, esperado, obtido);
+            break;
+        }
+    }
+    return falhas - antes;
+}
+
+static int taxa(void) {
+    int antes = falhas;
+    const struct {
+        mpu6050_config_t config;
+        uint32_t hz;
+    } casos[] = {
+        { { 0, 7, 0, 0 }, 1000 },      // Sem filtro: 8 kHz / 8
+        { { 0, 0, 0, 0 }, 8000 },
+        { { 3, 0, 0, 0 }, 1000 },      // Filtro de 44 Hz: base de 1 kHz
+        { { 3, 4, 0, 0 }, 200 },
+        { { 6, 255, 0, 0 }, 3 },
+        { { 7, 1, 0, 0 }, 4000 },      // 7 é reservado e também usa 8 kHz
+    };
+
+    for (unsigned i = 0; i < sizeof(casos) / sizeof(casos[0]); i++) {
+        uint32_t hz = mpu6050_taxa_hz(&casos[i].config);
+        CONFERIR(hz == casos[i].hz, "taxa dlpf %u divisor %u: esperado %u, obtido %u",
+                 casos[i].config.dlpf, casos[i].config.divisor, casos[i].hz, hz);
+    }
+    return falhas - antes;
+}
+
+// Quadro 'n' de uma cópia sintética do FIFO: valores distintos por eixo,
+// com sinal, que denunciam qualquer desalinhamento de bytes
+static int16_t valor_sintetico(uint32_t n, int eixo) {
+    return (int16_t)((int32_t)(n * 7919u + (uint32_t)eixo * 4099u) % 65536 - 32768);
+}
+
+#define QUADROS_TESTE   100
+
+typedef struct {
+    uint32_t recebidos;
+    uint64_t origem_us;
+    uint32_t periodo_us;
+} coleta_t;
+
+static void conferir_quadro(const mpu6050_amostra_t *a, void *contexto) {
+    coleta_t *c = contexto;
+    uint32_t n = c->recebidos++;
+
+    for (int i = 0; i < 3; i++) {
+        CONFERIR(a->acel[i] == valor_sintetico(n, i) && a->giro[i] == valor_sintetico(n, 3 + i),
+                 "quadro %u eixo %d: acel %d giro %d", n, i, a->acel[i], a->giro[i]);
+    }
+    CONFERIR(a->temperatura == MPU6050_SEM_TEMPERATURA, "quadro %u com temperatura", n);
+    CONFERIR(a->instante_us == c->origem_us + (uint64_t)n * c->periodo_us,
+             "quadro %u: instante %llu", n, (unsigned long long)a->instante_us);
+}
+
+static int fifo_quadros(void) {
+    int antes = falhas;
+    uint8_t copia[QUADROS_TESTE * MPU6050_QUADRO_BYTES];
+    // Tamanhos de lote que não são múltiplos de 12, incluindo um byte só
+    const uint32_t lotes[] = { 1, 5, 7, 13, 24, 11, 1, 35, 240, 3 };
+    mpu6050_fifo_t f;
+    coleta_t c = { 0, 5000, 1000 };
+
+    for (uint32_t n = 0; n < QUADROS_TESTE; n++) {
+        for (int eixo = 0; eixo < 6; eixo++) {
+            uint16_t v = (uint16_t)valor_sintetico(n, eixo);
+            copia[n * MPU6050_QUADRO_BYTES + eixo * 2] = (uint8_t)(v >> 8);
+            copia[n * MPU6050_QUADRO_BYTES + eixo * 2 + 1] = (uint8_t)v;
+        }
+    }
+
+    mpu6050_fifo_iniciar(&f, 1000, c.origem_us);
+    uint32_t pos = 0, entregues = 0;
+    for (unsigned i = 0; pos < sizeof(copia); i = (i + 1) % (sizeof(lotes) / sizeof(lotes[0]))) {
+        uint32_t total = lotes[i] < sizeof(copia) - pos ? lotes[i] : (uint32_t)sizeof(copia) - pos;
+        entregues += mpu6050_fifo_decodificar(&f, &copia[pos], total, conferir_quadro, &c);
+        pos += total;
+    }
+    CONFERIR(entregues == QUADROS_TESTE && c.recebidos == QUADROS_TESTE,
+             "quadros: %u entregues, %u recebidos", entregues, c.recebidos);
+    CONFERIR(f.parcial_bytes == 0, "sobrou quadro partido: %u bytes", f.parcial_bytes);
+
+    // 3 Hz: período fracionário, sem erro acumulado
+    mpu6050_fifo_iniciar(&f, 3, 0);
+    CONFERIR(mpu6050_fifo_instante(&f, 3) == 1000000 && mpu6050_fifo_instante(&f, 3000) == 1000000000,
+             "instantes a 3 Hz: %llu", (unsigned long long)mpu6050_fifo_instante(&f, 3));
+    return falhas - antes;
+}
+
+static int fifo_ancorar(void) {
+    int antes = falhas;
+    mpu6050_fifo_t f;
+    int32_t ajuste;
+
+    // 1 kHz, quadro 0 em 10000 us; 10 quadros já entregues
+    mpu6050_fifo_iniciar(&f, 1000, 10000);
+    f.quadros = 10;
+
+    ajuste = mpu6050_fifo_ancorar(&f, 20000, 0);
+    CONFERIR(ajuste == 0 && f.origem_us == 10000, "FIFO vazio: ajuste %d", ajuste);
+
+    // 5 quadros no FIFO: o mais novo (14) previsto em 24000, dentro de (24000 - 1000, 24000]
+    ajuste = mpu6050_fifo_ancorar(&f, 24000, 5 * MPU6050_QUADRO_BYTES);
+    CONFERIR(ajuste == 0 && f.origem_us == 10000, "na janela: ajuste %d", ajuste);
+    ajuste = mpu6050_fifo_ancorar(&f, 24900, 5 * MPU6050_QUADRO_BYTES + 6);
+    CONFERIR(ajuste == 0 && f.origem_us == 10000, "fim da janela: ajuste %d", ajuste);
+
+    // Sensor lento: 5 quadros já em 23500 poriam o quadro 14 no futuro
+    ajuste = mpu6050_fifo_ancorar(&f, 23500, 5 * MPU6050_QUADRO_BYTES);
+    CONFERIR(ajuste == -500 && f.origem_us == 9500, "sensor lento: ajuste %d", ajuste);
+
+    // Sensor rápido: 5 quadros, mas já em 26000 -> o quadro 14 encosta em 25000
+    ajuste = mpu6050_fifo_ancorar(&f, 26000, 5 * MPU6050_QUADRO_BYTES);
+    CONFERIR(ajuste == 1500 && mpu6050_fifo_instante(&f, 14) == 25000, "sensor rápido: ajuste %d", ajuste);
+
+    // Quadro partido: 6 bytes no leitor + 6 no FIFO completam o quadro 10
+    f.parcial_bytes = 6;
+    uint64_t origem = f.origem_us;
+    ajuste = mpu6050_fifo_ancorar(&f, mpu6050_fifo_instante(&f, 10), 6);
+    CONFERIR(ajuste == 0 && f.origem_us == origem, "quadro partido: ajuste %d", ajuste);
+    return falhas - antes;
+}
+
+int main(void) {
+    int r;
+
+    r = rajada();
+    printf("%-22s %s\n", "rajada", r ? "FALHOU" : "ok");
+    r = temperatura();
+    printf("%-22s %s\n", "temperatura", r ? "FALHOU" : "ok");
+    r = taxa();
+    printf("%-22s %s\n", "taxa", r ? "FALHOU" : "ok");
+    r = fifo_quadros();
+    printf("%-22s %s\n", "fifo_quadros", r ? "FALHOU" : "ok");
+    r = fifo_ancorar();
+    printf("%-22s %s\n", "fifo_ancorar", r ? "FALHOU" : "ok");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+// Benchmark da série temporal no host: taxa de compressão e vazão de
+// codificação/decodificação para sinais parecidos com os dos projetos
+// A compressão é a mesma no Pico; a vazão é do PC, só como referência
+// O formato bruto de comparação é o menor formato binário fixo de cada
+// sinal (instante de 32 bits + valores de 16 bits), não o texto do printf
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "serie.h"
+
+#define PAGINAS_FLASH   64              // Área padrão de 256 KB (serie_flash.h)
+
+static uint8_t (*paginas)[SERIE_PAGINA_BYTES];
+static uint32_t total_paginas;
+
+static const uint8_t *ler(void *contexto, uint32_t indice) {
+    (void)contexto;
+    return paginas[indice];
+}
+
+static bool gravar(void *contexto, uint32_t indice, const uint8_t *pagina) {
+    (void)contexto;
+    memcpy(paginas[indice], pagina, SERIE_PAGINA_BYTES);
+    return true;
+}
+
+static uint32_t semente = 1;
+
+static int32_t ruido(int32_t amplitude) {
+    semente = semente * 1103515245u + 12345u;
+    return (int32_t)((semente >> 16) % (uint32_t)(2 * amplitude + 1)) - amplitude;
+}
+
+// Temperatura em centésimos a 1 Hz: ciclo diário lento e ruído de ±3
+static void temperatura(uint32_t i, uint32_t *t, int32_t *v) {
+    *t = i * 1000u;
+    v[0] = 3500 + (int32_t)(300.0 * sin(2.0 * M_PI * i / 86400.0)) + ruido(3);
+}
+
+// Joystick a 100 Hz: parado perto do centro, com um gesto a cada 5 s
+static void joystick(uint32_t i, uint32_t *t, int32_t *v) {
+    *t = i * 10u;
+    int32_t gesto = (i % 500) < 40 ? 1900 : 0;
+    v[0] = 2010 + gesto + ruido(30);
+    v[1] = 2030 + ruido(30);
+}
+
+// MPU-6050 a 1 kHz: aceleração (16384 LSB/g, gravidade em Z, vibração de 5 Hz)
+// e giroscópio (deriva lenta), com ruído de conversão
+static void imu(uint32_t i, uint32_t *t, int32_t *v) {
+    double s = i / 1000.0;
+    *t = i;
+    v[0] = (int32_t)(300.0 * sin(2.0 * M_PI * 5.0 * s)) + ruido(40);
+    v[1] = (int32_t)(150.0 * cos(2.0 * M_PI * 5.0 * s)) + ruido(40);
+    v[2] = 16384 + ruido(60);
+    v[3] = (int32_t)(500.0 * sin(2.0 * M_PI * 0.2 * s)) + ruido(20);
+    v[4] = ruido(20);
+    v[5] = -35 + ruido(20);
+}
+
+typedef struct {
+    const char *nome;
+    void (*gerar)(uint32_t i, uint32_t *t, int32_t *v);
+    uint8_t canais;
+    uint32_t amostras;
+    uint32_t taxa_hz;
+} sinal_t;
+
+static const sinal_t sinais[] = {
+    { "temperatura 1 Hz",   temperatura, 1, 86400,  1 },
+    { "joystick 100 Hz",    joystick,    2, 360000, 100 },
+    { "imu 1 kHz (6 eixos)", imu,        6, 300000, 1000 },
+};
+
+static double segundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static serie_t serie;
+
+static void medir(const sinal_t *s) {
+    uint32_t *instantes = malloc(sizeof(uint32_t) * s->amostras);
+    int32_t *valores = malloc(sizeof(int32_t) * SERIE_CANAIS_MAX * s->amostras);
+
+    // Sinal gerado antes, fora da medida
+    semente = 1;
+    for (uint32_t i = 0; i < s->amostras; i++) {
+        s->gerar(i, &instantes[i], &valores[i * SERIE_CANAIS_MAX]);
+    }
+
+    // Meio grande o bastante para o sinal inteiro
+    size_t bruto = (size_t)s->amostras * (4u + 2u * s->canais);
+    total_paginas = (uint32_t)(bruto / SERIE_PAGINA_BYTES + 4);
+    paginas = malloc((size_t)total_paginas * SERIE_PAGINA_BYTES);
+    memset(paginas, 0xFF, (size_t)total_paginas * SERIE_PAGINA_BYTES);
+    serie_meio_t meio = { total_paginas, ler, gravar, NULL };
+
+    double t0 = segundos();
+    serie_iniciar(&serie, s->canais, &meio);
+    for (uint32_t i = 0; i < s->amostras; i++) {
+        serie_acrescentar(&serie, instantes[i], &valores[i * SERIE_CANAIS_MAX]);
+        serie_descarregar(&serie);
+    }
+    serie_selar(&serie);
+    serie_descarregar(&serie);
+    double codificacao = segundos() - t0;
+
+    size_t usados = 0;
+    for (uint32_t i = 0; i < total_paginas; i++) {
+        serie_pagina_info_t info;
+        if (serie_pagina_info(paginas[i], &info)) {
+            usados += info.bytes;
+        }
+    }
+
+    serie_consulta_t c;
+    serie_amostra_t a;
+    uint32_t lidas = 0, erradas = 0;
+    t0 = segundos();
+    serie_consulta_iniciar(&c, &serie, 0, UINT32_MAX, 0);
+    while (serie_consulta_proxima(&c, &a, NULL)) {
+        erradas += a.instante_ms != instantes[lidas] ||
+                   memcmp(a.valores, &valores[lidas * SERIE_CANAIS_MAX], s->canais * sizeof(int32_t)) != 0;
+        lidas++;
+    }
+    double decodificacao = segundos() - t0;
+
+    uint32_t paginas_usadas = serie.metricas.paginas_gravadas;
+    double por_pagina = (double)s->amostras / paginas_usadas;
+    double capacidade_s = por_pagina * PAGINAS_FLASH / s->taxa_hz;
+
+    printf("%-20s %7lu amostras | %6.2f B/amostra (bruto %2u) | taxa %5.2fx | "
+           "codifica %6.1f M/s | decodifica %6.1f M/s | 256 KB = %.1f %s%s\n",
+           s->nome, (unsigned long)s->amostras, (double)usados / s->amostras, 4u + 2u * s->canais,
+           (double)bruto / usados, s->amostras / codificacao / 1e6, lidas / decodificacao / 1e6,
+           capacidade_s >= 3600 ? capacidade_s / 3600 : capacidade_s / 60,
+           capacidade_s >= 3600 ? "h" : "min",
+           (lidas != s->amostras || erradas) ? " | DIFERENTE" : "");
+
+    free(paginas);
+    free(instantes);
+    free(valores);
+}
+
+int main(void) {
+    for (unsigned i = 0; i < sizeof(sinais) / sizeof(sinais[0]); i++) {
+        medir(&sinais[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Decodificador da série temporal no host
+// Lê uma cópia da área da série (a flash, salva por exemplo com
+// "picotool save -r <inicio> <fim> serie.bin") e imprime as amostras em CSV,
+// da mais antiga à mais nova; o resumo das páginas vai para stderr
+//   ./serie_decodificar serie.bin [inicio_ms fim_ms [passo_ms]]
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "serie.h"
+
+typedef struct {
+    uint8_t *dados;
+    uint32_t paginas;
+} copia_t;
+
+static const uint8_t *ler(void *contexto, uint32_t indice) {
+    copia_t *c = contexto;
+    return c->dados + (size_t)indice * SERIE_PAGINA_BYTES;
+}
+
+static bool gravar(void *contexto, uint32_t indice, const uint8_t *pagina) {
+    (void)contexto; (void)indice; (void)pagina;
+    return false;                       // Só leitura
+}
+
+static serie_t serie;
+
+int main(int argc, char **argv) {
+    if (argc != 2 && argc != 4 && argc != 5) {
+        fprintf(stderr, "uso: %s serie.bin [inicio_ms fim_ms [passo_ms]]\n", argv[0]);
+        return 2;
+    }
+    FILE *f = fopen(argv[1], "rb");
+    if (f == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    long tamanho = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    copia_t copia = { malloc((size_t)tamanho), (uint32_t)(tamanho / SERIE_PAGINA_BYTES) };
+    if (copia.dados == NULL || fread(copia.dados, 1, (size_t)tamanho, f) != (size_t)tamanho) {
+        fprintf(stderr, "%s: falha na leitura\n", argv[1]);
+        return 1;
+    }
+    fclose(f);
+
+    serie_meio_t meio = { copia.paginas, ler, gravar, &copia };
+    serie_iniciar(&serie, 1, &meio);
+
+    uint32_t validas = 0, amostras = 0, bytes = 0;
+    uint16_t sessao_min = UINT16_MAX, sessao_max = 0;
+    for (uint32_t i = 0; i < copia.paginas; i++) {
+        serie_pagina_info_t info;
+        if (serie_pagina_info(ler(&copia, i), &info)) {
+            validas++;
+            amostras += info.amostras;
+            bytes += info.bytes;
+            sessao_min = info.sessao < sessao_min ? info.sessao : sessao_min;
+            sessao_max = info.sessao > sessao_max ? info.sessao : sessao_max;
+        }
+    }
+    fprintf(stderr, "%lu paginas, %lu validas, %lu amostras, %.2f bytes/amostra",
+            (unsigned long)copia.paginas, (unsigned long)validas, (unsigned long)amostras,
+            amostras ? (double)bytes / amostras : 0.0);
+    if (validas) {
+        fprintf(stderr, ", sessoes %u a %u", sessao_min, sessao_max);
+    }
+    fputc('\n', stderr);
+
+    uint32_t inicio = argc >= 4 ? (uint32_t)strtoul(argv[2], NULL, 0) : 0;
+    uint32_t fim = argc >= 4 ? (uint32_t)strtoul(argv[3], NULL, 0) : UINT32_MAX;
+    uint32_t passo = argc == 5 ? (uint32_t)strtoul(argv[4], NULL, 0) : 0;
+    serie_consulta_t c;
+    serie_amostra_t a;
+    uint8_t canais;
+
+    serie_consulta_iniciar(&c, &serie, inicio, fim, passo);
+    while (serie_consulta_proxima(&c, &a, &canais)) {
+        printf("%lu", (unsigned long)a.instante_ms);
+        for (uint8_t k = 0; k < canais; k++) {
+            printf(",%ld", (long)a.valores[k]);
+        }
+        putchar('\n');
+    }
+    free(copia.dados);
+    return 0;
+}
@@ -0,0 +1,285 @@
+// Verificação da série temporal no host
+// Meio em memória no lugar da flash (apagado = 0xFF); cada cenário grava
+// amostras, descarrega as páginas e confere o que a consulta devolve
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "serie.h"
+
+#define PAGINAS_MEIO    64
+
+typedef struct {
+    uint8_t paginas[PAGINAS_MEIO][SERIE_PAGINA_BYTES];
+    uint32_t gravacoes;
+} memoria_t;
+
+static memoria_t memoria;
+
+static const uint8_t *ler(void *contexto, uint32_t indice) {
+    return ((memoria_t *)contexto)->paginas[indice];
+}
+
+static bool gravar(void *contexto, uint32_t indice, const uint8_t *pagina) {
+    memoria_t *m = contexto;
+    memcpy(m->paginas[indice], pagina, SERIE_PAGINA_BYTES);
+    m->gravacoes++;
+    return true;
+}
+
+static serie_meio_t meio_com(uint32_t paginas) {
+    memset(&memoria, 0xFF, sizeof(memoria));
+    return (serie_meio_t){ paginas, ler, gravar, &memoria };
+}
+
+// Sinal de teste: instantes com jitter e valores com saltos extremos
+static uint32_t semente;
+
+static uint32_t aleatorio(void) {
+    semente = semente * 1103515245u + 12345u;
+    return semente >> 8;
+}
+
+static void gerar(uint32_t i, uint32_t *instante, int32_t *valores, uint8_t canais) {
+    static uint32_t t;
+    if (i == 0) {
+        t = 1000;
+    }
+    t += 10 + (aleatorio() % 5 == 0 ? aleatorio() % 3 : 0) + (i % 997 == 0 ? 5000 : 0);
+    *instante = t;
+    for (uint8_t k = 0; k < canais; k++) {
+        int32_t v = (int32_t)(k * 1000) + (int32_t)(aleatorio() % 64) - 32;
+        if (i % 499 == k) {
+            v = (i & 1) ? INT32_MAX : INT32_MIN;
+        }
+        valores[k] = v;
+    }
+}
+
+static serie_t serie;
+static serie_amostra_t esperadas[20000];
+
+static int conferir(const char *nome, bool ok, const char *detalhe) {
+    printf("%-22s %s%s%s\n", nome, ok ? "ok" : "FALHOU", detalhe[0] ? " | " : "", detalhe);
+    return ok ? 0 : 1;
+}
+
+// Grava 'total' amostras e confere a consulta completa contra as 'esperadas'
+// a partir de 'primeira'
+static bool consulta_igual(uint32_t primeira, uint32_t total, uint8_t canais) {
+    serie_consulta_t c;
+    serie_amostra_t a;
+    uint8_t n;
+    uint32_t i = primeira;
+
+    serie_consulta_iniciar(&c, &serie, 0, UINT32_MAX, 0);
+    while (serie_consulta_proxima(&c, &a, &n)) {
+        if (i >= total || n != canais || a.instante_ms != esperadas[i].instante_ms ||
+            memcmp(a.valores, esperadas[i].valores, canais * sizeof(int32_t)) != 0) {
+            return false;
+        }
+        i++;
+    }
+    return i == total;
+}
+
+static int ida_e_volta(void) {
+    const uint8_t canais = 3;
+    const uint32_t total = 20000;
+    serie_meio_t meio = meio_com(PAGINAS_MEIO);
+    char detalhe[96];
+
+    semente = 7;
+    serie_iniciar(&serie, canais, &meio);
+    for (uint32_t i = 0; i < total; i++) {
+        gerar(i, &esperadas[i].instante_ms, esperadas[i].valores, canais);
+        serie_acrescentar(&serie, esperadas[i].instante_ms, esperadas[i].valores);
+        serie_descarregar(&serie);
+    }
+    bool ok = consulta_igual(0, total, canais) && serie.metricas.paginas_perdidas == 0;
+
+    // A ordem vem da sequência, não da posição no meio
+    static uint8_t troca[SERIE_PAGINA_BYTES];
+    memcpy(troca, memoria.paginas[3], SERIE_PAGINA_BYTES);
+    memcpy(memoria.paginas[3], memoria.paginas[7], SERIE_PAGINA_BYTES);
+    memcpy(memoria.paginas[7], troca, SERIE_PAGINA_BYTES);
+    ok = ok && consulta_igual(0, total, canais);
+    snprintf(detalhe, sizeof(detalhe), "%lu paginas gravadas, %.2f bytes/amostra",
+             (unsigned long)serie.metricas.paginas_gravadas,
+             (double)(serie.metricas.paginas_gravadas + 1) * SERIE_PAGINA_BYTES / total);
+    return conferir("ida e volta", ok, detalhe);
+}
+
+// Meio pequeno: só as páginas mais novas sobrevivem, em ordem; depois de um
+// "reset" o relógio do chamador recomeça do zero e a série continua depois
+// delas, numa nova sessão
+static int anel_e_reinicio(void) {
+    const uint8_t canais = 2;
+    const uint32_t total = 12000;
+    serie_meio_t meio = meio_com(4);
+    serie_pagina_info_t info;
+
+    semente = 11;
+    serie_iniciar(&serie, canais, &meio);
+    for (uint32_t i = 0; i < total; i++) {
+        gerar(i, &esperadas[i].instante_ms, esperadas[i].valores, canais);
+        serie_acrescentar(&serie, esperadas[i].instante_ms, esperadas[i].valores);
+        serie_descarregar(&serie);
+    }
+    serie_selar(&serie);
+    serie_descarregar(&serie);
+
+    // A mais antiga que sobrou é a primeira página depois da próxima a gravar
+    serie_pagina_info(memoria.paginas[serie.meio_proxima], &info);
+    uint32_t primeira = 0;
+    while (esperadas[primeira].instante_ms != info.inicio_ms) {
+        primeira++;
+    }
+    bool ok = consulta_igual(primeira, total, canais);
+
+    uint32_t sequencia = serie.proxima_sequencia;
+    uint32_t ultimo_ms = esperadas[total - 1].instante_ms;
+    serie_iniciar(&serie, canais, &meio);
+    ok = ok && serie.proxima_sequencia == sequencia && serie.meio_total == 4 &&
+         serie.sessao == 1 && serie.base_ms == ultimo_ms + 1;
+
+    // Continua gravando por cima da mais antiga, com o relógio do chamador
+    // recomeçando em 1 s como depois de um boot
+    uint32_t local_ms = 0;
+    for (uint32_t i = total; i < total + 2000; i++) {
+        gerar(i, &esperadas[i].instante_ms, esperadas[i].valores, canais);
+        local_ms += i == total ? 1000u : esperadas[i].instante_ms - esperadas[i - 1].instante_ms;
+        esperadas[i].instante_ms = serie.base_ms + local_ms;
+        serie_acrescentar(&serie, local_ms, esperadas[i].valores);
+        serie_descarregar(&serie);
+    }
+    serie_pagina_info(memoria.paginas[serie.meio_proxima], &info);
+    while (esperadas[primeira].instante_ms != info.inicio_ms) {
+        primeira++;
+    }
+    ok = ok && consulta_igual(primeira, total + 2000, canais);
+
+    // Intervalo a partir da base: só a sessão nova, gravada com a sessão 1
+    serie_consulta_t c;
+    serie_amostra_t a;
+    uint32_t novas = 0;
+    serie_consulta_iniciar(&c, &serie, serie.base_ms, UINT32_MAX, 0);
+    while (serie_consulta_proxima(&c, &a, NULL)) {
+        novas++;
+    }
+    serie_pagina_info(serie.ram[serie.ram_inicio], &info);
+    ok = ok && novas == 2000 && info.sessao == 1;
+    return conferir("anel e reinicio", ok, "");
+}
+
+// 1 Hz por 1 h; intervalo e média por 10 s
+static int intervalo_e_media(void) {
+    serie_meio_t meio = meio_com(PAGINAS_MEIO);
+    serie_consulta_t c;
+    serie_amostra_t a;
+    bool ok = true;
+    int total = 0;
+
+    serie_iniciar(&serie, 1, &meio);
+    for (uint32_t t = 0; t < 3600; t++) {
+        int32_t v = 2500 + (int32_t)(t % 20) - 10;         // Média 2499,5 a cada 20 s
+        serie_acrescentar(&serie, t * 1000, &v);
+        serie_descarregar(&serie);
+    }
+
+    serie_consulta_iniciar(&c, &serie, 100000, 199000, 0);
+    while (serie_consulta_proxima(&c, &a, NULL)) {
+        ok = ok && a.instante_ms == 100000u + (uint32_t)total * 1000u;
+        total++;
+    }
+    ok = ok && total == 100;
+
+    total = 0;
+    serie_consulta_iniciar(&c, &serie, 100000, 299999, 20000);
+    while (serie_consulta_proxima(&c, &a, NULL)) {
+        ok = ok && a.instante_ms == 100000u + (uint32_t)total * 20000u && a.valores[0] == 2500;
+        total++;
+    }
+    ok = ok && total == 10;
+
+    // Intervalo de 10 s: metade alta e metade baixa da rampa
+    total = 0;
+    serie_consulta_iniciar(&c, &serie, 0, 19999, 10000);
+    while (serie_consulta_proxima(&c, &a, NULL)) {
+        ok = ok && a.valores[0] == (total == 0 ? 2495 : 2505);
+        total++;
+    }
+    ok = ok && total == 2;
+    return conferir("intervalo e media", ok, "");
+}
+
+// Sem meio: o anel em RAM guarda as duas páginas mais novas
+static int so_ram(void) {
+    const uint8_t canais = 1;
+    serie_consulta_t c;
+    serie_amostra_t a;
+    uint32_t anterior = 0, lidas = 0;
+    bool ok = true;
+
+    serie_iniciar(&serie, canais, NULL);
+    for (uint32_t t = 0; t < 10000; t++) {
+        int32_t v = (int32_t)t;
+        serie_acrescentar(&serie, t, &v);
+    }
+    serie_consulta_iniciar(&c, &serie, 0, UINT32_MAX, 0);
+    while (serie_consulta_proxima(&c, &a, NULL)) {
+        ok = ok && (lidas == 0 || a.instante_ms == anterior + 1) && a.valores[0] == (int32_t)a.instante_ms;
+        anterior = a.instante_ms;
+        lidas++;
+    }
+    ok = ok && anterior == 9999 && serie.metricas.paginas_perdidas > 0 && lidas < 10000;
+    return conferir("so ram", ok, "");
+}
+
+// Páginas estragadas no meio do anel: uma sem marca (apagada pela metade) é
+// pulada e uma com o fim em 0xFF (gravação interrompida) é lida até onde dá;
+// as outras continuam legíveis
+static int pagina_corrompida(void) {
+    const uint8_t canais = 2;
+    const uint32_t total = 6000;
+    serie_meio_t meio = meio_com(PAGINAS_MEIO);
+    serie_consulta_t c;
+    serie_amostra_t a;
+    uint32_t lidas = 0;
+
+    semente = 3;
+    serie_iniciar(&serie, canais, &meio);
+    for (uint32_t i = 0; i < total; i++) {
+        gerar(i, &esperadas[i].instante_ms, esperadas[i].valores, canais);
+        serie_acrescentar(&serie, esperadas[i].instante_ms, esperadas[i].valores);
+        serie_descarregar(&serie);
+    }
+    // Limite inferior: tudo menos as duas páginas estragadas
+    serie_pagina_info_t info;
+    uint32_t minimo = total;
+    for (int p = 1; p <= 2; p++) {
+        serie_pagina_info(memoria.paginas[p], &info);
+        minimo -= info.amostras;
+    }
+    memoria.paginas[1][0] ^= 0xFF;                          // Marca
+    memset(memoria.paginas[2] + 2048, 0xFF, SERIE_PAGINA_BYTES - 2048);
+
+    serie_consulta_iniciar(&c, &serie, 0, UINT32_MAX, 0);
+    while (serie_consulta_proxima(&c, &a, NULL)) {
+        lidas++;
+    }
+    bool ok = lidas > minimo && lidas < total;
+    return conferir("pagina corrompida", ok, "");
+}
+
+int main(void) {
+    int falhas = 0;
+
+    falhas += ida_e_volta();
+    falhas += anel_e_reinicio();
+    falhas += intervalo_e_media();
+    falhas += so_ram();
+    falhas += pagina_corrompida();
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+// Joystick com calibração automática, filtro e eventos (ver joystick_filtro.h)
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include "joystick_filtro.h"
+
+#include <string.h>
+
+// Ponto fixo do filtro: valor do ADC * 16
+#define ESCALA_SHIFT            4
+#define ESCALA                  (1 << ESCALA_SHIFT)
+
+static uint16_t mediana3(const uint16_t v[3]) {
+    uint16_t a = v[0], b = v[1], c = v[2];
+
+    if (a > b) { uint16_t t = a; a = b; b = t; }
+    if (b > c) { b = c; }
+    return a > b ? a : b;
+}
+
+static int32_t modulo(int32_t v) {
+    return v < 0 ? -v : v;
+}
+
+void joystick_filtro_iniciar(joystick_filtro_t *j, joystick_evento_t evento, void *contexto) {
+    memset(j, 0, sizeof(*j));
+    j->centro[0] = JOYSTICK_CENTRO_NOMINAL * ESCALA;
+    j->centro[1] = JOYSTICK_CENTRO_NOMINAL * ESCALA;
+    j->classe = JOY_CENTER;
+    j->candidata = JOY_CENTER;
+    j->direcao = JOY_CENTER;
+    j->evento = evento;
+    j->contexto = contexto;
+}
+
+// Classifica o desvio atual com histerese radial e margem entre eixos
+static joystick_dir_t classificar(const joystick_filtro_t *j, int32_t dx, int32_t dy) {
+    int32_t r2 = dx * dx + dy * dy;
+    int32_t raio = (j->classe == JOY_CENTER) ? JOYSTICK_RAIO_ENTRADA : JOYSTICK_RAIO_SAIDA;
+
+    if (r2 <= raio * raio) {
+        return JOY_CENTER;
+    }
+
+    // Eixo dominante; mantendo o eixo atual enquanto o outro não passar da margem
+    bool eixo_x;
+    if (j->classe == JOY_RIGHT || j->classe == JOY_LEFT) {
+        eixo_x = modulo(dy) <= modulo(dx) + JOYSTICK_MARGEM_EIXO;
+    } else if (j->classe == JOY_UP || j->classe == JOY_DOWN) {
+        eixo_x = modulo(dx) > modulo(dy) + JOYSTICK_MARGEM_EIXO;
+    } else {
+        eixo_x = modulo(dx) >= modulo(dy);
+    }
+    if (eixo_x) {
+        return dx > 0 ? JOY_RIGHT : JOY_LEFT;
+    }
+    return dy > 0 ? JOY_UP : JOY_DOWN;
+}
+
+joystick_dir_t joystick_filtro_amostra(joystick_filtro_t *j, uint16_t x, uint16_t y,
+                                       uint32_t instante_ms) {
+    const uint16_t brutas[2] = { x, y };
+
+    for (int e = 0; e < 2; e++) {
+        j->historico[e][0] = j->historico[e][1];
+        j->historico[e][1] = j->historico[e][2];
+        j->historico[e][2] = brutas[e];
+    }
+    if (j->amostras < 3) {
+        j->amostras++;
+    }
+
+    for (int e = 0; e < 2; e++) {
+        // Mediana só com o histórico completo; antes, a própria amostra
+        int32_t m = (j->amostras == 3 ? mediana3(j->historico[e]) : brutas[e]) * ESCALA;
+        if (j->amostras == 1) {
+            j->filtrado[e] = m;
+        } else {
+            j->filtrado[e] += (m - j->filtrado[e]) / (1 << JOYSTICK_FILTRO_SHIFT);
+        }
+    }
+
+    // Calibração do centro: só com o joystick perto do meio da escala
+    if (!j->calibrado && j->amostras == 3) {
+        int32_t tolerancia = JOYSTICK_TOLERANCIA_CENTRO * ESCALA;
+        if (modulo(j->filtrado[0] - JOYSTICK_CENTRO_NOMINAL * ESCALA) < tolerancia &&
+            modulo(j->filtrado[1] - JOYSTICK_CENTRO_NOMINAL * ESCALA) < tolerancia) {
+            j->soma_calibracao[0] += (uint32_t)j->filtrado[0];
+            j->soma_calibracao[1] += (uint32_t)j->filtrado[1];
+            if (++j->total_calibracao == JOYSTICK_AMOSTRAS_CALIBRACAO) {
+                j->centro[0] = (int32_t)(j->soma_calibracao[0] / JOYSTICK_AMOSTRAS_CALIBRACAO);
+                j->centro[1] = (int32_t)(j->soma_calibracao[1] / JOYSTICK_AMOSTRAS_CALIBRACAO);
+                j->calibrado = true;
+            }
+        } else {
+            // Movimento no meio da calibração: recomeça
+            j->soma_calibracao[0] = 0;
+            j->soma_calibracao[1] = 0;
+            j->total_calibracao = 0;
+        }
+    }
+
+    int32_t dx, dy;
+    joystick_filtro_desvio(j, &dx, &dy);
+    j->classe = classificar(j, dx, dy);
+
+    // Deriva: o centro segue devagar a posição de repouso
+    if (j->calibrado && j->classe == JOY_CENTER &&
+        dx * dx + dy * dy < JOYSTICK_RAIO_DERIVA * JOYSTICK_RAIO_DERIVA) {
+        for (int e = 0; e < 2; e++) {
+            j->centro[e] += (j->filtrado[e] - j->centro[e]) / (1 << JOYSTICK_DERIVA_SHIFT);
+        }
+    }
+
+    // Debounce: a direção nova precisa persistir antes do evento
+    if (j->classe != j->candidata) {
+        if (j->candidata != j->direcao) {
+            j->descartadas++;
+        }
+        j->candidata = j->classe;
+        j->candidata_desde_ms = instante_ms;
+    }
+    if (j->candidata != j->direcao &&
+        instante_ms - j->candidata_desde_ms >= JOYSTICK_DEBOUNCE_MS) {
+        j->direcao = j->candidata;
+        j->eventos++;
+        if (j->evento != NULL) {
+            j->evento(j->direcao, instante_ms, j->contexto);
+        }
+    }
+    return j->direcao;
+}
+
+void joystick_filtro_desvio(const joystick_filtro_t *j, int32_t *dx, int32_t *dy) {
+    *dx = (j->filtrado[0] - j->centro[0]) / ESCALA;
+    *dy = (j->filtrado[1] - j->centro[1]) / ESCALA;
+}
@@ -0,0 +1,90 @@
+// Joystick analógico com calibração automática, filtro e detecção por evento
+// Cada amostra dos dois eixos passa por mediana de 3 (descarta picos isolados)
+// e por um IIR de primeira ordem em ponto fixo (valor * 16); o centro é
+// aprendido no boot com as primeiras amostras próximas do meio da escala e
+// segue a deriva lentamente enquanto o joystick está solto
+// A direção sai do desvio em relação ao centro: zona morta radial com
+// histerese (raio de entrada maior que o de saída), eixo dominante com margem
+// para trocar de eixo e debounce temporal; cada direção confirmada gera um
+// evento pelo callback
+// Sem dependência de hardware ou RTOS: testado no host com traços de ADC
+// (host/joystick_teste.c)
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef JOYSTICK_FILTRO_H
+#define JOYSTICK_FILTRO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Escala do ADC de 12 bits e centro nominal, usado até a calibração
+#define JOYSTICK_ADC_MAX            4095
+#define JOYSTICK_CENTRO_NOMINAL     2048
+
+// Calibração: amostras filtradas a menos de JOYSTICK_TOLERANCIA_CENTRO do
+// centro nominal nos dois eixos; com o joystick fora dessa janela no boot a
+// calibração espera ele ser solto
+#define JOYSTICK_TOLERANCIA_CENTRO  400
+#define JOYSTICK_AMOSTRAS_CALIBRACAO 32
+
+// Zona morta radial (unidades do ADC): sai do centro acima do raio de entrada
+// e só volta abaixo do raio de saída
+#define JOYSTICK_RAIO_ENTRADA       1200
+#define JOYSTICK_RAIO_SAIDA         800
+
+// Vantagem que o outro eixo precisa ter para trocar a direção de eixo
+#define JOYSTICK_MARGEM_EIXO        200
+
+// Tempo que uma direção nova precisa persistir antes do evento
+#define JOYSTICK_DEBOUNCE_MS        20
+
+// Filtro IIR: peso 1/2^N da amostra nova; deriva do centro: 1/2^N por amostra
+// dentro do raio JOYSTICK_RAIO_DERIVA
+#define JOYSTICK_FILTRO_SHIFT       1
+#define JOYSTICK_DERIVA_SHIFT       8
+#define JOYSTICK_RAIO_DERIVA        300
+
+// Direções do joystick
+typedef enum {
+    JOY_CENTER = 0,            // Dentro da zona morta
+    JOY_RIGHT,                 // X acima do centro
+    JOY_LEFT,                  // X abaixo do centro
+    JOY_DOWN,                  // Y abaixo do centro
+    JOY_UP                     // Y acima do centro
+} joystick_dir_t;
+
+// Evento de direção confirmada (após o debounce), no instante da amostra
+typedef void (*joystick_evento_t)(joystick_dir_t direcao, uint32_t instante_ms, void *contexto);
+
+// Estado do filtro de um joystick
+typedef struct {
+    uint16_t historico[2][3];         // Últimas amostras brutas por eixo (mediana)
+    uint8_t amostras;                 // Amostras recebidas, saturado em 3
+    int32_t filtrado[2];              // Saída do IIR, valor * 16
+    int32_t centro[2];                // Centro aprendido, valor * 16
+    uint32_t soma_calibracao[2];
+    uint16_t total_calibracao;
+    bool calibrado;
+    joystick_dir_t classe;            // Classificação da amostra atual (antes do debounce)
+    joystick_dir_t candidata;         // Direção esperando o debounce
+    uint32_t candidata_desde_ms;
+    joystick_dir_t direcao;           // Última direção confirmada
+    joystick_evento_t evento;
+    void *contexto;
+    uint32_t eventos;                 // Direções confirmadas
+    uint32_t descartadas;             // Candidatas que não duraram o debounce
+} joystick_filtro_t;
+
+// Prepara o filtro; 'evento' (pode ser NULL) recebe cada direção confirmada
+void joystick_filtro_iniciar(joystick_filtro_t *j, joystick_evento_t evento, void *contexto);
+
+// Processa uma amostra dos dois eixos (0-4095) e retorna a direção confirmada
+// As amostras devem vir em intervalos regulares (o filtro e o debounce são
+// ajustados para ~10 ms)
+joystick_dir_t joystick_filtro_amostra(joystick_filtro_t *j, uint16_t x, uint16_t y,
+                                       uint32_t instante_ms);
+
+// Desvio filtrado em relação ao centro, em unidades do ADC
+void joystick_filtro_desvio(const joystick_filtro_t *j, int32_t *dx, int32_t *dy);
+
+#endif // JOYSTICK_FILTRO_H
@@ -0,0 +1,88 @@
+// MPU-6050: configuração e decodificação (ver mpu6050.h)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include "mpu6050.h"
+
+uint32_t mpu6050_taxa_hz(const mpu6050_config_t *config) {
+    uint32_t base = (config->dlpf == 0 || config->dlpf == 7) ? 8000u : 1000u;
+
+    return base / (1u + config->divisor);
+}
+
+static int16_t palavra(const uint8_t *p) {
+    return (int16_t)((uint16_t)p[0] << 8 | p[1]);
+}
+
+void mpu6050_decodificar(const uint8_t *bruto, mpu6050_amostra_t *amostra) {
+    for (int i = 0; i < 3; i++) {
+        amostra->acel[i] = palavra(&bruto[i * 2]);
+        amostra->giro[i] = palavra(&bruto[8 + i * 2]);
+    }
+    amostra->temperatura = palavra(&bruto[6]);
+}
+
+int32_t mpu6050_temperatura_centi(int16_t bruto) {
+    // bruto * 100 / 340 + 3653, com a divisão arredondada nos dois sentidos
+    int32_t escalado = (int32_t)bruto * 100;
+    int32_t parcial = escalado >= 0 ? (escalado + 170) / 340 : (escalado - 170) / 340;
+
+    return parcial + 3653;
+}
+
+void mpu6050_fifo_iniciar(mpu6050_fifo_t *f, uint32_t taxa_hz, uint64_t origem_us) {
+    f->taxa_hz = taxa_hz;
+    f->origem_us = origem_us;
+    f->quadros = 0;
+    f->parcial_bytes = 0;
+}
+
+uint64_t mpu6050_fifo_instante(const mpu6050_fifo_t *f, uint32_t n) {
+    return f->origem_us + (uint64_t)n * 1000000u / f->taxa_hz;
+}
+
+int32_t mpu6050_fifo_ancorar(mpu6050_fifo_t *f, uint64_t agora_us, uint32_t bytes_no_fifo) {
+    // O quadro partido já tem o começo no leitor e o resto ainda no FIFO
+    uint32_t no_fifo = (f->parcial_bytes + bytes_no_fifo) / MPU6050_QUADRO_BYTES;
+    uint32_t periodo = 1000000u / f->taxa_hz;
+    int64_t ajuste = 0;
+
+    if (no_fifo == 0) {
+        return 0;
+    }
+    uint64_t previsto = mpu6050_fifo_instante(f, f->quadros + no_fifo - 1);
+    if (previsto > agora_us) {
+        ajuste = -(int64_t)(previsto - agora_us);               // Sensor mais lento que o previsto
+    } else if (previsto + periodo < agora_us) {
+        ajuste = (int64_t)(agora_us - periodo - previsto);      // Sensor mais rápido
+    }
+    f->origem_us = (uint64_t)((int64_t)f->origem_us + ajuste);
+    return (int32_t)ajuste;
+}
+
+uint32_t mpu6050_fifo_decodificar(mpu6050_fifo_t *f, const uint8_t *bytes, uint32_t total,
+                                  mpu6050_entregar_t entregar, void *contexto) {
+    uint32_t entregues = 0;
+
+    while (total > 0) {
+        while (total > 0 && f->parcial_bytes < MPU6050_QUADRO_BYTES) {
+            f->parcial[f->parcial_bytes++] = *bytes++;
+            total--;
+        }
+        if (f->parcial_bytes < MPU6050_QUADRO_BYTES) {
+            break;              // O resto do quadro vem no próximo lote
+        }
+        f->parcial_bytes = 0;
+
+        mpu6050_amostra_t amostra;
+        for (int i = 0; i < 3; i++) {
+            amostra.acel[i] = palavra(&f->parcial[i * 2]);
+            amostra.giro[i] = palavra(&f->parcial[6 + i * 2]);
+        }
+        amostra.temperatura = MPU6050_SEM_TEMPERATURA;
+        amostra.instante_us = mpu6050_fifo_instante(f, f->quadros);
+        f->quadros++;
+        entregar(&amostra, contexto);
+        entregues++;
+    }
+    return entregues;
+}
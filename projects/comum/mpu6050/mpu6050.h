@@ -0,0 +1,107 @@
+// MPU-6050: registradores, configuração e decodificação das leituras
+// Uma leitura é uma rajada única de 14 bytes a partir de ACCEL_XOUT_H
+// (0x3B): aceleração, temperatura e giroscópio, em big-endian, no lugar das
+// duas transações de 6 bytes (0x3B e 0x43) que pulavam a temperatura
+// A taxa de amostras (ODR) sai do filtro passa-baixa (CONFIG) e do divisor
+// (SMPLRT_DIV): 8 kHz / (1 + divisor) com o filtro desligado (0 ou 7) e
+// 1 kHz / (1 + divisor) com ele ligado; o acelerômetro não passa de 1 kHz
+// No modo FIFO o sensor acumula quadros de 12 bytes (aceleração e
+// giroscópio, sem temperatura) no FIFO de 1024 bytes e o processador drena
+// lotes inteiros; os instantes são reconstruídos pela ODR a partir de uma
+// origem, que é realinhada ao relógio do RP2040 quando a deriva passa de
+// um período (mpu6050_fifo_ancorar)
+// Sem dependência de hardware: testado no host (host/mpu6050_teste.c)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#ifndef MPU6050_H
+#define MPU6050_H
+
+#include <stdint.h>
+
+#define MPU6050_ENDERECO            0x68    // AD0 em nível baixo
+#define MPU6050_ID                  0x68    // Resposta do WHO_AM_I
+
+// Registradores usados
+#define MPU6050_REG_SMPLRT_DIV      0x19
+#define MPU6050_REG_CONFIG          0x1A
+#define MPU6050_REG_GYRO_CONFIG     0x1B
+#define MPU6050_REG_ACCEL_CONFIG    0x1C
+#define MPU6050_REG_FIFO_EN         0x23
+#define MPU6050_REG_INT_PIN_CFG     0x37
+#define MPU6050_REG_INT_ENABLE      0x38
+#define MPU6050_REG_INT_STATUS      0x3A
+#define MPU6050_REG_ACCEL_XOUT_H    0x3B
+#define MPU6050_REG_USER_CTRL       0x6A
+#define MPU6050_REG_PWR_MGMT_1      0x6B
+#define MPU6050_REG_FIFO_COUNTH     0x72
+#define MPU6050_REG_FIFO_R_W        0x74
+#define MPU6050_REG_WHO_AM_I        0x75
+
+#define MPU6050_PWR_RESET           0x80
+#define MPU6050_PWR_CLOCK_GIRO_X    0x01    // PLL do giroscópio X, mais estável que o oscilador interno
+#define MPU6050_INT_RD_CLEAR        0x10    // Qualquer leitura limpa o INT_STATUS
+#define MPU6050_INT_DATA_RDY        0x01
+#define MPU6050_INT_FIFO_OFLOW      0x10
+#define MPU6050_FIFO_EN_GIRO_ACEL   0x78    // XG, YG, ZG e ACCEL no FIFO_EN
+#define MPU6050_USER_FIFO_EN        0x40
+#define MPU6050_USER_FIFO_RESET     0x04
+
+#define MPU6050_RAJADA_BYTES        14      // 0x3B..0x48
+#define MPU6050_FIFO_BYTES          1024
+#define MPU6050_QUADRO_BYTES        12      // Aceleração e giroscópio, na ordem dos registradores
+#define MPU6050_SEM_TEMPERATURA     INT16_MIN   // Amostras do FIFO
+
+typedef struct {
+    uint8_t dlpf;               // CONFIG: 0..6 (0 desliga o filtro; 3 = 44 Hz)
+    uint8_t divisor;            // SMPLRT_DIV: ODR = base / (1 + divisor)
+    uint8_t faixa_acel;         // ACCEL_CONFIG AFS_SEL: 0 = ±2 g .. 3 = ±16 g
+    uint8_t faixa_giro;         // GYRO_CONFIG FS_SEL: 0 = ±250 °/s .. 3 = ±2000 °/s
+} mpu6050_config_t;
+
+typedef struct {
+    uint64_t instante_us;       // Borda do data-ready (ou do temporizador)
+    int16_t acel[3];
+    int16_t temperatura;        // Bruto: °C = bruto / 340 + 36,53
+    int16_t giro[3];
+} mpu6050_amostra_t;
+
+// Amostras por segundo que a configuração produz
+uint32_t mpu6050_taxa_hz(const mpu6050_config_t *config);
+
+// Rajada de 14 bytes -> amostra (o instante fica com o chamador)
+void mpu6050_decodificar(const uint8_t *bruto, mpu6050_amostra_t *amostra);
+
+// Temperatura bruta -> centésimos de grau, arredondada
+int32_t mpu6050_temperatura_centi(int16_t bruto);
+
+// Leitor do FIFO: junta os bytes em quadros (um quadro pode vir partido
+// entre dois lotes) e dá a cada quadro o instante origem + n / ODR
+typedef struct {
+    uint32_t taxa_hz;
+    uint64_t origem_us;         // Instante do quadro 0
+    uint32_t quadros;           // Quadros entregues desde a origem
+    uint8_t parcial[MPU6050_QUADRO_BYTES];
+    uint8_t parcial_bytes;
+} mpu6050_fifo_t;
+
+typedef void (*mpu6050_entregar_t)(const mpu6050_amostra_t *amostra, void *contexto);
+
+// 'origem_us': instante do primeiro quadro (um período depois de ligar o FIFO)
+void mpu6050_fifo_iniciar(mpu6050_fifo_t *f, uint32_t taxa_hz, uint64_t origem_us);
+
+// Instante reconstruído do quadro 'n', sem acumular erro de arredondamento
+uint64_t mpu6050_fifo_instante(const mpu6050_fifo_t *f, uint32_t n);
+
+// Realinha a origem com uma leitura do FIFO_COUNT: no instante 'agora_us'
+// havia 'bytes_no_fifo' bytes, então o quadro mais novo foi amostrado no
+// último período antes de 'agora_us'. Se a previsão cair fora dessa janela
+// (relógio do sensor adiantado ou atrasado), a origem anda até encostar
+// nela; retorna o deslocamento em us (0 sem ajuste)
+int32_t mpu6050_fifo_ancorar(mpu6050_fifo_t *f, uint64_t agora_us, uint32_t bytes_no_fifo);
+
+// Decodifica 'total' bytes lidos do FIFO_R_W e entrega cada quadro
+// completo; retorna quantos quadros entregou
+uint32_t mpu6050_fifo_decodificar(mpu6050_fifo_t *f, const uint8_t *bytes, uint32_t total,
+                                  mpu6050_entregar_t entregar, void *contexto);
+
+#endif // MPU6050_H
@@ -0,0 +1,393 @@
+// MPU-6050 por data-ready e DMA (ver mpu6050_irq.h)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include "mpu6050_irq.h"
+
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+#define LOTE_MAX_BYTES  (MPU6050_LOTE_MAX_QUADROS * MPU6050_QUADRO_BYTES)
+#define LER             I2C_IC_DATA_CMD_CMD_BITS
+#define STOP            I2C_IC_DATA_CMD_STOP_BITS
+#define RESTART         I2C_IC_DATA_CMD_RESTART_BITS
+#define PALAVRAS(v)     (uint32_t)(sizeof(v) / sizeof((v)[0]))
+
+// Etapa da transferência em curso; só uma por vez no barramento
+typedef enum {
+    LIVRE,
+    RAJADA,                     // 14 bytes de 0x3B (data-ready)
+    CONTAGEM,                   // FIFO_COUNT
+    LOTE,                       // Quadros inteiros do FIFO_R_W
+    REINICIO,                   // Reset do FIFO seguido de FIFO_COUNT
+} etapa_t;
+
+static i2c_inst_t *barramento;
+static uint32_t taxa_hz;
+
+// Comandos para o DATA_CMD: escrita do registrador e leituras, a primeira
+// com RESTART e a última com STOP
+static uint32_t comandos_rajada[1 + MPU6050_RAJADA_BYTES];
+static const uint32_t comandos_contagem[] = { MPU6050_REG_FIFO_COUNTH, LER | RESTART, LER | STOP };
+// FIFO_RESET só vale com o FIFO desligado: desliga e zera, religa e conta
+static const uint32_t comandos_reinicio[] = {
+    MPU6050_REG_USER_CTRL, MPU6050_USER_FIFO_RESET | STOP,
+    MPU6050_REG_USER_CTRL, MPU6050_USER_FIFO_EN | STOP,
+    MPU6050_REG_FIFO_COUNTH, LER | RESTART, LER | STOP,
+};
+// O STOP do lote é posto na última leitura de cada lote e tirado no fim
+static uint32_t comandos_lote[1 + LOTE_MAX_BYTES];
+
+static uint8_t bruto[MPU6050_RAJADA_BYTES];
+static uint8_t contagem[2];
+static uint8_t lote[LOTE_MAX_BYTES];
+static uint canal_tx, canal_rx;
+
+// Disparo e fim das transferências rodam em interrupções de mesma
+// prioridade: uma não interrompe a outra, então o estado abaixo não
+// precisa de trava
+static etapa_t etapa = LIVRE;
+static uint32_t lote_bytes;
+static uint32_t fifo_bytes;
+static bool reiniciar_fifo;
+static uint64_t instante_rajada;
+static uint64_t instante_anterior;
+static mpu6050_fifo_t leitor;
+
+// Anel de amostras: 'cabeca' só é escrita pelas interrupções, 'cauda' só pelo laço
+static mpu6050_amostra_t anel[MPU6050_ANEL_AMOSTRAS];
+static volatile uint32_t cabeca;
+static volatile uint32_t cauda;
+
+static uint pino;
+static bool modo_fifo;
+static repeating_timer_t temporizador;
+static mpu6050_metricas_t metricas;
+
+static bool escrever(uint8_t registrador, uint8_t valor) {
+    uint8_t buf[2] = { registrador, valor };
+
+    return i2c_write_blocking(barramento, MPU6050_ENDERECO, buf, 2, false) == 2;
+}
+
+bool mpu6050_iniciar(i2c_inst_t *i2c, const mpu6050_config_t *config) {
+    uint8_t registrador = MPU6050_REG_WHO_AM_I;
+    uint8_t id = 0;
+
+    barramento = i2c;
+    taxa_hz = mpu6050_taxa_hz(config);
+
+    escrever(MPU6050_REG_PWR_MGMT_1, MPU6050_PWR_RESET);
+    sleep_ms(100);              // Estabilização após o reset
+    if (i2c_write_blocking(i2c, MPU6050_ENDERECO, &registrador, 1, true) != 1 ||
+        i2c_read_blocking(i2c, MPU6050_ENDERECO, &id, 1, false) != 1 || id != MPU6050_ID) {
+        return false;
+    }
+
+    escrever(MPU6050_REG_PWR_MGMT_1, MPU6050_PWR_CLOCK_GIRO_X);    // Sai do sleep
+    sleep_ms(10);
+    return escrever(MPU6050_REG_SMPLRT_DIV, config->divisor) &&
+           escrever(MPU6050_REG_CONFIG, config->dlpf & 0x07u) &&
+           escrever(MPU6050_REG_GYRO_CONFIG, (uint8_t)((config->faixa_giro & 0x03u) << 3)) &&
+           escrever(MPU6050_REG_ACCEL_CONFIG, (uint8_t)((config->faixa_acel & 0x03u) << 3)) &&
+           escrever(MPU6050_REG_INT_PIN_CFG, MPU6050_INT_RD_CLEAR) &&   // Ativo alto, pulso de 50 us
+           escrever(MPU6050_REG_INT_ENABLE, MPU6050_INT_DATA_RDY);
+}
+
+bool mpu6050_ler(mpu6050_amostra_t *amostra) {
+    uint8_t registrador = MPU6050_REG_ACCEL_XOUT_H;
+    uint8_t buf[MPU6050_RAJADA_BYTES];
+
+    amostra->instante_us = time_us_64();
+    // Escrita sem STOP + leitura com RESTART: uma transação só
+    if (i2c_write_blocking(barramento, MPU6050_ENDERECO, &registrador, 1, true) != 1 ||
+        i2c_read_blocking(barramento, MPU6050_ENDERECO, buf, sizeof(buf), false) != (int)sizeof(buf)) {
+        return false;
+    }
+    mpu6050_decodificar(buf, amostra);
+    return true;
+}
+
+// Grava a amostra no anel (chamada nas interrupções)
+static void entregar(const mpu6050_amostra_t *amostra, void *contexto) {
+    (void)contexto;
+    metricas.amostras++;
+
+    if (instante_anterior != 0 && amostra->instante_us > instante_anterior &&
+        amostra->instante_us - instante_anterior > metricas.intervalo_max_us) {
+        metricas.intervalo_max_us = (uint32_t)(amostra->instante_us - instante_anterior);
+    }
+    instante_anterior = amostra->instante_us;
+
+    uint32_t c = cabeca;
+    if (c - cauda == MPU6050_ANEL_AMOSTRAS) {
+        metricas.anel_cheio++;
+        return;
+    }
+    anel[c % MPU6050_ANEL_AMOSTRAS] = *amostra;
+    __dmb();                    // Amostra gravada antes de publicar a cabeça
+    cabeca = c + 1;
+}
+
+static void transferir(etapa_t proxima, const uint32_t *cmds, uint32_t total_cmds,
+                       uint8_t *destino, uint32_t total_bytes) {
+    etapa = proxima;
+    dma_channel_transfer_to_buffer_now(canal_rx, destino, total_bytes);
+    dma_channel_transfer_from_buffer_now(canal_tx, cmds, total_cmds);
+}
+
+// Cancela a transferência presa; o abort pode gerar a interrupção de fim do
+// canal (errata RP2040-E13), então ela fica desligada enquanto isso
+static void abortar(void) {
+    i2c_hw_t *hw = i2c_get_hw(barramento);
+
+    dma_channel_set_irq1_enabled(canal_rx, false);
+    dma_channel_abort(canal_tx);
+    dma_channel_abort(canal_rx);
+    dma_channel_acknowledge_irq1(canal_rx);
+    dma_channel_set_irq1_enabled(canal_rx, true);
+
+    (void)hw->clr_tx_abrt;
+    while (hw->rxflr) {
+        (void)hw->data_cmd;
+    }
+    if (etapa == LOTE) {
+        comandos_lote[lote_bytes] &= ~STOP;
+    }
+    etapa = LIVRE;
+}
+
+// Retorna true se o barramento pode receber outra transferência
+static bool barramento_livre(void) {
+    if (etapa == LIVRE) {
+        return true;
+    }
+    // Com NACK o I2C descarta os comandos e a recepção nunca termina
+    if (!(i2c_get_hw(barramento)->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)) {
+        metricas.ocupado++;
+        return false;
+    }
+    abortar();
+    metricas.erros++;
+    reiniciar_fifo = modo_fifo; // Não se sabe quanto do lote saiu do FIFO
+    return true;
+}
+
+static void disparar(uint64_t agora) {
+    if (!barramento_livre()) {
+        return;
+    }
+    if (!modo_fifo) {
+        instante_rajada = agora;
+        transferir(RAJADA, comandos_rajada, PALAVRAS(comandos_rajada), bruto, MPU6050_RAJADA_BYTES);
+    } else if (reiniciar_fifo) {
+        reiniciar_fifo = false;
+        metricas.estouros++;
+        transferir(REINICIO, comandos_reinicio, PALAVRAS(comandos_reinicio), contagem, 2);
+    } else {
+        transferir(CONTAGEM, comandos_contagem, PALAVRAS(comandos_contagem), contagem, 2);
+    }
+}
+
+// Fim de uma contagem do FIFO: lê os quadros inteiros que couberem no lote
+static void drenar(uint64_t agora) {
+    fifo_bytes = (uint32_t)contagem[0] << 8 | contagem[1];
+
+    // Cheio: o sensor sobrescreveu os mais antigos e o alinhamento dos
+    // quadros se perdeu
+    if (fifo_bytes > MPU6050_FIFO_BYTES - MPU6050_QUADRO_BYTES) {
+        reiniciar_fifo = true;
+        etapa = LIVRE;
+        disparar(agora);
+        return;
+    }
+
+    mpu6050_fifo_ancorar(&leitor, agora, fifo_bytes);
+    lote_bytes = fifo_bytes - fifo_bytes % MPU6050_QUADRO_BYTES;
+    if (lote_bytes > LOTE_MAX_BYTES) {
+        lote_bytes = LOTE_MAX_BYTES;
+    }
+    if (lote_bytes == 0) {
+        etapa = LIVRE;
+        return;
+    }
+    comandos_lote[lote_bytes] |= STOP;
+    transferir(LOTE, comandos_lote, 1 + lote_bytes, lote, lote_bytes);
+}
+
+static void tratar_dma(void) {
+    if (!dma_channel_get_irq1_status(canal_rx)) {
+        return;                 // Outro canal no mesmo DMA_IRQ_1
+    }
+    dma_channel_acknowledge_irq1(canal_rx);
+    uint64_t agora = time_us_64();
+
+    switch (etapa) {
+        case RAJADA: {
+            mpu6050_amostra_t amostra;
+            mpu6050_decodificar(bruto, &amostra);
+            amostra.instante_us = instante_rajada;
+            etapa = LIVRE;
+            entregar(&amostra, NULL);
+            break;
+        }
+        case REINICIO:
+            mpu6050_fifo_iniciar(&leitor, taxa_hz, agora);
+            instante_anterior = 0;  // A lacuna do estouro não conta como intervalo
+            drenar(agora);
+            break;
+        case CONTAGEM:
+            drenar(agora);
+            break;
+        case LOTE:
+            comandos_lote[lote_bytes] &= ~STOP;
+            etapa = LIVRE;
+            metricas.lotes++;
+            if (lote_bytes / MPU6050_QUADRO_BYTES > metricas.quadros_lote_max) {
+                metricas.quadros_lote_max = lote_bytes / MPU6050_QUADRO_BYTES;
+            }
+            mpu6050_fifo_decodificar(&leitor, lote, lote_bytes, entregar, NULL);
+            if (fifo_bytes - lote_bytes >= MPU6050_QUADRO_BYTES) {
+                disparar(agora);    // Sobrou mais que um lote
+            }
+            break;
+        case LIVRE:
+            break;
+    }
+}
+
+static void tratar_int(void) {
+    uint64_t agora = time_us_64();
+    uint32_t eventos = gpio_get_irq_event_mask(pino);
+
+    if (eventos & GPIO_IRQ_EDGE_RISE) {
+        gpio_acknowledge_irq(pino, eventos);
+        disparar(agora);
+    }
+}
+
+static bool tratar_temporizador(repeating_timer_t *t) {
+    (void)t;
+    disparar(time_us_64());
+    return true;
+}
+
+// Alvo fixo, pedidos de DMA e os dois canais: o barramento passa a ser do sensor
+static void preparar_dma(void) {
+    i2c_hw_t *hw = i2c_get_hw(barramento);
+
+    hw->enable = 0;
+    hw->tar = MPU6050_ENDERECO;
+    hw->enable = 1;
+    hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS | I2C_IC_DMA_CR_RDMAE_BITS;
+
+    comandos_rajada[0] = MPU6050_REG_ACCEL_XOUT_H;
+    comandos_lote[0] = MPU6050_REG_FIFO_R_W;
+    for (uint32_t i = 1; i < PALAVRAS(comandos_rajada); i++) {
+        comandos_rajada[i] = LER;
+    }
+    for (uint32_t i = 1; i < PALAVRAS(comandos_lote); i++) {
+        comandos_lote[i] = LER;
+    }
+    comandos_rajada[1] |= RESTART;
+    comandos_rajada[MPU6050_RAJADA_BYTES] |= STOP;
+    comandos_lote[1] |= RESTART;
+
+    canal_tx = (uint)dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(canal_tx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(barramento, true));
+    dma_channel_configure(canal_tx, &c, &hw->data_cmd, comandos_rajada, 0, false);
+
+    canal_rx = (uint)dma_claim_unused_channel(true);
+    c = dma_channel_get_default_config(canal_rx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, i2c_get_dreq(barramento, false));
+    dma_channel_configure(canal_rx, &c, bruto, &hw->data_cmd, 0, false);
+
+    dma_channel_set_irq1_enabled(canal_rx, true);
+    irq_add_shared_handler(DMA_IRQ_1, tratar_dma, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+}
+
+static void ligar_int(uint pino_int) {
+    pino = pino_int;
+    gpio_init(pino);
+    gpio_set_dir(pino, GPIO_IN);
+    gpio_pull_down(pino);       // Fio solto não gera bordas
+    gpio_add_raw_irq_handler_masked(1u << pino, tratar_int);
+    gpio_acknowledge_irq(pino, GPIO_IRQ_EDGE_RISE);
+    gpio_set_irq_enabled(pino, GPIO_IRQ_EDGE_RISE, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+}
+
+bool mpu6050_iniciar_irq(uint pino_int) {
+    // De novo: uma mpu6050_iniciar_fifo que falhou pode ter deixado só o
+    // estouro do FIFO no INT
+    escrever(MPU6050_REG_INT_ENABLE, MPU6050_INT_DATA_RDY);
+    preparar_dma();
+
+    if (pino_int != MPU6050_SEM_INT) {
+        ligar_int(pino_int);
+
+        // Três períodos para a primeira rajada completa
+        sleep_us(3u * 1000000u / taxa_hz + 2000u);
+        if (metricas.amostras > 0) {
+            return true;
+        }
+        gpio_set_irq_enabled(pino, GPIO_IRQ_EDGE_RISE, false);
+        gpio_remove_raw_irq_handler_masked(1u << pino, tratar_int);
+    }
+    add_repeating_timer_us(-(int64_t)(1000000u / taxa_hz), tratar_temporizador, NULL, &temporizador);
+    return false;
+}
+
+bool mpu6050_iniciar_fifo(uint pino_int, uint32_t periodo_lote_us) {
+    // Ainda bloqueante: só aceleração e giroscópio no FIFO, INT no estouro
+    bool ok = escrever(MPU6050_REG_FIFO_EN, MPU6050_FIFO_EN_GIRO_ACEL) &&
+              escrever(MPU6050_REG_INT_ENABLE, MPU6050_INT_FIFO_OFLOW) &&
+              escrever(MPU6050_REG_USER_CTRL, MPU6050_USER_FIFO_RESET) &&
+              escrever(MPU6050_REG_USER_CTRL, MPU6050_USER_FIFO_EN);
+    if (!ok) {
+        // As escritas anteriores à falha ficaram no sensor: volta à
+        // configuração do data-ready (melhor esforço, o barramento falhou)
+        escrever(MPU6050_REG_USER_CTRL, 0);
+        escrever(MPU6050_REG_FIFO_EN, 0);
+        escrever(MPU6050_REG_INT_ENABLE, MPU6050_INT_DATA_RDY);
+        return false;
+    }
+    // O primeiro quadro entra um período depois de ligar
+    mpu6050_fifo_iniciar(&leitor, taxa_hz, time_us_64() + 1000000u / taxa_hz);
+
+    modo_fifo = true;
+    preparar_dma();
+    if (pino_int != MPU6050_SEM_INT) {
+        ligar_int(pino_int);    // Estouro: drena na hora, sem esperar o temporizador
+    }
+    add_repeating_timer_us(-(int64_t)periodo_lote_us, tratar_temporizador, NULL, &temporizador);
+    return true;
+}
+
+bool mpu6050_proxima(mpu6050_amostra_t *amostra) {
+    uint32_t t = cauda;
+
+    if (t == cabeca) {
+        return false;
+    }
+    *amostra = anel[t % MPU6050_ANEL_AMOSTRAS];
+    __dmb();                    // Amostra lida antes de liberar a posição
+    cauda = t + 1;
+    return true;
+}
+
+void mpu6050_metricas(mpu6050_metricas_t *m) {
+    uint32_t estado = save_and_disable_interrupts();
+    *m = metricas;
+    restore_interrupts(estado);
+}
@@ -0,0 +1,75 @@
+// MPU-6050 por interrupção de data-ready e I2C por DMA
+// A borda do pino INT marca o instante (time_us_64) e dispara a rajada de
+// 14 bytes sem o processador: um canal de DMA empurra os comandos no
+// DATA_CMD do I2C (endereço do registrador + 14 leituras, a última com
+// STOP) e outro recolhe os bytes; o fim da recepção decodifica a amostra num
+// anel de produtor único (as interrupções) e consumidor único (o laço)
+// Com a taxa fixa do sensor os instantes saem a cada período, sem o atraso
+// do laço; a 400 kHz a rajada leva ~0,45 ms, então cabe até ~2 kHz
+// Sem o fio do INT (ou se nenhuma borda chegar) as rajadas saem de um
+// temporizador no período da ODR; o instante é o do temporizador
+// No modo FIFO (mpu6050_iniciar_fifo) o sensor guarda os quadros e um
+// temporizador drena em lotes: lê o FIFO_COUNT e depois só os quadros
+// inteiros do FIFO_R_W, tudo por DMA; o sensor não tem interrupção de nível
+// do FIFO, então o INT avisa só o estouro, que drena na hora. Se o FIFO
+// encher mesmo assim, ele é zerado e os instantes recomeçam
+// Depois de mpu6050_iniciar_irq ou _fifo o barramento é do DMA: nada de
+// leituras bloqueantes ou outros dispositivos no mesmo I2C
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#ifndef MPU6050_IRQ_H
+#define MPU6050_IRQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/i2c.h"
+#include "mpu6050.h"
+
+// Amostras guardadas entre duas leituras do laço (potência de 2)
+#define MPU6050_ANEL_AMOSTRAS   64
+
+// Quadros por lote do FIFO; 42 * 12 = 504 bytes, ~11 ms a 400 kHz
+#define MPU6050_LOTE_MAX_QUADROS    42
+
+// Período padrão entre lotes: 20 quadros a 1 kHz, longe dos 85 do FIFO
+#define MPU6050_PERIODO_LOTE_US     20000u
+
+// pino_int sem fio: rajadas pelo temporizador
+#define MPU6050_SEM_INT         0xFFu
+
+typedef struct {
+    uint32_t amostras;          // Amostras entregues ao anel
+    uint32_t ocupado;           // Disparo com a transferência anterior em curso
+    uint32_t anel_cheio;        // Amostra descartada: o laço não leu a tempo
+    uint32_t erros;             // Rajada abortada pelo I2C (NACK)
+    uint32_t intervalo_max_us;  // Maior intervalo entre dois instantes
+    uint32_t lotes;             // Lotes drenados do FIFO
+    uint32_t quadros_lote_max;  // Maior lote, em quadros
+    uint32_t estouros;          // FIFO zerado (cheio ou lote abortado)
+} mpu6050_metricas_t;
+
+// Reinicia o sensor e grava a configuração; o I2C já deve estar iniciado
+// Retorna false se o WHO_AM_I não responder MPU6050_ID
+bool mpu6050_iniciar(i2c_inst_t *i2c, const mpu6050_config_t *config);
+
+// Rajada bloqueante de 14 bytes numa transação só (antes de mpu6050_iniciar_irq)
+bool mpu6050_ler(mpu6050_amostra_t *amostra);
+
+// Passa a ler por data-ready e DMA; retorna true se as bordas do INT
+// chegaram e false se caiu no temporizador
+bool mpu6050_iniciar_irq(uint pino_int);
+
+// Passa a drenar o FIFO a cada 'periodo_lote_us' (sem temperatura nas
+// amostras); o INT, se ligado, antecipa o lote no estouro. Retorna false,
+// sem ligar DMA, INT nem temporizador, se a configuração do FIFO não foi
+// aceita; o sensor volta ao data-ready sem FIFO e mpu6050_iniciar_irq
+// (que reescreve o INT_ENABLE) ainda pode ser chamada depois
+bool mpu6050_iniciar_fifo(uint pino_int, uint32_t periodo_lote_us);
+
+// Próxima amostra do anel, da mais antiga para a mais nova
+bool mpu6050_proxima(mpu6050_amostra_t *amostra);
+
+// Cópia das métricas acumuladas
+void mpu6050_metricas(mpu6050_metricas_t *metricas);
+
+#endif // MPU6050_IRQ_H
@@ -0,0 +1,388 @@
+// Série temporal compacta em páginas (ver serie.h)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include "serie.h"
+
+#include <string.h>
+
+// Pior caso de uma amostra codificada: varint de 32 bits (5 bytes) no
+// instante e em cada canal
+#define MAX_BYTES_AMOSTRA(canais)   (5u * (1u + (canais)))
+
+// Campos do cabeçalho
+#define CAB_MARCA       0
+#define CAB_SEQUENCIA   4
+#define CAB_INICIO      8
+#define CAB_FIM         12
+#define CAB_AMOSTRAS    16
+#define CAB_BYTES       18
+#define CAB_CANAIS      20
+#define CAB_SESSAO      22
+
+static void escrever_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void escrever_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t ler_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t ler_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Zigzag: 0, -1, 1, -2... -> 0, 1, 2, 3...; os deltas são calculados em
+// uint32_t, então um salto de INT32_MIN a INT32_MAX volta igual
+static uint32_t zigzag(uint32_t v) {
+    return (v << 1) ^ (uint32_t)-(int32_t)(v >> 31);
+}
+
+static uint32_t dezigzag(uint32_t z) {
+    return (z >> 1) ^ (uint32_t)-(int32_t)(z & 1u);
+}
+
+static uint16_t escrever_varint(uint8_t *p, uint32_t v) {
+    uint16_t n = 0;
+
+    while (v >= 0x80u) {
+        p[n++] = (uint8_t)(v | 0x80u);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static bool ler_varint(const uint8_t *p, uint16_t *pos, uint16_t fim, uint32_t *v) {
+    uint32_t r = 0;
+
+    for (uint32_t desloc = 0; desloc < 35; desloc += 7) {
+        if (*pos >= fim) {
+            return false;
+        }
+        uint8_t b = p[(*pos)++];
+        r |= (uint32_t)(b & 0x7Fu) << desloc;
+        if ((b & 0x80u) == 0) {
+            *v = r;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint8_t *pagina_aberta(serie_t *s) {
+    return s->ram[(s->ram_inicio + s->ram_total - 1) % SERIE_PAGINAS_RAM];
+}
+
+static const uint8_t *pagina_ram(const serie_t *s, uint32_t k) {
+    return s->ram[(s->ram_inicio + k) % SERIE_PAGINAS_RAM];
+}
+
+void serie_iniciar(serie_t *s, uint8_t canais, const serie_meio_t *meio) {
+    memset(s, 0, sizeof(*s));
+    s->canais = canais > SERIE_CANAIS_MAX ? SERIE_CANAIS_MAX : canais;
+    s->meio = meio;
+    if (meio == NULL) {
+        return;
+    }
+
+    // Continua depois da página de maior sequência
+    bool achou = false;
+    serie_pagina_info_t ultima = { 0 };
+    for (uint32_t i = 0; i < meio->paginas; i++) {
+        serie_pagina_info_t info;
+        if (!serie_pagina_info(meio->ler(meio->contexto, i), &info)) {
+            continue;
+        }
+        s->meio_total++;
+        if (!achou || (int32_t)(info.sequencia - s->proxima_sequencia) >= 0) {
+            achou = true;
+            ultima = info;
+            s->proxima_sequencia = info.sequencia + 1;
+            s->meio_proxima = (i + 1) % meio->paginas;
+        }
+    }
+    if (achou) {
+        // Nova sessão, com os instantes depois dos da anterior
+        s->sessao = (uint16_t)(ultima.sessao + 1u);
+        s->base_ms = ultima.fim_ms + 1u;
+    }
+}
+
+static void abrir_pagina(serie_t *s, uint32_t instante_ms, const int32_t *valores) {
+    if (s->ram_total == SERIE_PAGINAS_RAM) {
+        // Nenhum espaço: a selada mais antiga não chegou ao meio
+        s->ram_inicio = (s->ram_inicio + 1) % SERIE_PAGINAS_RAM;
+        s->ram_total--;
+        s->metricas.paginas_perdidas++;
+    }
+    s->ram_total++;
+    s->aberta = true;
+
+    uint8_t *p = pagina_aberta(s);
+    memset(p, 0xFF, SERIE_PAGINA_BYTES);
+    escrever_u32(p + CAB_MARCA, SERIE_MARCA);
+    escrever_u32(p + CAB_SEQUENCIA, s->proxima_sequencia++);
+    escrever_u32(p + CAB_INICIO, instante_ms);
+    p[CAB_CANAIS] = s->canais;
+    p[CAB_CANAIS + 1] = 0;
+    escrever_u16(p + CAB_SESSAO, s->sessao);
+
+    s->usados = SERIE_CABECALHO_BYTES;
+    for (uint8_t k = 0; k < s->canais; k++) {
+        escrever_u32(p + s->usados, (uint32_t)valores[k]);
+        s->usados += 4;
+        s->valores_anteriores[k] = valores[k];
+    }
+    s->amostras = 1;
+    s->instante_anterior = instante_ms;
+    s->delta_anterior = 0;
+}
+
+void serie_acrescentar(serie_t *s, uint32_t instante_ms, const int32_t *valores) {
+    instante_ms += s->base_ms;
+    if (s->aberta && s->usados + MAX_BYTES_AMOSTRA(s->canais) > SERIE_PAGINA_BYTES) {
+        serie_selar(s);
+    }
+
+    if (!s->aberta) {
+        abrir_pagina(s, instante_ms, valores);
+    } else {
+        uint8_t *p = pagina_aberta(s);
+        int32_t delta = (int32_t)(instante_ms - s->instante_anterior);
+
+        s->usados += escrever_varint(p + s->usados, zigzag((uint32_t)delta - (uint32_t)s->delta_anterior));
+        for (uint8_t k = 0; k < s->canais; k++) {
+            uint32_t d = (uint32_t)valores[k] - (uint32_t)s->valores_anteriores[k];
+            s->usados += escrever_varint(p + s->usados, zigzag(d));
+            s->valores_anteriores[k] = valores[k];
+        }
+        s->amostras++;
+        s->instante_anterior = instante_ms;
+        s->delta_anterior = delta;
+    }
+
+    // Cabeçalho sempre em dia: a página aberta se lê como as seladas
+    uint8_t *p = pagina_aberta(s);
+    escrever_u32(p + CAB_FIM, instante_ms);
+    escrever_u16(p + CAB_AMOSTRAS, s->amostras);
+    escrever_u16(p + CAB_BYTES, s->usados);
+    s->metricas.amostras++;
+}
+
+void serie_selar(serie_t *s) {
+    if (!s->aberta) {
+        return;
+    }
+    s->aberta = false;
+    s->metricas.paginas_seladas++;
+}
+
+bool serie_descarregar(serie_t *s) {
+    if (s->meio == NULL || s->ram_total == (s->aberta ? 1u : 0u)) {
+        return false;
+    }
+    if (!s->meio->gravar(s->meio->contexto, s->meio_proxima, s->ram[s->ram_inicio])) {
+        s->metricas.falhas_gravacao++;
+        return false;
+    }
+    s->meio_proxima = (s->meio_proxima + 1) % s->meio->paginas;
+    if (s->meio_total < s->meio->paginas) {
+        s->meio_total++;
+    }
+    s->ram_inicio = (s->ram_inicio + 1) % SERIE_PAGINAS_RAM;
+    s->ram_total--;
+    s->metricas.paginas_gravadas++;
+    return true;
+}
+
+bool serie_pagina_info(const uint8_t *pagina, serie_pagina_info_t *info) {
+    if (pagina == NULL || ler_u32(pagina + CAB_MARCA) != SERIE_MARCA) {
+        return false;
+    }
+    info->sequencia = ler_u32(pagina + CAB_SEQUENCIA);
+    info->inicio_ms = ler_u32(pagina + CAB_INICIO);
+    info->fim_ms = ler_u32(pagina + CAB_FIM);
+    info->amostras = ler_u16(pagina + CAB_AMOSTRAS);
+    info->bytes = ler_u16(pagina + CAB_BYTES);
+    info->canais = pagina[CAB_CANAIS];
+    info->sessao = ler_u16(pagina + CAB_SESSAO);
+
+    return info->canais >= 1 && info->canais <= SERIE_CANAIS_MAX && info->amostras >= 1 &&
+           info->bytes >= SERIE_CABECALHO_BYTES + 4u * info->canais &&
+           info->bytes <= SERIE_PAGINA_BYTES;
+}
+
+bool serie_leitor_iniciar(serie_leitor_t *l, const uint8_t *pagina) {
+    serie_pagina_info_t info;
+
+    if (!serie_pagina_info(pagina, &info)) {
+        return false;
+    }
+    memset(l, 0, sizeof(*l));
+    l->pagina = pagina;
+    l->bytes = info.bytes;
+    l->total = info.amostras;
+    l->canais = info.canais;
+    l->instante = info.inicio_ms;
+    l->pos = SERIE_CABECALHO_BYTES;
+    for (uint8_t k = 0; k < l->canais; k++) {
+        l->valores[k] = (int32_t)ler_u32(pagina + l->pos);
+        l->pos += 4;
+    }
+    return true;
+}
+
+bool serie_leitor_proxima(serie_leitor_t *l, serie_amostra_t *a) {
+    if (l->lidas == l->total) {
+        return false;
+    }
+    if (l->lidas > 0) {
+        uint32_t z;
+        if (!ler_varint(l->pagina, &l->pos, l->bytes, &z)) {
+            l->total = l->lidas;        // Página truncada: para aqui
+            return false;
+        }
+        l->delta = (int32_t)((uint32_t)l->delta + dezigzag(z));
+        l->instante += (uint32_t)l->delta;
+        for (uint8_t k = 0; k < l->canais; k++) {
+            if (!ler_varint(l->pagina, &l->pos, l->bytes, &z)) {
+                l->total = l->lidas;
+                return false;
+            }
+            l->valores[k] = (int32_t)((uint32_t)l->valores[k] + dezigzag(z));
+        }
+    }
+    l->lidas++;
+    a->instante_ms = l->instante;
+    memcpy(a->valores, l->valores, sizeof(l->valores[0]) * l->canais);
+    return true;
+}
+
+void serie_consulta_iniciar(serie_consulta_t *c, const serie_t *s, uint32_t inicio_ms,
+                            uint32_t fim_ms, uint32_t passo_ms) {
+    memset(c, 0, sizeof(*c));
+    c->s = s;
+    c->inicio_ms = inicio_ms;
+    c->fim_ms = fim_ms;
+    c->passo_ms = passo_ms;
+}
+
+// Próxima página em ordem de sequência, no meio ou na RAM: a chave é a
+// sequência menos proxima_sequencia (módulo 2^32), que cresce da página mais
+// antiga para a mais nova mesmo depois da volta da sequência. Procura a de
+// menor chave acima da última lida; NULL no fim. Percorre todos os
+// cabeçalhos a cada página (64 páginas de flash: ~4 mil leituras por consulta)
+static const uint8_t *proxima_pagina(serie_consulta_t *c, serie_pagina_info_t *info) {
+    const serie_t *s = c->s;
+    uint32_t no_meio = s->meio ? s->meio->paginas : 0;
+    const uint8_t *melhor = NULL;
+    uint32_t melhor_chave = 0;
+
+    for (uint32_t k = 0; k < no_meio + s->ram_total; k++) {
+        const uint8_t *p = k < no_meio ? s->meio->ler(s->meio->contexto, k) : pagina_ram(s, k - no_meio);
+        serie_pagina_info_t candidata;
+        if (!serie_pagina_info(p, &candidata)) {
+            continue;
+        }
+        uint32_t chave = candidata.sequencia - s->proxima_sequencia;
+        if ((!c->comecou || chave > c->chave) && (melhor == NULL || chave < melhor_chave)) {
+            melhor = p;
+            melhor_chave = chave;
+            *info = candidata;
+        }
+    }
+    if (melhor != NULL) {
+        c->comecou = true;
+        c->chave = melhor_chave;
+    }
+    return melhor;
+}
+
+// Próxima amostra bruta dentro de [inicio_ms, fim_ms]
+static bool proxima_no_intervalo(serie_consulta_t *c, serie_amostra_t *a, uint8_t *canais) {
+    for (;;) {
+        if (c->lendo) {
+            while (serie_leitor_proxima(&c->leitor, a)) {
+                if (a->instante_ms >= c->inicio_ms && a->instante_ms <= c->fim_ms) {
+                    *canais = c->leitor.canais;
+                    return true;
+                }
+            }
+            c->lendo = false;
+        }
+
+        serie_pagina_info_t info;
+        const uint8_t *p = proxima_pagina(c, &info);
+        if (p == NULL) {
+            return false;
+        }
+        if (info.fim_ms < c->inicio_ms || info.inicio_ms > c->fim_ms) {
+            continue;
+        }
+        c->lendo = serie_leitor_iniciar(&c->leitor, p);
+    }
+}
+
+// Média arredondada para o mais próximo, também abaixo de zero
+static void fechar_intervalo(serie_consulta_t *c, serie_amostra_t *a, uint8_t *canais) {
+    int64_t n = c->no_intervalo;
+
+    a->instante_ms = c->intervalo_ms;
+    for (uint8_t k = 0; k < c->canais; k++) {
+        a->valores[k] = (int32_t)((c->soma[k] + (c->soma[k] < 0 ? -n / 2 : n / 2)) / n);
+    }
+    *canais = c->canais;
+}
+
+static void abrir_intervalo(serie_consulta_t *c, const serie_amostra_t *a, uint8_t canais,
+                            uint32_t intervalo_ms) {
+    c->intervalo_ms = intervalo_ms;
+    c->canais = canais;
+    c->no_intervalo = 1;
+    for (uint8_t k = 0; k < canais; k++) {
+        c->soma[k] = a->valores[k];
+    }
+}
+
+bool serie_consulta_proxima(serie_consulta_t *c, serie_amostra_t *a, uint8_t *canais) {
+    uint8_t total_canais, n;
+    serie_amostra_t amostra;
+
+    if (canais == NULL) {
+        canais = &total_canais;
+    }
+    if (c->passo_ms == 0) {
+        return proxima_no_intervalo(c, a, canais);
+    }
+
+    while (proxima_no_intervalo(c, &amostra, &n)) {
+        uint32_t intervalo = c->inicio_ms + (amostra.instante_ms - c->inicio_ms) / c->passo_ms * c->passo_ms;
+
+        if (c->no_intervalo == 0) {
+            abrir_intervalo(c, &amostra, n, intervalo);
+        } else if (intervalo != c->intervalo_ms || n != c->canais) {
+            fechar_intervalo(c, a, canais);
+            abrir_intervalo(c, &amostra, n, intervalo);
+            return true;
+        } else {
+            for (uint8_t k = 0; k < n; k++) {
+                c->soma[k] += amostra.valores[k];
+            }
+            c->no_intervalo++;
+        }
+    }
+    if (c->no_intervalo == 0) {
+        return false;
+    }
+    fechar_intervalo(c, a, canais);
+    c->no_intervalo = 0;
+    return true;
+}
@@ -0,0 +1,162 @@
+// Série temporal compacta para leituras de sensores
+// Cada amostra é um instante em ms e até SERIE_CANAIS_MAX valores inteiros
+// (centésimos de grau, eixos crus do IMU, ...). As amostras são codificadas em
+// páginas de SERIE_PAGINA_BYTES, o tamanho do setor da flash:
+// - instante: delta-do-delta em zigzag + varint; a taxa fixa vira 1 byte
+// - valores: delta em relação à amostra anterior do mesmo canal, também em
+//   zigzag + varint; um sinal lento ocupa 1 byte por canal
+// Os valores são inteiros, então o XOR de floats do Gorilla não se aplica; o
+// delta inteiro em varint dá o mesmo ganho sem empacotar bits
+// Cada página começa com um cabeçalho com a primeira amostra em valor
+// absoluto e se decodifica sozinha: uma página corrompida ou sobrescrita não
+// afeta as outras
+// As páginas ficam num anel em RAM (a aberta e as seladas esperando) e são
+// descarregadas num meio de páginas (serie_meio_t: a flash no Pico, memória
+// ou arquivo no host), também em anel, com número de sequência para achar a
+// ordem depois de um reset. Sem meio, o anel em RAM é o próprio registro
+// Os instantes gravados são os do chamador somados a uma base da sessão: com
+// meio, cada serie_iniciar (um boot) continua depois do último instante já
+// gravado, então o relógio do chamador pode recomeçar do zero a cada reset e
+// a série segue crescendo; o tempo desligado não conta. Cada página guarda o
+// número da sessão. Sem tratamento da volta dos 32 bits (~49 dias somando as
+// sessões)
+// Sem dependência de hardware: testado no host (host/serie_teste.c)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#ifndef SERIE_H
+#define SERIE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SERIE_PAGINA_BYTES      4096    // Um setor da flash (menor apagamento)
+#define SERIE_CANAIS_MAX        8
+#define SERIE_PAGINAS_RAM       2       // A aberta + seladas esperando o meio
+
+// Cabeçalho da página (little-endian): marca, sequência, primeiro e último
+// instante, amostras, bytes usados, canais e sessão; em seguida vêm os
+// valores da primeira amostra (4 bytes por canal) e as demais amostras
+// codificadas
+#define SERIE_MARCA             0x31545253u     // "SRT1"
+#define SERIE_CABECALHO_BYTES   24
+
+typedef struct {
+    uint32_t instante_ms;
+    int32_t valores[SERIE_CANAIS_MAX];
+} serie_amostra_t;
+
+// Meio para as páginas seladas: 'ler' devolve a página mapeada (ou NULL) e
+// 'gravar' apaga e grava uma página inteira
+typedef struct {
+    uint32_t paginas;
+    const uint8_t *(*ler)(void *contexto, uint32_t indice);
+    bool (*gravar)(void *contexto, uint32_t indice, const uint8_t *pagina);
+    void *contexto;
+} serie_meio_t;
+
+typedef struct {
+    uint32_t sequencia;
+    uint32_t inicio_ms;
+    uint32_t fim_ms;
+    uint16_t amostras;
+    uint8_t canais;
+    uint16_t bytes;             // Cabeçalho + dados
+    uint16_t sessao;            // serie_iniciar que gravou a página
+} serie_pagina_info_t;
+
+typedef struct {
+    uint32_t amostras;          // Amostras aceitas
+    uint32_t paginas_seladas;
+    uint32_t paginas_gravadas;  // Descarregadas no meio
+    uint32_t paginas_perdidas;  // Anel em RAM cheio: a mais antiga foi descartada
+    uint32_t falhas_gravacao;
+} serie_metricas_t;
+
+typedef struct {
+    uint8_t ram[SERIE_PAGINAS_RAM][SERIE_PAGINA_BYTES];
+    uint32_t ram_inicio;        // Página mais antiga do anel em RAM
+    uint32_t ram_total;         // Páginas em RAM; a última é a aberta
+    uint8_t canais;
+    bool aberta;                // A última página em RAM recebe amostras
+
+    // Estado do codificador da página aberta
+    uint16_t usados;
+    uint16_t amostras;
+    uint32_t instante_anterior;
+    int32_t delta_anterior;
+    int32_t valores_anteriores[SERIE_CANAIS_MAX];
+
+    uint32_t proxima_sequencia;
+    uint16_t sessao;
+    uint32_t base_ms;           // Somada aos instantes do chamador
+    const serie_meio_t *meio;
+    uint32_t meio_proxima;      // Próxima página do meio a gravar
+    uint32_t meio_total;        // Páginas válidas no meio
+
+    serie_metricas_t metricas;
+} serie_t;
+
+// Prepara a série com 'canais' valores por amostra; 'meio' pode ser NULL
+// Com meio, as páginas válidas já gravadas são mantidas e a série continua
+// depois da de maior sequência: nova sessão e base_ms logo depois do último
+// instante dela
+void serie_iniciar(serie_t *s, uint8_t canais, const serie_meio_t *meio);
+
+// Acrescenta uma amostra (instante do chamador não decrescente, gravado como
+// base_ms + instante_ms); sela a página aberta quando a próxima amostra pode
+// não caber
+void serie_acrescentar(serie_t *s, uint32_t instante_ms, const int32_t *valores);
+
+// Sela a página aberta, se tiver amostras (antes de um reset, por exemplo)
+void serie_selar(serie_t *s);
+
+// Grava no meio a página selada mais antiga que está em RAM; retorna false
+// se não havia nada a gravar. Chamar do laço: apagar um setor da flash leva
+// dezenas de ms
+bool serie_descarregar(serie_t *s);
+
+// Lê o cabeçalho; false se a página não é da série (apagada ou corrompida)
+bool serie_pagina_info(const uint8_t *pagina, serie_pagina_info_t *info);
+
+// Leitor das amostras de uma página
+typedef struct {
+    const uint8_t *pagina;
+    uint16_t pos;
+    uint16_t bytes;
+    uint16_t lidas;
+    uint16_t total;
+    uint8_t canais;
+    uint32_t instante;
+    int32_t delta;
+    int32_t valores[SERIE_CANAIS_MAX];
+} serie_leitor_t;
+
+bool serie_leitor_iniciar(serie_leitor_t *l, const uint8_t *pagina);
+bool serie_leitor_proxima(serie_leitor_t *l, serie_amostra_t *a);
+
+// Consulta das amostras com instante gravado em [inicio_ms, fim_ms], da mais
+// antiga à mais nova: as páginas (meio e RAM) em ordem de sequência e, em
+// cada página, na ordem dos instantes. Com 'passo_ms' > 0 devolve a
+// média de cada intervalo de passo_ms (alinhado em inicio_ms) que tiver
+// amostras, com o instante do início do intervalo
+// Não acrescentar amostras durante uma consulta
+typedef struct {
+    const serie_t *s;
+    uint32_t inicio_ms, fim_ms, passo_ms;
+    uint32_t chave;             // Ordem da última página lida (ver serie.c)
+    bool comecou;
+    bool lendo;
+    serie_leitor_t leitor;
+    uint8_t canais;             // Canais das amostras do intervalo em andamento
+    uint32_t intervalo_ms;
+    uint32_t no_intervalo;
+    int64_t soma[SERIE_CANAIS_MAX];
+} serie_consulta_t;
+
+void serie_consulta_iniciar(serie_consulta_t *c, const serie_t *s, uint32_t inicio_ms,
+                            uint32_t fim_ms, uint32_t passo_ms);
+
+// Próxima amostra; 'canais' recebe quantos valores ela tem (pode ser NULL)
+bool serie_consulta_proxima(serie_consulta_t *c, serie_amostra_t *a, uint8_t *canais);
+
+#endif // SERIE_H
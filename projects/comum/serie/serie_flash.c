@@ -0,0 +1,65 @@
+// Meio da série na flash (ver serie_flash.h)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include "serie_flash.h"
+
+#include <assert.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+
+#define AREA_INICIO     (PICO_FLASH_SIZE_BYTES - SERIE_FLASH_BYTES)
+#define ESPERA_MS       100     // Para o outro núcleo entrar no bloqueio
+
+static_assert(SERIE_FLASH_BYTES % FLASH_SECTOR_SIZE == 0 && SERIE_FLASH_BYTES < PICO_FLASH_SIZE_BYTES,
+              "SERIE_FLASH_BYTES: setores inteiros e menor que a flash");
+
+extern char __flash_binary_end;     // Fim do programa na flash (memmap do SDK)
+
+typedef struct {
+    uint32_t deslocamento;
+    const uint8_t *pagina;      // NULL: só apaga
+    uint32_t tamanho;
+} operacao_t;
+
+// Roda sem nada executando da flash: interrupções deste núcleo desligadas e
+// o outro núcleo bloqueado (ou parado)
+static void executar(void *parametro) {
+    const operacao_t *op = parametro;
+
+    flash_range_erase(op->deslocamento, op->tamanho);
+    if (op->pagina != NULL) {
+        flash_range_program(op->deslocamento, op->pagina, op->tamanho);
+    }
+}
+
+static const uint8_t *ler(void *contexto, uint32_t indice) {
+    (void)contexto;
+    return (const uint8_t *)(XIP_BASE + AREA_INICIO + indice * SERIE_PAGINA_BYTES);
+}
+
+static bool gravar(void *contexto, uint32_t indice, const uint8_t *pagina) {
+    // A página de origem está em RAM
+    operacao_t op = { AREA_INICIO + indice * SERIE_PAGINA_BYTES, pagina, SERIE_PAGINA_BYTES };
+    (void)contexto;
+
+    return flash_safe_execute(executar, &op, ESPERA_MS) == PICO_OK;
+}
+
+void serie_flash_meio(serie_meio_t *meio) {
+    if ((uintptr_t)&__flash_binary_end > XIP_BASE + AREA_INICIO) {
+        panic("serie_flash: o programa invade os ultimos %u bytes da flash", SERIE_FLASH_BYTES);
+    }
+    *meio = (serie_meio_t){
+        .paginas = SERIE_FLASH_BYTES / SERIE_PAGINA_BYTES,
+        .ler = ler,
+        .gravar = gravar,
+        .contexto = NULL,
+    };
+}
+
+bool serie_flash_apagar(void) {
+    operacao_t op = { AREA_INICIO, NULL, SERIE_FLASH_BYTES };
+
+    return flash_safe_execute(executar, &op, ESPERA_MS) == PICO_OK;
+}
@@ -0,0 +1,33 @@
+// Meio da série temporal na flash do RP2040
+// Reserva os últimos SERIE_FLASH_BYTES da flash (fora do programa) como anel
+// de setores de 4 KB: a leitura é direta pelo XIP e a gravação apaga e grava
+// um setor por flash_safe_execute (pico_flash), com as interrupções
+// desligadas neste núcleo (~45 ms por setor, segundo o datasheet da W25Q16;
+// a USB CDC fica sem atendimento nesse tempo e o host repete as transferências)
+// O outro núcleo precisa estar parado ou ter chamado
+// multicore_lockout_victim_init(); projetos de um núcleo só definem
+// PICO_FLASH_ASSUME_CORE1_SAFE=1. Se não der para parar o outro núcleo, a
+// gravação falha (metricas.falhas_gravacao) sem tocar na flash
+// O programa tem de terminar antes da área: serie_flash.ld confere na
+// ligação (com 256 KB; mudar junto com SERIE_FLASH_BYTES) e
+// serie_flash_meio para com panic se não
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#ifndef SERIE_FLASH_H
+#define SERIE_FLASH_H
+
+#include "serie.h"
+
+// Tamanho da área reservada; 256 KB = 64 páginas
+#ifndef SERIE_FLASH_BYTES
+#define SERIE_FLASH_BYTES       (256u * 1024u)
+#endif
+
+// Preenche 'meio' com a área reservada no fim da flash
+void serie_flash_meio(serie_meio_t *meio);
+
+// Apaga a área inteira (a série deve ser reiniciada depois); false se o
+// outro núcleo não pôde ser bloqueado
+bool serie_flash_apagar(void);
+
+#endif // SERIE_FLASH_H
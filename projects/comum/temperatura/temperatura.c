@@ -0,0 +1,80 @@
+// Temperatura interna em ponto fixo (ver temperatura.h)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include "temperatura.h"
+
+// Constantes do datasheet (RP2040, 4.9.5) na escala do código sobreamostrado
+// Só entram em expressões constantes: o compilador resolve os doubles e o
+// código gerado usa apenas as constantes inteiras abaixo
+#define CENTI_POR_CODIGO    (3.3 / (4096.0 * TEMPERATURA_ESCALA) / 0.001721 * 100.0)
+#define CENTI_EM_ZERO       (2700.0 + 0.706 / 0.001721 * 100.0)
+#define CODIGO_DE(centi)    ((CENTI_EM_ZERO - (centi)) / CENTI_POR_CODIGO)
+
+// Faixa do mapa: o código cresce quando a temperatura cai
+#define CODIGO_MIN          ((int32_t)CODIGO_DE(TEMPERATURA_MAX_CENTI) + 1)
+#define CODIGO_MAX          ((int32_t)CODIGO_DE(TEMPERATURA_MIN_CENTI))
+
+// Mapa linear em Q16 a partir de CODIGO_MIN: a faixa tem ~7200 códigos, então
+// o produto (codigo - CODIGO_MIN) * inclinação e a temperatura em Q16 cabem
+// em 32 bits com sinal, sem multiplicação de 64 bits no M0+
+static const int32_t inclinacao_q16 = (int32_t)(CENTI_POR_CODIGO * 65536.0 + 0.5);
+static const int32_t base_q16 =
+    (int32_t)((CENTI_EM_ZERO - CODIGO_MIN * CENTI_POR_CODIGO) * 65536.0 + 0.5);
+
+uint16_t temperatura_decimar(const uint16_t *leituras, uint32_t total) {
+    uint32_t soma = 0;
+
+    for (uint32_t i = 0; i < total; i++) {
+        soma += leituras[i];
+    }
+    return (uint16_t)((soma * TEMPERATURA_ESCALA + total / 2) / total);
+}
+
+int32_t temperatura_centi(uint16_t codigo) {
+    int32_t c = codigo;
+
+    if (c < CODIGO_MIN) {
+        c = CODIGO_MIN;
+    } else if (c > CODIGO_MAX) {
+        c = CODIGO_MAX;
+    }
+    int32_t t_q16 = base_q16 - (c - CODIGO_MIN) * inclinacao_q16;
+
+    // Arredonda para o centésimo mais próximo (deslocamento aritmético no GCC)
+    return (t_q16 + (1 << 15)) >> 16;
+}
+
+int32_t temperatura_centi_de_adc(uint16_t leitura) {
+    return temperatura_centi((uint16_t)(leitura * TEMPERATURA_ESCALA));
+}
+
+void temperatura_fluxo_iniciar(temperatura_fluxo_t *f, uint32_t periodo_ms) {
+    *f = (temperatura_fluxo_t){ .periodo_ms = periodo_ms };
+}
+
+bool temperatura_fluxo_amostra(temperatura_fluxo_t *f, int32_t centi, uint32_t instante_ms,
+                               int32_t *media) {
+    bool fechou = false;
+
+    if (f->total == 0) {
+        f->inicio_ms = instante_ms;     // A primeira conversão abre a primeira janela
+    } else if (instante_ms - f->inicio_ms >= f->periodo_ms) {
+        // A conversão que chega no fim do período já é da janela seguinte:
+        // fecha a atual sem ela. Média arredondada para o mais próximo,
+        // também abaixo de zero
+        int32_t meio = (int32_t)(f->total / 2);
+        f->media = (f->soma + (f->soma < 0 ? -meio : meio)) / (int32_t)f->total;
+        f->publicado = true;
+        f->soma = 0;
+        f->total = 0;
+        *media = f->media;
+        fechou = true;
+
+        // Janelas presas à grade do período, sem acumular o atraso das
+        // conversões; uma lacuna longa pula as janelas vazias
+        f->inicio_ms += (instante_ms - f->inicio_ms) / f->periodo_ms * f->periodo_ms;
+    }
+    f->soma += centi;
+    f->total++;
+    return fechou;
+}
@@ -0,0 +1,58 @@
+// Temperatura interna do RP2040 em ponto fixo (centésimos de grau)
+// A leitura vem sobreamostrada: TEMPERATURA_AMOSTRAS leituras de 12 bits
+// somadas e decimadas para um código de 16 bits na escala do ADC * 16; o
+// código vira centésimos de grau por um mapa linear em Q16, sem float
+// O mapa segue a fórmula do datasheet, T = 27 - (V - 0,706) / 0,001721, com
+// V = leitura * 3,3 / 4096: um LSB do ADC de 12 bits vale Vref / 2^12, o
+// mesmo fator do exemplo do SDK (3.3f / (1 << 12)); o divisor 4095 usado
+// antes em pico_temp_unity_test deslocava a leitura em ~0,1 °C
+// Fora da faixa TEMPERATURA_MIN_CENTI..TEMPERATURA_MAX_CENTI, bem além da
+// operação do chip, o resultado satura
+// Também há um fluxo com média por janela e no máximo um valor por período
+// Sem dependência de hardware: testado no host (pico_temp_unity_test/host)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#ifndef TEMPERATURA_H
+#define TEMPERATURA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Leituras por conversão; a soma de 256 leituras de 12 bits cabe em 20 bits
+// e a decimação guarda 4 bits a mais que uma leitura só
+#define TEMPERATURA_AMOSTRAS    256
+#define TEMPERATURA_ESCALA      16      // Código sobreamostrado = leitura * 16
+
+// Faixa do mapa; além dela o resultado satura
+#define TEMPERATURA_MIN_CENTI   (-6000)
+#define TEMPERATURA_MAX_CENTI   15000
+
+// Média das leituras de 12 bits na escala do código (leitura * 16), arredondada
+uint16_t temperatura_decimar(const uint16_t *leituras, uint32_t total);
+
+// Código sobreamostrado (leitura * 16) -> centésimos de grau Celsius
+int32_t temperatura_centi(uint16_t codigo);
+
+// Uma leitura de 12 bits -> centésimos de grau Celsius
+int32_t temperatura_centi_de_adc(uint16_t leitura);
+
+// Fluxo de temperaturas: acumula as conversões e publica a média de cada
+// janela de 'periodo_ms', no máximo uma vez por período
+typedef struct {
+    uint32_t periodo_ms;
+    uint32_t inicio_ms;         // Início da janela atual
+    int32_t soma;               // Centésimos de grau acumulados na janela
+    uint32_t total;             // Conversões na janela
+    int32_t media;              // Último valor publicado
+    bool publicado;             // Já houve ao menos um valor
+} temperatura_fluxo_t;
+
+void temperatura_fluxo_iniciar(temperatura_fluxo_t *f, uint32_t periodo_ms);
+
+// Acumula uma conversão; retorna true e escreve a média em 'media' quando a
+// conversão cai depois do fim da janela, que fecha sem ela (a primeira
+// janela começa na primeira conversão e as seguintes a cada 'periodo_ms')
+bool temperatura_fluxo_amostra(temperatura_fluxo_t *f, int32_t centi, uint32_t instante_ms,
+                               int32_t *media);
+
+#endif // TEMPERATURA_H
@@ -0,0 +1,61 @@
+// Sobreamostragem do sensor interno por FIFO + DMA (ver temperatura_adc.h)
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include "temperatura_adc.h"
+
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+
+static uint16_t leituras[TEMPERATURA_AMOSTRAS];
+static uint canal_dma;
+static bool em_andamento;
+
+void temperatura_adc_iniciar(void) {
+    adc_init();
+    adc_set_temp_sensor_enabled(true);
+    adc_select_input(TEMPERATURA_ADC_CANAL);
+    adc_fifo_setup(true, true, 1, false, false);     // DREQ a cada leitura, 12 bits
+    adc_set_clkdiv((float)(clock_get_hz(clk_adc) / TEMPERATURA_ADC_TAXA_HZ - 1u));  // Período = 1 + div ciclos
+
+    canal_dma = (uint)dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(canal_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    dma_channel_configure(canal_dma, &c, leituras, &adc_hw->fifo, TEMPERATURA_AMOSTRAS, false);
+}
+
+void temperatura_adc_disparar(void) {
+    adc_run(false);
+    adc_fifo_drain();
+    dma_channel_set_write_addr(canal_dma, leituras, false);
+    dma_channel_set_trans_count(canal_dma, TEMPERATURA_AMOSTRAS, true);
+    em_andamento = true;
+    adc_run(true);
+}
+
+bool temperatura_adc_pronta(uint16_t *codigo) {
+    if (!em_andamento || dma_channel_is_busy(canal_dma)) {
+        return false;
+    }
+    // Para o ADC e descarta a leitura que pode ter chegado depois da última
+    // transferência
+    adc_run(false);
+    adc_fifo_drain();
+    em_andamento = false;
+    *codigo = temperatura_decimar(leituras, TEMPERATURA_AMOSTRAS);
+    return true;
+}
+
+uint16_t temperatura_adc_ler(void) {
+    uint16_t codigo;
+
+    temperatura_adc_disparar();
+    while (!temperatura_adc_pronta(&codigo)) {
+        tight_loop_contents();
+    }
+    return codigo;
+}
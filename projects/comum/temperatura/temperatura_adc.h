@@ -0,0 +1,34 @@
+// Sensor de temperatura interno do RP2040 com sobreamostragem por DMA
+// Cada conversão é uma rajada de TEMPERATURA_AMOSTRAS leituras do canal 4:
+// o ADC roda livre e empurra as leituras no FIFO, e o DMA (DREQ do ADC) as
+// copia para um buffer; o processador só soma e decima no fim da rajada
+// (temperatura.c). A 100 kHz a rajada leva ~2,6 ms e pode correr enquanto
+// o laço faz outra coisa (temperatura_adc_disparar + temperatura_adc_pronta)
+// Usa o ADC inteiro: não combinar com outras leituras de ADC no mesmo projeto
+// sem reconfigurar a entrada
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#ifndef TEMPERATURA_ADC_H
+#define TEMPERATURA_ADC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "temperatura.h"
+
+#define TEMPERATURA_ADC_CANAL   4           // Sensor interno
+#define TEMPERATURA_ADC_TAXA_HZ 100000      // Leituras por segundo na rajada
+
+// Liga o sensor, configura o FIFO e reserva um canal de DMA
+void temperatura_adc_iniciar(void);
+
+// Começa uma rajada sem bloquear
+void temperatura_adc_disparar(void);
+
+// Se a rajada terminou, escreve o código sobreamostrado (leitura * 16) e
+// retorna true; a próxima rajada precisa de um novo disparo
+bool temperatura_adc_pronta(uint16_t *codigo);
+
+// Dispara e espera a rajada; retorna o código sobreamostrado
+uint16_t temperatura_adc_ler(void);
+
+#endif // TEMPERATURA_ADC_H
@@ -0,0 +1,73 @@
+/**
+ * @file galton_bench.cpp
+ * @brief Benchmark de escalabilidade do motor em lote (host)
+ *
+ * Uso: galton_bench [--levels N] [--balls N] [--max-threads T]
+ *
+ * Executa a mesma simulação com 1, 2, ..., T threads e reporta bolas por
+ * segundo e aceleração em relação a uma thread. Todas as execuções usam a
+ * mesma semente, então os bins também são conferidos entre si.
+ *
+ * @author Jorge Wilker
+ * @date Maio 2025
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "galton_parallel.hpp"
+
+extern "C"
+{
+#include "galton.h"
+}
+
+int main(int argc, char **argv)
+{
+    galton_run_config_t config;
+    config.levels = NUM_LEVELS;
+    config.balls = 200000000;
+    config.seed = 42;
+    unsigned max_threads = std::thread::hardware_concurrency();
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "--levels") == 0)
+            config.levels = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--balls") == 0)
+            config.balls = std::strtoull(argv[i + 1], nullptr, 0);
+        else if (std::strcmp(argv[i], "--max-threads") == 0)
+            max_threads = static_cast<unsigned>(std::atoi(argv[i + 1]));
+    }
+
+    if (config.levels < 1 || config.levels > GALTON_MAX_LEVELS || max_threads < 1)
+    {
+        std::printf("Uso: %s [--levels N] [--balls N] [--max-threads T]\n", argv[0]);
+        return 2;
+    }
+
+    std::printf("niveis=%d bolas=%llu\n", config.levels, static_cast<unsigned long long>(config.balls));
+    std::printf("%8s %12s %14s %10s\n", "threads", "tempo (s)", "Mbolas/s", "speedup");
+
+    galton_run_result_t baseline;
+    for (unsigned threads = 1; threads <= max_threads; threads++)
+    {
+        config.threads = threads;
+        galton_run_result_t result = galton_run_parallel(config);
+
+        if (threads == 1)
+            baseline = result;
+        else if (result.bins != baseline.bins)
+        {
+            std::printf("ERRO: bins com %u threads divergem da execucao em thread unica\n", threads);
+            return 1;
+        }
+
+        std::printf("%8u %12.3f %14.1f %9.2fx\n", threads, result.seconds,
+                    config.balls / result.seconds / 1e6, baseline.seconds / result.seconds);
+    }
+
+    return 0;
+}
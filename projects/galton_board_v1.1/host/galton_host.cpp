@@ -0,0 +1,102 @@
+/**
+ * @file galton_host.cpp
+ * @brief CLI nativa da simulação do Galton Board
+ *
+ * Uso: galton_host [--levels N] [--balls N] [--seed S] [--threads T] [--verify]
+ *
+ * Com --verify, repete a execução em uma única thread e falha (código 1) se
+ * qualquer coletor divergir.
+ *
+ * @author Jorge Wilker
+ * @date Maio 2025
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "galton_parallel.hpp"
+
+extern "C"
+{
+#include "galton.h"
+}
+
+/**
+ * @brief Exibe a ajuda da linha de comando
+ *
+ * @param program Nome do executável
+ */
+static void print_usage(const char *program)
+{
+    std::printf("Uso: %s [--levels N] [--balls N] [--seed S] [--threads T] [--verify]\n", program);
+    std::printf("  --levels   niveis do tabuleiro (1 a %d, padrao %d)\n", GALTON_MAX_LEVELS, NUM_LEVELS);
+    std::printf("  --balls    total de bolas (padrao 1000000)\n");
+    std::printf("  --seed     semente do gerador (padrao 1)\n");
+    std::printf("  --threads  threads de simulacao (padrao: todos os nucleos)\n");
+    std::printf("  --verify   confere o resultado contra uma execucao em thread unica\n");
+}
+
+int main(int argc, char **argv)
+{
+    galton_run_config_t config;
+    config.levels = NUM_LEVELS;
+    config.threads = std::thread::hardware_concurrency();
+    bool verify = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = (i + 1 < argc);
+
+        if (std::strcmp(argv[i], "--levels") == 0 && has_value)
+            config.levels = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--balls") == 0 && has_value)
+            config.balls = std::strtoull(argv[++i], nullptr, 0);
+        else if (std::strcmp(argv[i], "--seed") == 0 && has_value)
+            config.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        else if (std::strcmp(argv[i], "--threads") == 0 && has_value)
+            config.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--verify") == 0)
+            verify = true;
+        else
+        {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (config.levels < 1 || config.levels > GALTON_MAX_LEVELS || config.threads < 1)
+    {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    galton_run_result_t result = galton_run_parallel(config);
+
+    std::printf("niveis=%d bolas=%llu semente=%lu threads=%u\n", config.levels,
+                static_cast<unsigned long long>(config.balls), static_cast<unsigned long>(config.seed),
+                config.threads);
+    for (size_t i = 0; i < result.bins.size(); i++)
+    {
+        std::printf("bin[%2zu] = %llu\n", i, static_cast<unsigned long long>(result.bins[i]));
+    }
+    std::printf("tempo=%.3f s  vazao=%.1f Mbolas/s\n", result.seconds,
+                result.seconds > 0 ? config.balls / result.seconds / 1e6 : 0.0);
+
+    if (verify)
+    {
+        galton_run_config_t single = config;
+        single.threads = 1;
+        galton_run_result_t reference = galton_run_parallel(single);
+
+        if (reference.bins != result.bins)
+        {
+            std::printf("VERIFICACAO: DIVERGENTE da execucao em thread unica\n");
+            return 1;
+        }
+        std::printf("VERIFICACAO: identico a execucao em thread unica\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file galton_parallel.cpp
+ * @brief Implementação da execução multithread do motor em lote
+ *
+ * @author Jorge Wilker
+ * @date Maio 2025
+ */
+
+#include "galton_parallel.hpp"
+
+#include <chrono>
+#include <thread>
+
+extern "C"
+{
+#include "galton.h"
+}
+
+/** Bolas por chamada ao motor (os contadores locais do lote são de 32 bits) */
+static const uint64_t CHUNK_BALLS = 1u << 30;
+
+/**
+ * @brief Simula a faixa [first, first + count) da sequência de bolas
+ *
+ * @param config Parâmetros da execução
+ * @param first Índice da primeira bola da faixa
+ * @param count Quantidade de bolas da faixa
+ * @param bins Bins privados da thread
+ */
+static void simulate_range(const galton_run_config_t &config, uint64_t first, uint64_t count,
+                           std::vector<uint64_t> &bins)
+{
+    galton_rng_t rng;
+    galton_rng_seed(&rng, config.seed);
+    galton_rng_jump(&rng, first);
+
+    while (count > 0)
+    {
+        uint32_t batch = static_cast<uint32_t>(count < CHUNK_BALLS ? count : CHUNK_BALLS);
+        galton_simulate_batch_levels(&rng, config.levels, batch, bins.data());
+        count -= batch;
+    }
+}
+
+galton_run_result_t galton_run_parallel(const galton_run_config_t &config)
+{
+    const unsigned threads = config.threads > 0 ? config.threads : 1;
+    const size_t num_bins = static_cast<size_t>(config.levels) + 1;
+
+    std::vector<std::vector<uint64_t>> private_bins(threads, std::vector<uint64_t>(num_bins, 0));
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+
+    /* Divide as bolas em faixas contíguas; as primeiras recebem o resto */
+    uint64_t base = config.balls / threads;
+    uint64_t extra = config.balls % threads;
+    uint64_t first = 0;
+
+    for (unsigned t = 0; t < threads; t++)
+    {
+        uint64_t count = base + (t < extra ? 1 : 0);
+        workers.emplace_back(simulate_range, std::cref(config), first, count, std::ref(private_bins[t]));
+        first += count;
+    }
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    galton_run_result_t result;
+    result.bins.assign(num_bins, 0);
+    for (const auto &bins : private_bins)
+    {
+        for (size_t i = 0; i < num_bins; i++)
+        {
+            result.bins[i] += bins[i];
+        }
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return result;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file galton_parallel.hpp
+ * @brief Execução do motor em lote do Galton Board em várias threads (host)
+ *
+ * Cada thread simula uma faixa contígua da sequência de bolas em bins
+ * privados, partindo do gerador já avançado por galton_rng_jump(); os bins
+ * são somados ao final. O resultado é idêntico ao de uma única thread com a
+ * mesma semente, para qualquer número de threads.
+ *
+ * @author Jorge Wilker
+ * @date Maio 2025
+ */
+
+#ifndef GALTON_PARALLEL_HPP
+#define GALTON_PARALLEL_HPP
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Parâmetros de uma execução
+ */
+struct galton_run_config_t
+{
+    int levels = 7;           /**< Número de níveis (1 a GALTON_MAX_LEVELS) */
+    uint64_t balls = 1000000; /**< Total de bolas */
+    uint32_t seed = 1;        /**< Semente do gerador */
+    unsigned threads = 1;     /**< Número de threads */
+};
+
+/**
+ * @brief Resultado de uma execução
+ */
+struct galton_run_result_t
+{
+    std::vector<uint64_t> bins; /**< Contagem por coletor (levels + 1 posições) */
+    double seconds = 0.0;       /**< Tempo de parede da simulação */
+};
+
+/**
+ * @brief Simula a execução descrita em config
+ *
+ * @param config Parâmetros da execução
+ * @return Bins mesclados e tempo gasto
+ */
+galton_run_result_t galton_run_parallel(const galton_run_config_t &config);
+
+#endif // GALTON_PARALLEL_HPP
@@ -0,0 +1,253 @@
+/**
+ * @file galton_render_bench.c
+ * @brief Benchmark do renderizador em camadas contra o desenho original
+ *
+ * Gera a sequência de quadros de uma execução completa (NUM_BALLS bolas,
+ * todas as posições intermediárias da bolinha em queda), renderiza cada
+ * quadro com o código original (limpa o buffer e redesenha tudo) e com o
+ * renderizador em camadas, compara os framebuffers e mede o custo médio
+ * por quadro. O envio I2C não entra na medição.
+ *
+ * Uso: galton_render_bench [repeticoes]
+ *
+ * @author Jorge Wilker
+ * @date Maio 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "galton.h"
+#include "galton_render.h"
+#include "ssd1306_i2c.h"
+
+/** Quadros de uma execução: cada bola passa por NUM_LEVELS + 1 níveis de 3 passos */
+#define MAX_FRAMES (NUM_BALLS * (NUM_LEVELS + 1) * 3)
+
+/**
+ * @brief Estado necessário para desenhar um quadro
+ */
+typedef struct
+{
+    int current_ball;        /**< Bolas já contabilizadas */
+    int bins[NUM_BINS];      /**< Contagem por coletor */
+    ball_position_t ball;    /**< Bolinha em queda */
+} frame_state_t;
+
+static frame_state_t frames[MAX_FRAMES];
+
+/**
+ * @brief Desenho original de display_draw_galton_board(), preservado como referência
+ */
+static void legacy_draw_galton_board(ssd1306_t *display, int num_levels, const int *bins, const ball_position_t *ball)
+{
+    int start_x = 42;
+    int start_y = 12;
+    int spacing = 6;
+
+    for (int level = 0; level < num_levels; level++)
+    {
+        int y = start_y + level * spacing;
+        int pins_in_level = level + 1;
+        int level_width = pins_in_level * spacing;
+        int level_start_x = start_x - level_width / 2;
+
+        for (int pin = 0; pin < pins_in_level; pin++)
+        {
+            int x = level_start_x + pin * spacing;
+            ssd1306_draw_circle(display, x, y, 1, true, true);
+        }
+    }
+
+    int canaleta_y = start_y + num_levels * spacing;
+    int num_canaletas = num_levels + 1;
+    int canaleta_width = spacing - 1;
+    int canaletas_start_x = start_x - (num_canaletas * spacing) / 2 + 1;
+
+    for (int i = 0; i < num_canaletas; i++)
+    {
+        int x = canaletas_start_x + i * spacing;
+
+        ssd1306_draw_rect(display, x, canaleta_y, canaleta_width, 8, true, false);
+        ssd1306_draw_line(display, x, canaleta_y, x, canaleta_y + 8, true);
+        ssd1306_draw_line(display, x + canaleta_width - 1, canaleta_y, x + canaleta_width - 1, canaleta_y + 8, true);
+
+        if (bins[i] > 0)
+        {
+            ssd1306_draw_circle(display, x + canaleta_width / 2, canaleta_y + 4, 1, true, true);
+        }
+    }
+
+    if (ball->active)
+    {
+        int level_y = start_y + (ball->current_level * spacing);
+        int y = level_y - spacing + (ball->steps * spacing / 3);
+        int pins_in_level = ball->current_level + 1;
+        int level_width = pins_in_level * spacing;
+        int level_start_x = start_x - level_width / 2;
+        int x = level_start_x + (ball->position * spacing);
+
+        ssd1306_draw_circle(display, x, y, 2, true, true);
+    }
+}
+
+/**
+ * @brief Desenho original de display_draw_bins(), preservado como referência
+ */
+static void legacy_draw_bins(ssd1306_t *display, const int bins[], int num_bins)
+{
+    int hist_height = 35;
+    int hist_y = 15;
+    int bar_gap = 2;
+    int bar_width = 2;
+    int total_width = (bar_width * num_bins) + (bar_gap * (num_bins - 1));
+    int hist_x = 128 - total_width - 4;
+
+    ssd1306_draw_rect(display, hist_x - 2, hist_y, total_width + 4, hist_height, true, false);
+    ssd1306_draw_line(display, hist_x - 2, hist_y + hist_height - 1,
+                      hist_x + total_width + 1, hist_y + hist_height - 1, true);
+
+    for (int bin = 0; bin < num_bins; bin++)
+    {
+        int value = bins[bin];
+        int max_bar_height = hist_height - 5;
+        int bar_height = value > max_bar_height ? max_bar_height : value;
+        int bar_x = hist_x + (bin * (bar_width + bar_gap));
+
+        if (bar_height > 0)
+        {
+            ssd1306_draw_rect(display, bar_x, hist_y + hist_height - 2 - bar_height,
+                              bar_width, bar_height, true, true);
+        }
+
+        if (value > 0)
+        {
+            /* Três dígitos cabem sob a barra; acima de 999 fica 999 */
+            char num_str[4];
+            snprintf(num_str, sizeof(num_str), "%d", value > 999 ? 999 : value);
+            int text_y = (bin % 2 == 0) ? hist_y + hist_height + 1 : hist_y + hist_height + 8;
+            ssd1306_draw_string(display, num_str, bar_x - 1, text_y, true);
+        }
+    }
+
+    ssd1306_draw_string(display, "HISTOGRAMA", hist_x + 2, hist_y - 9, true);
+}
+
+/**
+ * @brief Quadro completo no caminho original (clear + redesenho de tudo)
+ */
+static void legacy_render(ssd1306_t *display, const frame_state_t *f)
+{
+    char buffer[16];
+
+    ssd1306_clear(display);
+    snprintf(buffer, sizeof(buffer), "BOLAS: %d/%d", f->current_ball, NUM_BALLS);
+    ssd1306_draw_rect(display, 0, 0, 128, 10, true, false);
+    ssd1306_draw_string(display, buffer, 2, 1, true);
+    legacy_draw_galton_board(display, NUM_LEVELS, f->bins, &f->ball);
+    legacy_draw_bins(display, f->bins, NUM_BINS);
+}
+
+/**
+ * @brief Quadro completo no caminho em camadas
+ */
+static void layered_render(ssd1306_t *display, const frame_state_t *f)
+{
+    galton_render_begin_frame(display);
+    galton_render_stats(display, f->current_ball, NUM_BALLS);
+    galton_render_board(display, f->bins, NUM_BINS, &f->ball);
+    galton_render_histogram(display, f->bins, NUM_BINS);
+}
+
+/**
+ * @brief Gera a sequência de quadros de uma execução, como galton_update()
+ *
+ * @return Quantidade de quadros gerados
+ */
+static int generate_frames(void)
+{
+    frame_state_t state;
+    int count = 0;
+
+    memset(&state, 0, sizeof(state));
+    srand(1234);
+
+    for (int ball = 0; ball < NUM_BALLS; ball++)
+    {
+        state.ball.active = true;
+        state.ball.current_level = 0;
+        state.ball.position = 0;
+
+        while (true)
+        {
+            for (int step = 0; step < 3; step++)
+            {
+                state.ball.steps = step;
+                frames[count++] = state;
+            }
+
+            if (state.ball.current_level >= NUM_LEVELS)
+                break;
+
+            state.ball.position += rand() % 2;
+            state.ball.current_level++;
+        }
+
+        state.bins[state.ball.position]++;
+        state.current_ball++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Tempo monotônico em nanossegundos
+ */
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv)
+{
+    static ssd1306_t legacy;
+    static ssd1306_t layered;
+    int repetitions = (argc > 1) ? atoi(argv[1]) : 200;
+    int num_frames = generate_frames();
+    int identical = 0;
+
+    galton_render_init(&layered);
+
+    /* Conferência pixel a pixel entre os dois caminhos */
+    for (int i = 0; i < num_frames; i++)
+    {
+        legacy_render(&legacy, &frames[i]);
+        layered_render(&layered, &frames[i]);
+        if (memcmp(legacy.buffer, layered.buffer, sizeof(legacy.buffer)) == 0)
+            identical++;
+    }
+
+    double start = now_ns();
+    for (int r = 0; r < repetitions; r++)
+        for (int i = 0; i < num_frames; i++)
+            legacy_render(&legacy, &frames[i]);
+    double legacy_ns = (now_ns() - start) / ((double)repetitions * num_frames);
+
+    start = now_ns();
+    for (int r = 0; r < repetitions; r++)
+        for (int i = 0; i < num_frames; i++)
+            layered_render(&layered, &frames[i]);
+    double layered_ns = (now_ns() - start) / ((double)repetitions * num_frames);
+
+    printf("quadros=%d repeticoes=%d\n", num_frames, repetitions);
+    printf("quadros identicos: %d/%d\n", identical, num_frames);
+    printf("original : %8.0f ns/quadro\n", legacy_ns);
+    printf("camadas  : %8.0f ns/quadro\n", layered_ns);
+    printf("ganho    : %8.2fx\n", legacy_ns / layered_ns);
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file i2c.h
+ * @brief Substituto mínimo de hardware/i2c.h para a build nativa
+ *
+ * As escritas I2C são descartadas; o framebuffer continua acessível em
+ * ssd1306_t::buffer para medições e comparações.
+ *
+ * @author Jorge Wilker
+ * @date Maio 2025
+ */
+
+#ifndef HOST_STUB_HARDWARE_I2C_H
+#define HOST_STUB_HARDWARE_I2C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct i2c_inst i2c_inst_t;
+
+static inline int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    (void)i2c;
+    (void)addr;
+    (void)src;
+    (void)nostop;
+    return (int)len;
+}
+
+#endif // HOST_STUB_HARDWARE_I2C_H
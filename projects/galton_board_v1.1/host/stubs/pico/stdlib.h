@@ -0,0 +1,25 @@
+/**
+ * @file stdlib.h
+ * @brief Substituto mínimo de pico/stdlib.h para a build nativa
+ *
+ * Apenas o necessário para compilar o driver SSD1306 no host; as funções de
+ * espera não fazem nada.
+ *
+ * @author Jorge Wilker
+ * @date Maio 2025
+ */
+
+#ifndef HOST_STUB_PICO_STDLIB_H
+#define HOST_STUB_PICO_STDLIB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+
+static inline void sleep_ms(uint32_t ms)
+{
+    (void)ms;
+}
+
+#endif // HOST_STUB_PICO_STDLIB_H
@@ -9,7 +9,6 @@
  */
 
 #include "galton.h"
-#include <time.h>
 
 /** Variáveis estáticas para controle do estado da simulação */
 static int bins[NUM_BINS] = {0};                         /**< Contador de bolas em cada coletor */
@@ -34,9 +33,9 @@ static ball_position_t ball_position = {
  */
 void galton_init(void)
 {
-    /* Inicializa o gerador de números aleatórios com a hora atual
+    /* Inicializa o gerador de números aleatórios com um valor variável
      * Isso garante sequências diferentes a cada execução */
-    srand(time(NULL));
+    srand(galton_port_entropy());
 
     /* Reseta a simulação para o estado inicial */
     galton_reset();
@@ -98,6 +97,137 @@ int galton_simulate_ball_path(void)
     return position;
 }
 
+/**
+ * @brief Inicializa o gerador pseudoaleatório com uma semente
+ *
+ * O xorshift32 não pode partir do estado zero, então a semente zero é
+ * trocada por uma constante fixa.
+ *
+ * @param rng Ponteiro para o gerador
+ * @param seed Semente inicial
+ */
+void galton_rng_seed(galton_rng_t *rng, uint32_t seed)
+{
+    rng->state = (seed != 0) ? seed : 0x9E3779B9u;
+}
+
+/**
+ * @brief Avança o gerador e retorna a próxima palavra de 32 bits
+ *
+ * @param rng Ponteiro para o gerador
+ * @return Próximo valor pseudoaleatório
+ */
+static inline uint32_t galton_rng_next(galton_rng_t *rng)
+{
+    uint32_t x = rng->state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng->state = x;
+    return x;
+}
+
+/**
+ * @brief Aplica a matriz de transição (colunas em cols) a um vetor de 32 bits
+ *
+ * @param cols 32 colunas da matriz sobre GF(2)
+ * @param v Vetor de entrada
+ * @return Produto matriz-vetor
+ */
+static uint32_t galton_gf2_apply(const uint32_t cols[32], uint32_t v)
+{
+    uint32_t result = 0;
+
+    for (int i = 0; v != 0; i++, v >>= 1)
+    {
+        if (v & 1u)
+        {
+            result ^= cols[i];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Avança o gerador em steps passos por exponenciação da matriz
+ *
+ * @param rng Gerador a avançar
+ * @param steps Quantidade de palavras a pular
+ */
+void galton_rng_jump(galton_rng_t *rng, uint64_t steps)
+{
+    uint32_t power[32];
+    uint32_t squared[32];
+
+    /* Coluna i = imagem do vetor unitário i por um passo do xorshift */
+    for (int i = 0; i < 32; i++)
+    {
+        galton_rng_t unit = {1u << i};
+        power[i] = galton_rng_next(&unit);
+    }
+
+    while (steps != 0)
+    {
+        if (steps & 1u)
+        {
+            rng->state = galton_gf2_apply(power, rng->state);
+        }
+
+        for (int i = 0; i < 32; i++)
+        {
+            squared[i] = galton_gf2_apply(power, power[i]);
+        }
+        for (int i = 0; i < 32; i++)
+        {
+            power[i] = squared[i];
+        }
+
+        steps >>= 1;
+    }
+}
+
+/**
+ * @brief Simula um lote de bolas sem animação
+ *
+ * @param rng Gerador pseudoaleatório
+ * @param num_balls Quantidade de bolas a simular
+ * @param bins Array de NUM_BINS contadores que recebe as bolas
+ */
+void galton_simulate_batch(galton_rng_t *rng, uint32_t num_balls, uint64_t *bins)
+{
+    galton_simulate_batch_levels(rng, NUM_LEVELS, num_balls, bins);
+}
+
+/**
+ * @brief Simula um lote de bolas com número de níveis variável
+ *
+ * Cada bit dos levels bits inferiores de uma palavra aleatória é uma
+ * decisão esquerda/direita; o coletor final é a soma das decisões, ou seja,
+ * a contagem de bits 1. As contagens do lote ficam em contadores de 32 bits
+ * locais e só depois são somadas aos bins de 64 bits do chamador.
+ *
+ * @param rng Gerador pseudoaleatório
+ * @param levels Número de níveis (1 a GALTON_MAX_LEVELS)
+ * @param num_balls Quantidade de bolas a simular
+ * @param bins Array de levels + 1 contadores que recebe as bolas
+ */
+void galton_simulate_batch_levels(galton_rng_t *rng, int levels, uint32_t num_balls, uint64_t *bins)
+{
+    const uint32_t level_mask = (levels >= 32) ? 0xFFFFFFFFu : ((1u << levels) - 1u);
+    uint32_t local_bins[GALTON_MAX_LEVELS + 1] = {0};
+
+    for (uint32_t i = 0; i < num_balls; i++)
+    {
+        local_bins[__builtin_popcount(galton_rng_next(rng) & level_mask)]++;
+    }
+
+    for (int i = 0; i <= levels; i++)
+    {
+        bins[i] += local_bins[i];
+    }
+}
+
 /**
  * @brief Obtém o valor máximo de bolas em um único coletor
  *
@@ -166,7 +296,7 @@ void galton_set_state(simulation_state_t state)
     /* Ao iniciar a simulação, reinicia o timestamp de atualização */
     if (state == STATE_RUNNING)
     {
-        last_update_time = to_ms_since_boot(get_absolute_time());
+        last_update_time = galton_port_time_ms();
     }
 }
 
@@ -216,7 +346,7 @@ void galton_update(void)
     }
 
     /* Controle de timing para regulagem da velocidade da animação */
-    uint32_t current_time = to_ms_since_boot(get_absolute_time());
+    uint32_t current_time = galton_port_time_ms();
     if (current_time - last_update_time < DELAY_MS / 3) // Otimização para animação mais suave
     {
         return;
@@ -13,7 +13,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include "pico/stdlib.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "galton_port.h"
 
 /**
  * @brief Configurações da simulação
@@ -21,8 +23,20 @@
 #define NUM_LEVELS 7              /**< Número de níveis no Galton Board (otimizado para display) */
 #define NUM_BINS (NUM_LEVELS + 1) /**< Número de coletores (bins) na base, sempre é NUM_LEVELS + 1 */
 #define NUM_BALLS 75              /**< Quantidade total de bolas na simulação */
+#define GALTON_MAX_LEVELS 32      /**< Máximo de níveis do motor em lote (uma palavra de 32 bits por bola) */
 #define DELAY_MS 20               /**< Intervalo entre atualizações visuais (ms) */
 
+/**
+ * @brief Gerador pseudoaleatório determinístico (xorshift32)
+ *
+ * Usado pelo motor em lote: a mesma semente produz sempre a mesma
+ * sequência de bolas, independentemente do núcleo que executa a simulação.
+ */
+typedef struct
+{
+    uint32_t state; /**< Estado interno do gerador (nunca zero) */
+} galton_rng_t;
+
 /**
  * @brief Estados possíveis da simulação
  */
@@ -71,6 +85,54 @@ void galton_reset(void);
  */
 int galton_simulate_ball_path(void);
 
+/**
+ * @brief Inicializa o gerador pseudoaleatório com uma semente
+ *
+ * @param rng Ponteiro para o gerador
+ * @param seed Semente (zero é substituído por uma constante fixa)
+ */
+void galton_rng_seed(galton_rng_t *rng, uint32_t seed);
+
+/**
+ * @brief Avança o gerador em um número arbitrário de passos
+ *
+ * Equivale a descartar steps palavras, mas custa O(log steps): o xorshift32
+ * é linear sobre GF(2), então o salto é uma potência da matriz de transição.
+ * Permite dividir uma execução entre várias threads mantendo exatamente a
+ * mesma sequência de uma execução em thread única.
+ *
+ * @param rng Gerador a avançar
+ * @param steps Quantidade de palavras a pular
+ */
+void galton_rng_jump(galton_rng_t *rng, uint64_t steps);
+
+/**
+ * @brief Simula um lote de bolas sem animação
+ *
+ * Cada bola consome exatamente uma palavra de 32 bits do gerador e cai no
+ * coletor dado pela contagem de bits 1 nos NUM_LEVELS bits inferiores.
+ * Assim, dividir N bolas em lotes de qualquer tamanho produz o mesmo
+ * resultado que um único lote de N bolas com a mesma semente.
+ *
+ * @param rng Gerador pseudoaleatório (avança num_balls posições)
+ * @param num_balls Quantidade de bolas a simular
+ * @param bins Array de NUM_BINS contadores que recebe as bolas (acumulativo)
+ */
+void galton_simulate_batch(galton_rng_t *rng, uint32_t num_balls, uint64_t *bins);
+
+/**
+ * @brief Simula um lote de bolas com número de níveis definido em execução
+ *
+ * Mesma regra de galton_simulate_batch(); com levels = NUM_LEVELS os
+ * resultados são idênticos aos do motor usado no dispositivo.
+ *
+ * @param rng Gerador pseudoaleatório
+ * @param levels Número de níveis (1 a GALTON_MAX_LEVELS)
+ * @param num_balls Quantidade de bolas a simular
+ * @param bins Array de levels + 1 contadores que recebe as bolas
+ */
+void galton_simulate_batch_levels(galton_rng_t *rng, int levels, uint32_t num_balls, uint64_t *bins);
+
 /**
  * @brief Obtém o valor máximo nos bins
  *
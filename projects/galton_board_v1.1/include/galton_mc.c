@@ -0,0 +1,195 @@
+/**
+ * @file galton_mc.c
+ * @brief Implementação do modo Monte Carlo em dois núcleos
+ *
+ * Comandos vão do núcleo 0 para o núcleo 1 pela FIFO do SIO; resultados
+ * voltam por um seqlock com um único escritor (núcleo 1).
+ *
+ * @author Jorge Wilker
+ * @date Maio 2025
+ */
+
+#include "galton_mc.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+/** Contador do seqlock: ímpar enquanto o núcleo 1 escreve */
+static volatile uint32_t shared_seq = 0;
+
+/** Instantâneo compartilhado, escrito apenas pelo núcleo 1 */
+static volatile galton_mc_snapshot_t shared_snapshot;
+
+/** Quantidade de comandos enviados pelo núcleo 0 (só o núcleo 0 acessa) */
+static uint32_t requested_generation = 0;
+
+/**
+ * @brief Publica o estado privado do núcleo 1 no instantâneo compartilhado
+ *
+ * @param snap Estado privado do núcleo 1
+ */
+static void galton_mc_publish(const galton_mc_snapshot_t *snap)
+{
+    shared_seq++;
+    __dmb();
+
+    shared_snapshot.generation = snap->generation;
+    shared_snapshot.seed = snap->seed;
+    shared_snapshot.target_balls = snap->target_balls;
+    shared_snapshot.balls_done = snap->balls_done;
+    for (int i = 0; i < NUM_BINS; i++)
+    {
+        shared_snapshot.bins[i] = snap->bins[i];
+    }
+
+    __dmb();
+    shared_seq++;
+}
+
+/**
+ * @brief Recebe um comando completo da FIFO (semente + total em 64 bits)
+ *
+ * @param local Estado privado do núcleo 1 a ser reiniciado
+ * @param rng Gerador do núcleo 1
+ */
+static void galton_mc_receive_command(galton_mc_snapshot_t *local, galton_rng_t *rng)
+{
+    uint32_t seed = multicore_fifo_pop_blocking();
+    uint32_t target_lo = multicore_fifo_pop_blocking();
+    uint32_t target_hi = multicore_fifo_pop_blocking();
+
+    local->generation++;
+    local->seed = seed;
+    local->target_balls = ((uint64_t)target_hi << 32) | target_lo;
+    local->balls_done = 0;
+    for (int i = 0; i < NUM_BINS; i++)
+    {
+        local->bins[i] = 0;
+    }
+    galton_rng_seed(rng, seed);
+
+    galton_mc_publish(local);
+}
+
+/**
+ * @brief Laço principal do núcleo 1
+ *
+ * Simula lotes enquanto há bolas pendentes e verifica a FIFO entre lotes.
+ * Sem trabalho, bloqueia na FIFO (a espera usa __wfe internamente).
+ */
+static void galton_mc_core1_entry(void)
+{
+    static galton_mc_snapshot_t local;
+    galton_rng_t rng;
+
+    galton_rng_seed(&rng, 0);
+
+    while (true)
+    {
+        if (local.balls_done >= local.target_balls || multicore_fifo_rvalid())
+        {
+            galton_mc_receive_command(&local, &rng);
+            continue;
+        }
+
+        uint64_t remaining = local.target_balls - local.balls_done;
+        uint32_t batch = (remaining < GALTON_MC_BATCH_SIZE) ? (uint32_t)remaining : GALTON_MC_BATCH_SIZE;
+
+        galton_simulate_batch(&rng, batch, local.bins);
+        local.balls_done += batch;
+
+        galton_mc_publish(&local);
+    }
+}
+
+/**
+ * @brief Inicia o núcleo 1 com o laço do motor em lote
+ */
+void galton_mc_init(void)
+{
+    multicore_launch_core1(galton_mc_core1_entry);
+}
+
+/**
+ * @brief Envia ao núcleo 1 o comando de nova execução
+ *
+ * @param seed Semente do gerador pseudoaleatório
+ * @param total_balls Quantidade de bolas a simular (0 interrompe)
+ */
+void galton_mc_start(uint32_t seed, uint64_t total_balls)
+{
+    requested_generation++;
+
+    multicore_fifo_push_blocking(seed);
+    multicore_fifo_push_blocking((uint32_t)total_balls);
+    multicore_fifo_push_blocking((uint32_t)(total_balls >> 32));
+}
+
+/**
+ * @brief Lê o instantâneo compartilhado pelo protocolo seqlock
+ *
+ * @param out Estrutura que recebe a cópia
+ * @return true se a cópia é consistente e da execução mais recente
+ */
+bool galton_mc_read(galton_mc_snapshot_t *out)
+{
+    /* O escritor publica a cada lote (sub-milissegundo); poucas tentativas bastam */
+    for (int attempt = 0; attempt < 8; attempt++)
+    {
+        uint32_t seq_start = shared_seq;
+        if (seq_start & 1u)
+        {
+            continue;
+        }
+        __dmb();
+
+        out->generation = shared_snapshot.generation;
+        out->seed = shared_snapshot.seed;
+        out->target_balls = shared_snapshot.target_balls;
+        out->balls_done = shared_snapshot.balls_done;
+        for (int i = 0; i < NUM_BINS; i++)
+        {
+            out->bins[i] = shared_snapshot.bins[i];
+        }
+
+        __dmb();
+        if (shared_seq == seq_start)
+        {
+            return out->generation == requested_generation;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Refaz a execução em núcleo único e compara com o instantâneo
+ *
+ * @param snap Instantâneo a conferir
+ * @return true se todos os coletores coincidem
+ */
+bool galton_mc_verify(const galton_mc_snapshot_t *snap)
+{
+    galton_rng_t rng;
+    uint64_t reference[NUM_BINS] = {0};
+    uint64_t remaining = snap->balls_done;
+
+    galton_rng_seed(&rng, snap->seed);
+
+    /* Lotes de tamanho diferente do núcleo 1, de propósito: o resultado não depende disso */
+    while (remaining > 0)
+    {
+        uint32_t batch = (remaining > 0x10000000u) ? 0x10000000u : (uint32_t)remaining;
+        galton_simulate_batch(&rng, batch, reference);
+        remaining -= batch;
+    }
+
+    for (int i = 0; i < NUM_BINS; i++)
+    {
+        if (reference[i] != snap->bins[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file galton_mc.h
+ * @brief Modo Monte Carlo em dois núcleos para o Galton Board
+ *
+ * O núcleo 1 executa o motor em lote (galton_simulate_batch) em bins
+ * privados e publica instantâneos protegidos por seqlock; o núcleo 0 apenas
+ * lê esses instantâneos e cuida da interface, de modo que a vazão de bolas
+ * não depende do tempo de I2C do display.
+ *
+ * @author Jorge Wilker
+ * @date Maio 2025
+ */
+
+#ifndef GALTON_MC_H
+#define GALTON_MC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "galton.h"
+
+/**
+ * @brief Configurações do modo Monte Carlo
+ */
+#define GALTON_MC_BATCH_SIZE 4096      /**< Bolas simuladas entre duas publicações */
+#define GALTON_MC_TOTAL_BALLS 10000000 /**< Total de bolas por execução */
+#define GALTON_MC_FRAME_MS 50          /**< Período de renderização no núcleo 0 (20 FPS) */
+
+/**
+ * @brief Instantâneo consistente dos resultados publicados pelo núcleo 1
+ */
+typedef struct
+{
+    uint32_t generation;     /**< Número da execução a que o instantâneo pertence */
+    uint32_t seed;           /**< Semente usada na execução */
+    uint64_t target_balls;   /**< Total de bolas solicitado */
+    uint64_t balls_done;     /**< Bolas já simuladas */
+    uint64_t bins[NUM_BINS]; /**< Contagem acumulada de cada coletor */
+} galton_mc_snapshot_t;
+
+/**
+ * @brief Inicia o núcleo 1 com o laço do motor em lote
+ *
+ * Deve ser chamada uma única vez, a partir do núcleo 0.
+ */
+void galton_mc_init(void);
+
+/**
+ * @brief Solicita uma nova execução ao núcleo 1
+ *
+ * O comando segue pela FIFO entre núcleos; o núcleo 1 zera seus bins,
+ * reinicia o gerador com a semente e simula total_balls bolas.
+ * Passar total_balls = 0 interrompe a execução atual.
+ *
+ * @param seed Semente do gerador pseudoaleatório
+ * @param total_balls Quantidade de bolas a simular
+ */
+void galton_mc_start(uint32_t seed, uint64_t total_balls);
+
+/**
+ * @brief Lê o último instantâneo publicado pelo núcleo 1
+ *
+ * @param out Estrutura que recebe a cópia
+ * @return true se a cópia é consistente e pertence à última execução solicitada
+ */
+bool galton_mc_read(galton_mc_snapshot_t *out);
+
+/**
+ * @brief Confere um instantâneo contra uma execução de núcleo único
+ *
+ * Repete a simulação com a mesma semente e quantidade de bolas no núcleo
+ * chamador e compara bin a bin.
+ *
+ * @param snap Instantâneo a conferir
+ * @return true se os resultados são idênticos
+ */
+bool galton_mc_verify(const galton_mc_snapshot_t *snap);
+
+#endif // GALTON_MC_H
@@ -0,0 +1,72 @@
+/**
+ * @file galton_port.h
+ * @brief Camada de portabilidade (tempo e entropia) da simulação
+ *
+ * Isola as únicas dependências de plataforma de galton.c, permitindo
+ * compilar a simulação tanto para o Pico quanto nativamente no host
+ * (definindo GALTON_HOST).
+ *
+ * @author Jorge Wilker
+ * @date Maio 2025
+ */
+
+#ifndef GALTON_PORT_H
+#define GALTON_PORT_H
+
+#include <stdint.h>
+
+#ifdef GALTON_HOST
+
+#include <time.h>
+
+/**
+ * @brief Tempo monotônico em milissegundos (host)
+ *
+ * @return Milissegundos desde uma origem arbitrária
+ */
+static inline uint32_t galton_port_time_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u);
+}
+
+/**
+ * @brief Valor variável para semear geradores (host)
+ *
+ * @return Valor derivado do relógio de alta resolução
+ */
+static inline uint32_t galton_port_entropy(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)ts.tv_nsec ^ (uint32_t)time(NULL);
+}
+
+#else
+
+#include "pico/stdlib.h"
+
+/**
+ * @brief Tempo em milissegundos desde o boot (Pico)
+ *
+ * @return Milissegundos desde o boot
+ */
+static inline uint32_t galton_port_time_ms(void)
+{
+    return to_ms_since_boot(get_absolute_time());
+}
+
+/**
+ * @brief Valor variável para semear geradores (Pico)
+ *
+ * @return Contador de microssegundos do timer, que depende do instante do boot
+ */
+static inline uint32_t galton_port_entropy(void)
+{
+    return time_us_32();
+}
+
+#endif // GALTON_HOST
+
+#endif // GALTON_PORT_H
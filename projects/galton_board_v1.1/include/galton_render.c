@@ -0,0 +1,345 @@
+/**
+ * @file galton_render.c
+ * @brief Implementação da renderização em camadas do Galton Board
+ *
+ * A geometria é a mesma do desenho original (display_draw_galton_board e
+ * display_draw_bins); as primitivas dinâmicas escrevem direto nos bytes das
+ * páginas do framebuffer em vez de pixel a pixel.
+ *
+ * @author Jorge Wilker
+ * @date Maio 2025
+ */
+
+#include "galton_render.h"
+
+/**
+ * @brief Geometria do tabuleiro
+ */
+#define BOARD_START_X 42 /**< Posição central em X */
+#define BOARD_START_Y 12 /**< Margem superior */
+#define BOARD_SPACING 6  /**< Espaçamento entre pinos */
+#define BIN_HEIGHT 8     /**< Altura das canaletas */
+
+/**
+ * @brief Geometria do histograma
+ */
+#define HIST_HEIGHT 35                        /**< Altura da área do histograma */
+#define HIST_Y 15                             /**< Posição Y inicial */
+#define HIST_BAR_GAP 2                        /**< Espaçamento entre barras */
+#define HIST_BAR_WIDTH 2                      /**< Largura de cada barra */
+#define HIST_MAX_BAR_HEIGHT (HIST_HEIGHT - 5) /**< Altura máxima de uma barra */
+
+/**
+ * @brief Sprite monocromático de até 8 linhas, em colunas no formato das páginas
+ */
+typedef struct
+{
+    uint8_t width;      /**< Largura em pixels */
+    uint8_t origin_x;   /**< Deslocamento do centro em X */
+    uint8_t origin_y;   /**< Deslocamento do centro em Y */
+    uint8_t columns[5]; /**< Bit j de cada coluna = linha j do sprite */
+} galton_sprite_t;
+
+/** Círculo preenchido de raio 1 (marcador de canaleta), igual a ssd1306_draw_circle */
+static const galton_sprite_t sprite_marker = {3, 1, 1, {0x02, 0x07, 0x02}};
+
+/** Círculo preenchido de raio 2 (bolinha em queda), igual a ssd1306_draw_circle */
+static const galton_sprite_t sprite_ball = {5, 2, 2, {0x04, 0x0E, 0x1F, 0x0E, 0x04}};
+
+/** Imagem da camada estática, montada uma vez em galton_render_init() */
+static uint8_t background[OLED_WIDTH * OLED_PAGES];
+
+/**
+ * @brief Posição X da primeira barra do histograma
+ *
+ * @param num_bins Número de bins
+ * @return Coordenada X da barra do bin 0
+ */
+static int histogram_x(int num_bins)
+{
+    int total_width = (HIST_BAR_WIDTH * num_bins) + (HIST_BAR_GAP * (num_bins - 1));
+    return OLED_WIDTH - total_width - 4; /* 4 pixels de margem à direita */
+}
+
+/**
+ * @brief Posição X da primeira canaleta
+ *
+ * @param num_bins Número de canaletas
+ * @return Coordenada X da canaleta 0
+ */
+static int canaletas_x(int num_bins)
+{
+    return BOARD_START_X - (num_bins * BOARD_SPACING) / 2 + 1;
+}
+
+/**
+ * @brief Aplica um sprite (OR) com o centro em (x, y)
+ *
+ * @param buffer Framebuffer no formato de páginas do SSD1306
+ * @param sprite Sprite a desenhar
+ * @param x Coordenada X do centro
+ * @param y Coordenada Y do centro
+ */
+static void blit_sprite(uint8_t *buffer, const galton_sprite_t *sprite, int x, int y)
+{
+    int left = x - sprite->origin_x;
+    int top = y - sprite->origin_y;
+
+    for (int c = 0; c < sprite->width; c++)
+    {
+        int col = left + c;
+        unsigned bits = sprite->columns[c];
+        int row = top;
+
+        if (col < 0 || col >= OLED_WIDTH)
+            continue;
+
+        if (row < 0)
+        {
+            if (row <= -8)
+                continue;
+            bits >>= -row;
+            row = 0;
+        }
+        if (row >= OLED_HEIGHT)
+            continue;
+
+        int page = row >> 3;
+        int shift = row & 7;
+        buffer[col + page * OLED_WIDTH] |= (uint8_t)(bits << shift);
+        if (shift != 0 && page + 1 < OLED_PAGES)
+        {
+            buffer[col + (page + 1) * OLED_WIDTH] |= (uint8_t)(bits >> (8 - shift));
+        }
+    }
+}
+
+/**
+ * @brief Acende uma coluna vertical de pixels [y0, y0 + height)
+ *
+ * @param buffer Framebuffer no formato de páginas do SSD1306
+ * @param x Coluna
+ * @param y0 Primeira linha
+ * @param height Quantidade de linhas
+ */
+static void fill_column(uint8_t *buffer, int x, int y0, int height)
+{
+    int y1 = y0 + height - 1;
+
+    for (int page = y0 >> 3; page <= (y1 >> 3); page++)
+    {
+        uint8_t mask = 0xFF;
+        if (page == (y0 >> 3))
+            mask &= (uint8_t)(0xFF << (y0 & 7));
+        if (page == (y1 >> 3))
+            mask &= (uint8_t)(0xFF >> (7 - (y1 & 7)));
+        buffer[x + page * OLED_WIDTH] |= mask;
+    }
+}
+
+/**
+ * @brief Desenha uma barra do histograma
+ *
+ * @param buffer Framebuffer no formato de páginas do SSD1306
+ * @param bar_x Coordenada X da barra
+ * @param bar_height Altura da barra em pixels (já limitada)
+ */
+static void draw_bar(uint8_t *buffer, int bar_x, int bar_height)
+{
+    int bar_y = HIST_Y + HIST_HEIGHT - 2 - bar_height;
+
+    for (int i = 0; i < HIST_BAR_WIDTH; i++)
+    {
+        fill_column(buffer, bar_x + i, bar_y, bar_height);
+    }
+}
+
+/**
+ * @brief Desenha a camada estática e guarda a imagem de fundo
+ *
+ * @param oled Ponteiro para estrutura do display
+ */
+void galton_render_init(ssd1306_t *oled)
+{
+    ssd1306_clear(oled);
+
+    /* Pinos de cada nível em formato triangular */
+    for (int level = 0; level < NUM_LEVELS; level++)
+    {
+        int y = BOARD_START_Y + level * BOARD_SPACING;
+        int pins_in_level = level + 1;
+        int level_start_x = BOARD_START_X - (pins_in_level * BOARD_SPACING) / 2;
+
+        for (int pin = 0; pin < pins_in_level; pin++)
+        {
+            ssd1306_draw_circle(oled, level_start_x + pin * BOARD_SPACING, y, 1, true, true);
+        }
+    }
+
+    /* Laterais das canaletas */
+    int canaleta_y = BOARD_START_Y + NUM_LEVELS * BOARD_SPACING;
+    int canaleta_width = BOARD_SPACING - 1;
+    int start_x = canaletas_x(NUM_BINS);
+
+    for (int i = 0; i < NUM_BINS; i++)
+    {
+        int x = start_x + i * BOARD_SPACING;
+        ssd1306_draw_line(oled, x, canaleta_y, x, canaleta_y + BIN_HEIGHT, true);
+        ssd1306_draw_line(oled, x + canaleta_width - 1, canaleta_y,
+                          x + canaleta_width - 1, canaleta_y + BIN_HEIGHT, true);
+    }
+
+    /* Base e título do histograma */
+    int hist_x = histogram_x(NUM_BINS);
+    int total_width = OLED_WIDTH - 4 - hist_x;
+    ssd1306_draw_line(oled, hist_x - 2, HIST_Y + HIST_HEIGHT - 1,
+                      hist_x + total_width + 1, HIST_Y + HIST_HEIGHT - 1, true);
+    ssd1306_draw_string(oled, "HISTOGRAMA", hist_x + 2, HIST_Y - 9, true);
+
+    memcpy(background, oled->buffer, sizeof(background));
+}
+
+/**
+ * @brief Inicia um quadro copiando a imagem de fundo para o buffer
+ *
+ * @param oled Ponteiro para estrutura do display
+ */
+void galton_render_begin_frame(ssd1306_t *oled)
+{
+    memcpy(oled->buffer, background, sizeof(background));
+}
+
+/**
+ * @brief Escreve o contador de bolas na linha de status
+ *
+ * @param oled Ponteiro para estrutura do display
+ * @param current_ball Número da bola atual
+ * @param total_balls Número total de bolas na simulação
+ */
+void galton_render_stats(ssd1306_t *oled, int current_ball, int total_balls)
+{
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "BOLAS: %d/%d", current_ball, total_balls);
+    ssd1306_draw_string(oled, buffer, 2, 1, true);
+}
+
+/**
+ * @brief Compõe marcadores das canaletas e a bolinha em queda
+ *
+ * @param oled Ponteiro para estrutura do display
+ * @param bins Array com contagem de bolas em cada bin
+ * @param num_bins Número de bins
+ * @param ball Bolinha em queda (NULL para não desenhar)
+ */
+void galton_render_board(ssd1306_t *oled, const int bins[], int num_bins, const ball_position_t *ball)
+{
+    int canaleta_y = BOARD_START_Y + NUM_LEVELS * BOARD_SPACING;
+    int canaleta_width = BOARD_SPACING - 1;
+    int start_x = canaletas_x(num_bins);
+
+    for (int i = 0; i < num_bins; i++)
+    {
+        if (bins[i] > 0)
+        {
+            int x = start_x + i * BOARD_SPACING;
+            blit_sprite(oled->buffer, &sprite_marker, x + canaleta_width / 2, canaleta_y + 4);
+        }
+    }
+
+    if (ball != NULL && ball->active)
+    {
+        /* Posição y interpolada entre níveis baseada nos passos */
+        int y = BOARD_START_Y + ball->current_level * BOARD_SPACING - BOARD_SPACING +
+                (ball->steps * BOARD_SPACING / 3);
+
+        int pins_in_level = ball->current_level + 1;
+        int level_start_x = BOARD_START_X - (pins_in_level * BOARD_SPACING) / 2;
+        int x = level_start_x + ball->position * BOARD_SPACING;
+
+        blit_sprite(oled->buffer, &sprite_ball, x, y);
+    }
+}
+
+/**
+ * @brief Compõe as barras e os valores do histograma (1 pixel por bola)
+ *
+ * @param oled Ponteiro para estrutura do display
+ * @param bins Array com contagem de bolas em cada bin
+ * @param num_bins Número de bins
+ */
+void galton_render_histogram(ssd1306_t *oled, const int bins[], int num_bins)
+{
+    int hist_x = histogram_x(num_bins);
+
+    for (int bin = 0; bin < num_bins; bin++)
+    {
+        int value = bins[bin];
+        int bar_height = (value > HIST_MAX_BAR_HEIGHT) ? HIST_MAX_BAR_HEIGHT : value;
+        int bar_x = hist_x + (bin * (HIST_BAR_WIDTH + HIST_BAR_GAP));
+
+        if (bar_height > 0)
+        {
+            draw_bar(oled->buffer, bar_x, bar_height);
+        }
+
+        if (value > 0)
+        {
+            /* Três dígitos cabem sob a barra; acima de 999 fica 999 */
+            char num_str[4];
+            snprintf(num_str, sizeof(num_str), "%d", value > 999 ? 999 : value);
+
+            /* Alterna posição vertical para evitar sobreposição de números */
+            int text_y = HIST_Y + HIST_HEIGHT + ((bin % 2 == 0) ? 1 : 8);
+            ssd1306_draw_string(oled, num_str, bar_x - 1, text_y, true);
+        }
+    }
+}
+
+/**
+ * @brief Compõe as barras do histograma normalizadas pelo maior coletor
+ *
+ * @param oled Ponteiro para estrutura do display
+ * @param bins Array com contagem de bolas em cada bin
+ * @param num_bins Número de bins
+ */
+void galton_render_histogram_scaled(ssd1306_t *oled, const uint64_t bins[], int num_bins)
+{
+    int hist_x = histogram_x(num_bins);
+    uint64_t max_value = 0;
+
+    for (int bin = 0; bin < num_bins; bin++)
+    {
+        if (bins[bin] > max_value)
+            max_value = bins[bin];
+    }
+
+    for (int bin = 0; bin < num_bins && max_value > 0; bin++)
+    {
+        int bar_height = (int)((bins[bin] * (uint64_t)HIST_MAX_BAR_HEIGHT) / max_value);
+
+        if (bar_height > 0)
+        {
+            draw_bar(oled->buffer, hist_x + (bin * (HIST_BAR_WIDTH + HIST_BAR_GAP)), bar_height);
+        }
+    }
+}
+
+/**
+ * @brief Monta o quadro completo a partir do estado do módulo galton
+ *
+ * @param oled Ponteiro para estrutura do display
+ */
+void galton_render_frame(ssd1306_t *oled)
+{
+    const ball_position_t *ball = NULL;
+
+    if (galton_get_state() == STATE_RUNNING)
+    {
+        ball = galton_get_ball_position();
+    }
+
+    galton_render_begin_frame(oled);
+    galton_render_stats(oled, galton_get_current_ball(), galton_get_total_balls());
+    galton_render_board(oled, galton_get_bins(), galton_get_num_bins(), ball);
+    galton_render_histogram(oled, galton_get_bins(), galton_get_num_bins());
+}
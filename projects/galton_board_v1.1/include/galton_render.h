@@ -0,0 +1,93 @@
+/**
+ * @file galton_render.h
+ * @brief Renderização em camadas do Galton Board
+ *
+ * A camada estática (pinos, canaletas, base do histograma e título) é
+ * desenhada uma única vez em uma imagem em RAM. Cada quadro começa com uma
+ * cópia dessa imagem e recebe apenas os elementos dinâmicos: bolinha em
+ * queda e marcadores das canaletas (sprites pré-calculados), barras,
+ * números e estatísticas.
+ *
+ * @author Jorge Wilker
+ * @date Maio 2025
+ */
+
+#ifndef GALTON_RENDER_H
+#define GALTON_RENDER_H
+
+#include <stdint.h>
+#include "ssd1306_i2c.h"
+#include "galton.h"
+
+/**
+ * @brief Desenha a camada estática e guarda a imagem de fundo
+ *
+ * Usa o buffer do display como área de trabalho (o conteúdo anterior é
+ * descartado). Deve ser chamada uma vez, após ssd1306_init().
+ *
+ * @param oled Ponteiro para estrutura do display
+ */
+void galton_render_init(ssd1306_t *oled);
+
+/**
+ * @brief Inicia um quadro copiando a imagem de fundo para o buffer
+ *
+ * Substitui ssd1306_clear() + redesenho das partes fixas.
+ *
+ * @param oled Ponteiro para estrutura do display
+ */
+void galton_render_begin_frame(ssd1306_t *oled);
+
+/**
+ * @brief Escreve o contador de bolas na linha de status
+ *
+ * @param oled Ponteiro para estrutura do display
+ * @param current_ball Número da bola atual
+ * @param total_balls Número total de bolas na simulação
+ */
+void galton_render_stats(ssd1306_t *oled, int current_ball, int total_balls);
+
+/**
+ * @brief Compõe os elementos dinâmicos do tabuleiro
+ *
+ * Marca as canaletas que já receberam bolas e, no estado de execução,
+ * desenha a bolinha em queda.
+ *
+ * @param oled Ponteiro para estrutura do display
+ * @param bins Array com contagem de bolas em cada bin
+ * @param num_bins Número de bins
+ * @param ball Bolinha em queda (NULL para não desenhar)
+ */
+void galton_render_board(ssd1306_t *oled, const int bins[], int num_bins, const ball_position_t *ball);
+
+/**
+ * @brief Compõe as barras e os valores do histograma (1 pixel por bola)
+ *
+ * @param oled Ponteiro para estrutura do display
+ * @param bins Array com contagem de bolas em cada bin
+ * @param num_bins Número de bins
+ */
+void galton_render_histogram(ssd1306_t *oled, const int bins[], int num_bins);
+
+/**
+ * @brief Compõe as barras do histograma normalizadas pelo maior coletor
+ *
+ * Usada no modo Monte Carlo, em que as contagens chegam a milhões; os
+ * valores numéricos são omitidos.
+ *
+ * @param oled Ponteiro para estrutura do display
+ * @param bins Array com contagem de bolas em cada bin
+ * @param num_bins Número de bins
+ */
+void galton_render_histogram_scaled(ssd1306_t *oled, const uint64_t bins[], int num_bins);
+
+/**
+ * @brief Monta o quadro completo a partir do estado do módulo galton
+ *
+ * Equivale a begin_frame + stats + board + histogram.
+ *
+ * @param oled Ponteiro para estrutura do display
+ */
+void galton_render_frame(ssd1306_t *oled);
+
+#endif // GALTON_RENDER_H
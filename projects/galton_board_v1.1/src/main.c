@@ -18,22 +18,24 @@
 /* Inclusão dos módulos do projeto */
 #include "../include/ssd1306_i2c.h"
 #include "../include/galton.h"
+#include "../include/galton_render.h"
+#include "botoes_irq.h"
+#if GALTON_DUAL_CORE
+#include "../include/galton_mc.h"
+#endif
 
 /**
  * @brief Definição dos pinos GPIO para os botões
  */
-const uint BUTTON_PIN_A = 5; /**< Pino GPIO para o botão A (iniciar) */
-const uint BUTTON_PIN_B = 6; /**< Pino GPIO para o botão B (reiniciar) */
+const uint BUTTON_PINS[] = {5, 6}; /**< Botão A (iniciar) e botão B (reiniciar) */
+#define BUTTON_A 0                 /**< Índice do botão A em BUTTON_PINS */
+#define BUTTON_B 1                 /**< Índice do botão B em BUTTON_PINS */
 
 /**
- * @brief Variáveis para controle e debounce dos botões
+ * @brief Flags de pressão da iteração atual do laço
  */
-static absolute_time_t last_press_time_a = {0}; /**< Timestamp da última pressão do botão A */
-static absolute_time_t last_press_time_b = {0}; /**< Timestamp da última pressão do botão B */
-static bool button_last_state_a = false;        /**< Estado anterior do botão A */
-static bool button_last_state_b = false;        /**< Estado anterior do botão B */
-static bool button_a_was_pressed = false;       /**< Flag indicando evento de pressão do botão A */
-static bool button_b_was_pressed = false;       /**< Flag indicando evento de pressão do botão B */
+static bool button_a_was_pressed = false; /**< Flag indicando evento de pressão do botão A */
+static bool button_b_was_pressed = false; /**< Flag indicando evento de pressão do botão B */
 
 /**
  * @brief Array local para armazenar contadores de bins
@@ -57,65 +59,49 @@ ssd1306_t display;
 /**
  * @brief Inicializa os botões de controle
  *
- * Configura os pinos GPIO dos botões como entradas com pull-up
- * e inicializa as variáveis de estado.
+ * Configura os pinos com pull-up e a interrupção das duas bordas; o debounce
+ * e os gestos ficam no módulo compartilhado (comum/botoes).
  */
 void buttons_init(void)
 {
-    /* Configura os pinos dos botões como entrada com resistor de pull-up interno */
-    gpio_init(BUTTON_PIN_A);
-    gpio_set_dir(BUTTON_PIN_A, GPIO_IN);
-    gpio_pull_up(BUTTON_PIN_A); /* Habilita o resistor pull-up interno */
+    botoes_iniciar(BUTTON_PINS, 2, 0); /* Sem acorde: nenhuma pressão é retida */
 
-    gpio_init(BUTTON_PIN_B);
-    gpio_set_dir(BUTTON_PIN_B, GPIO_IN);
-    gpio_pull_up(BUTTON_PIN_B); /* Habilita o resistor pull-up interno */
-
-    printf("Botões inicializados (A: GPIO%d, B: GPIO%d).\n", BUTTON_PIN_A, BUTTON_PIN_B);
+    printf("Botões inicializados (A: GPIO%d, B: GPIO%d).\n", BUTTON_PINS[BUTTON_A], BUTTON_PINS[BUTTON_B]);
 }
 
 /**
  * @brief Atualiza o estado dos botões
  *
- * Lê o estado atual dos botões, implementa debounce para evitar leituras
- * falsas, e atualiza os flags de evento de pressão.
+ * Consome os gestos gerados a partir das bordas marcadas pela interrupção e
+ * atualiza os flags de evento de pressão. A pressão é detectada no instante
+ * da borda, mesmo com o laço ocupado no envio do quadro por I2C.
  *
- * @note Deve ser chamada periodicamente no loop principal
+ * @note Deve ser chamada uma vez por iteração do loop principal
  */
 void buttons_update(void)
 {
-    /* Verifica o estado atual dos botões (pressionado = LOW, liberado = HIGH) */
-    bool button_pressed_a = !gpio_get(BUTTON_PIN_A); /* Botão A pressionado = nível baixo (0) */
-    bool button_pressed_b = !gpio_get(BUTTON_PIN_B); /* Botão B pressionado = nível baixo (0) */
+    botao_evento_t event;
 
     /* Reseta os flags de evento de pressão */
     button_a_was_pressed = false;
     button_b_was_pressed = false;
 
-    /* Verifica se o botão A foi pressionado e realiza o debounce */
-    if (button_pressed_a && !button_last_state_a &&
-        absolute_time_diff_us(last_press_time_a, get_absolute_time()) > 200000)
-    {                                            /* 200 ms de debounce */
-        last_press_time_a = get_absolute_time(); /* Atualiza o tempo da última pressão */
-        button_last_state_a = true;              /* Atualiza o estado do botão */
-        button_a_was_pressed = true;             /* Indica que o botão foi pressionado */
-    }
-    else if (!button_pressed_a)
-    {
-        button_last_state_a = false; /* Atualiza o estado do botão como liberado */
-    }
-
-    /* Verifica se o botão B foi pressionado e realiza o debounce */
-    if (button_pressed_b && !button_last_state_b &&
-        absolute_time_diff_us(last_press_time_b, get_absolute_time()) > 200000)
-    {                                            /* 200 ms de debounce */
-        last_press_time_b = get_absolute_time(); /* Atualiza o tempo da última pressão */
-        button_last_state_b = true;              /* Atualiza o estado do botão */
-        button_b_was_pressed = true;             /* Indica que o botão foi pressionado */
-    }
-    else if (!button_pressed_b)
+    while (botoes_ler(&event))
     {
-        button_last_state_b = false; /* Atualiza o estado do botão como liberado */
+        if (event.gesto != BOTAO_PRESSIONADO)
+        {
+            continue;
+        }
+        if (event.botao == BUTTON_A)
+        {
+            button_a_was_pressed = true;
+        }
+        else
+        {
+            button_b_was_pressed = true;
+        }
+        printf("Botão %c (latência %llu us)\n", event.botao == BUTTON_A ? 'A' : 'B',
+               (unsigned long long)(time_us_64() - event.instante_us));
     }
 }
 
@@ -157,6 +143,10 @@ void display_init(void)
 
     /* Inicializa o display OLED */
     ssd1306_init(&display, I2C_PORT, SSD1306_I2C_ADDR);
+
+    /* Monta uma única vez a camada estática do tabuleiro */
+    galton_render_init(&display);
+
     ssd1306_clear(&display);
     ssd1306_display(&display);
 
@@ -177,182 +167,6 @@ void display_draw_text(const char *text, int x, int y)
     ssd1306_draw_string(&display, text, x, y, true);
 }
 
-/**
- * @brief Desenha a estrutura do Galton Board no display
- *
- * Renderiza os pinos, canaletas e bolas do Galton Board, bem como
- * a bolinha em movimento quando aplicável.
- *
- * @param num_levels Número de níveis do Galton Board
- */
-void display_draw_galton_board(int num_levels)
-{
-    /* Configurações de posicionamento do Galton Board */
-    int start_x = 42; /* Posição central em X */
-    int start_y = 12; /* Margem superior */
-    int spacing = 6;  /* Espaçamento entre pinos */
-
-    /* Desenha os pinos de cada nível em formato triangular */
-    for (int level = 0; level < num_levels; level++)
-    {
-        int y = start_y + level * spacing;
-        int pins_in_level = level + 1;
-        int level_width = pins_in_level * spacing;
-        int level_start_x = start_x - level_width / 2;
-
-        for (int pin = 0; pin < pins_in_level; pin++)
-        {
-            int x = level_start_x + pin * spacing;
-            ssd1306_draw_circle(&display, x, y, 1, true, true);
-        }
-    }
-
-    /* Desenha as canaletas (bins) abaixo dos pinos */
-    int canaleta_y = start_y + num_levels * spacing;
-    int num_canaletas = num_levels + 1;
-    int canaleta_width = spacing - 1;
-    int canaletas_start_x = start_x - (num_canaletas * spacing) / 2 + 1;
-
-    /* Obtém contagem atual de bolas nos bins para visualização */
-    int *bins = galton_get_bins();
-
-    /* Desenha cada canaleta com indicação visual se contiver bolas */
-    for (int i = 0; i < num_canaletas; i++)
-    {
-        int x = canaletas_start_x + i * spacing;
-
-        /* Desenha a canaleta como um retângulo vertical */
-        ssd1306_draw_rect(&display, x, canaleta_y, canaleta_width, 8, true, false);
-
-        /* Desenha linhas verticais para os lados da canaleta */
-        ssd1306_draw_line(&display, x, canaleta_y, x, canaleta_y + 8, true);
-        ssd1306_draw_line(&display, x + canaleta_width - 1, canaleta_y, x + canaleta_width - 1, canaleta_y + 8, true);
-
-        /* Adiciona uma bolinha na canaleta se houver bolas neste bin */
-        if (bins[i] > 0)
-        {
-            int ball_x = x + canaleta_width / 2;
-            int ball_y = canaleta_y + 4; /* Centraliza na canaleta */
-            ssd1306_draw_circle(&display, ball_x, ball_y, 1, true, true);
-        }
-    }
-
-    /* Desenha a bolinha em queda, se estiver no estado de execução */
-    if (galton_get_state() == STATE_RUNNING)
-    {
-        const ball_position_t *ball = galton_get_ball_position();
-
-        if (ball->active)
-        {
-            /* Obtém informações de posição da bolinha */
-            int level = ball->current_level;
-            int position = ball->position;
-            int steps = ball->steps;
-
-            /* Calcula a posição y inicial do nível */
-            int level_y = start_y + (level * spacing);
-
-            /* Calcula posição y interpolada entre níveis baseada nos passos */
-            int y = level_y - spacing + (steps * spacing / 3);
-
-            /* Calcula quantidade de pinos no nível atual */
-            int pins_in_level = level + 1;
-            int level_width = pins_in_level * spacing;
-            int level_start_x = start_x - level_width / 2;
-
-            /* Calcula a posição x baseada na posição dentro do nível */
-            int x = level_start_x + (position * spacing);
-
-            /* Desenha a bolinha em movimento com tamanho maior para destaque */
-            ssd1306_draw_circle(&display, x, y, 2, true, true);
-        }
-    }
-}
-
-/**
- * @brief Desenha o histograma com as contagens de bolas
- *
- * Cria uma visualização gráfica da distribuição das bolas nos bins,
- * com valores numéricos e barras proporcionais.
- *
- * @param bins Array com contagem de bolas em cada bin
- * @param num_bins Número de bins a serem exibidos
- * @param max_balls Valor máximo de bolas em um único bin (para normalização)
- */
-void display_draw_bins(int bins[], int num_bins, int max_balls)
-{
-    /* Dimensões e posição do histograma no display */
-    int hist_width = 30;  /* Largura da área do histograma */
-    int hist_height = 35; /* Altura da área do histograma */
-    int hist_x = 94;      /* Posição X inicial (otimizado para layout) */
-    int hist_y = 15;      /* Posição Y inicial */
-    int bar_gap = 2;      /* Espaçamento entre barras */
-    int bar_width = 2;    /* Largura de cada barra */
-
-    /* Calcula a largura total necessária para todas as barras */
-    int total_width = (bar_width * num_bins) + (bar_gap * (num_bins - 1));
-
-    /* Centraliza o histograma dentro do espaço disponível */
-    hist_x = 128 - total_width - 4; /* 4 pixels de margem à direita */
-
-    /* Desenha o quadro do histograma */
-    ssd1306_draw_rect(&display, hist_x - 2, hist_y, total_width + 4, hist_height, true, false);
-
-    /* Desenha uma linha horizontal na base */
-    ssd1306_draw_line(&display, hist_x - 2, hist_y + hist_height - 1,
-                      hist_x + total_width + 1, hist_y + hist_height - 1, true);
-
-    /* Desenha as barras do histograma */
-    for (int bin = 0; bin < num_bins; bin++)
-    {
-        int value = bins[bin];
-
-        /* Calcula altura proporcional para a barra (otimizado para display OLED) */
-        int pixels_per_ball = 1;              /* Fator de escala: 1 pixel por bola */
-        int max_bar_height = hist_height - 5; /* Altura máxima para visualização */
-
-        int bar_height = value * pixels_per_ball;
-
-        /* Limita a altura máxima para caber no display */
-        if (bar_height > max_bar_height)
-            bar_height = max_bar_height;
-
-        /* Posição X de cada barra */
-        int bar_x = hist_x + (bin * (bar_width + bar_gap));
-
-        /* Desenha a barra (de baixo para cima) se houver valor */
-        if (bar_height > 0)
-        {
-            ssd1306_draw_rect(&display, bar_x, hist_y + hist_height - 2 - bar_height,
-                              bar_width, bar_height, true, true);
-        }
-
-        /* Adiciona o valor numérico do bin como legenda */
-        if (value > 0)
-        {
-            char num_str[4];
-            snprintf(num_str, sizeof(num_str), "%d", value);
-
-            /* Alterna posição vertical para evitar sobreposição de números */
-            int text_y;
-            if (bin % 2 == 0)
-            {
-                text_y = hist_y + hist_height + 1; /* Logo abaixo do histograma */
-            }
-            else
-            {
-                text_y = hist_y + hist_height + 8; /* Linha inferior para números alternados */
-            }
-
-            /* Centra número em relação à barra */
-            display_draw_text(num_str, bar_x - 1, text_y);
-        }
-    }
-
-    /* Adiciona título ao histograma */
-    display_draw_text("HISTOGRAMA", hist_x + 2, hist_y - 9);
-}
-
 /**
  * @brief Exibe a tela de boas-vindas
  *
@@ -367,22 +181,6 @@ void display_show_welcome_screen(void)
     ssd1306_display(&display);
 }
 
-/**
- * @brief Exibe estatísticas da simulação
- *
- * Mostra o contador de bolas atual e total na parte superior da tela.
- *
- * @param current_ball Número da bola atual
- * @param total_balls Número total de bolas na simulação
- */
-void display_show_stats(int current_ball, int total_balls)
-{
-    char buffer[16];
-    snprintf(buffer, sizeof(buffer), "BOLAS: %d/%d", current_ball, total_balls);
-    ssd1306_draw_rect(&display, 0, 0, 128, 10, true, false); /* Limpa área de status */
-    display_draw_text(buffer, 2, 1);                         /* Exibe contador na parte superior */
-}
-
 /**
  * @brief Exibe mensagem de conclusão da simulação
  *
@@ -401,6 +199,84 @@ void display_show_simulation_complete(void)
     ssd1306_display(&display);
 }
 
+#if GALTON_DUAL_CORE
+/**
+ * @brief Laço principal do modo Monte Carlo em dois núcleos
+ *
+ * O núcleo 1 simula GALTON_MC_TOTAL_BALLS bolas em lotes; este laço
+ * (núcleo 0) trata os botões e redesenha a tela a cada GALTON_MC_FRAME_MS
+ * a partir do último instantâneo consistente. Ao final, a execução é
+ * conferida contra uma simulação de núcleo único com a mesma semente.
+ */
+void run_monte_carlo_mode(void)
+{
+    static galton_mc_snapshot_t snapshot;
+    bool running = false;
+    bool verified = false;
+    absolute_time_t next_frame = get_absolute_time();
+
+    galton_mc_init();
+    display_show_welcome_screen();
+
+    while (true)
+    {
+        buttons_update();
+
+        if (button_a_pressed() && !running)
+        {
+            uint32_t seed = time_us_32();
+            printf("Monte Carlo: %d bolas, semente %lu\n", GALTON_MC_TOTAL_BALLS, (unsigned long)seed);
+            galton_mc_start(seed, GALTON_MC_TOTAL_BALLS);
+            running = true;
+            verified = false;
+        }
+
+        if (button_b_pressed() && running)
+        {
+            printf("Reiniciando simulação...\n");
+            galton_mc_start(0, 0);
+            running = false;
+            display_show_welcome_screen();
+        }
+
+        /* Taxa de quadros fixa, independente da vazão do núcleo 1 */
+        if (time_reached(next_frame))
+        {
+            next_frame = delayed_by_ms(next_frame, GALTON_MC_FRAME_MS);
+
+            if (running && galton_mc_read(&snapshot))
+            {
+                bool complete = snapshot.balls_done >= snapshot.target_balls;
+                char buffer[24];
+
+                galton_render_begin_frame(&display);
+                snprintf(buffer, sizeof(buffer), "BOLAS: %llu", (unsigned long long)snapshot.balls_done);
+                display_draw_text(buffer, 2, 1);
+                galton_render_histogram_scaled(&display, snapshot.bins, NUM_BINS);
+
+                if (complete && !verified)
+                {
+                    verified = true;
+                    printf("Conferência com núcleo único: %s\n",
+                           galton_mc_verify(&snapshot) ? "IDENTICO" : "DIVERGENTE");
+                }
+
+                if (complete)
+                {
+                    display_show_simulation_complete();
+                }
+                else
+                {
+                    ssd1306_display(&display);
+                }
+            }
+        }
+
+        /* Dorme até o próximo quadro ou até um botão */
+        botoes_esperar(to_us_since_boot(next_frame));
+    }
+}
+#endif
 /**
  * @brief Função principal
  *
@@ -424,9 +300,16 @@ int main()
     display_init();
     galton_init();
 
+#if GALTON_DUAL_CORE
+    /* Modo Monte Carlo: núcleo 1 simula, núcleo 0 renderiza */
+    run_monte_carlo_mode();
+#endif
+
     /* Mostra a tela de boas-vindas */
     display_show_welcome_screen();
 
+    bool complete_screen_drawn = false; /* Tela final já enviada ao display */
+
     /* Loop principal */
     while (true)
     {
@@ -449,11 +332,8 @@ int main()
             /* Estado de execução: processa a simulação e atualiza o display */
             galton_update();
 
-            /* Renderiza a interface completa a cada ciclo */
-            ssd1306_clear(&display);
-            display_show_stats(galton_get_current_ball(), galton_get_total_balls());
-            display_draw_galton_board(NUM_LEVELS);
-            display_draw_bins(galton_get_bins(), galton_get_num_bins(), galton_get_max_bin_value());
+            /* Renderiza o quadro: fundo pré-calculado + elementos dinâmicos */
+            galton_render_frame(&display);
             ssd1306_display(&display);
 
             /* Botão B reseta a simulação mesmo durante a execução */
@@ -466,13 +346,13 @@ int main()
             break;
 
         case STATE_COMPLETE:
-            /* Estado de conclusão: exibe resultados finais */
-            ssd1306_clear(&display); /* Limpa o display para atualização completa */
-            display_show_stats(galton_get_current_ball(), galton_get_total_balls());
-            display_draw_galton_board(NUM_LEVELS);
-            display_draw_bins(galton_get_bins(), galton_get_num_bins(), galton_get_max_bin_value());
-            display_show_simulation_complete();
-            ssd1306_display(&display); /* Atualiza o display explicitamente */
+            /* Estado de conclusão: exibe resultados finais uma única vez */
+            if (!complete_screen_drawn)
+            {
+                galton_render_frame(&display); /* Quadro completo a partir do fundo pré-calculado */
+                display_show_simulation_complete();
+                complete_screen_drawn = true;
+            }
 
             /* Botão B reinicia a simulação */
             if (button_b_pressed())
@@ -480,12 +360,21 @@ int main()
                 printf("Reiniciando simulação...\n");
                 galton_reset();
                 display_show_welcome_screen();
+                complete_screen_drawn = false;
             }
             break;
         }
 
-        /* Pequena pausa para economia de recursos */
-        sleep_ms(10);
+        if (galton_get_state() == STATE_RUNNING)
+        {
+            /* Pequena pausa entre quadros da simulação */
+            sleep_ms(10);
+        }
+        else
+        {
+            /* Tela parada: dorme (__wfi) até um botão */
+            botoes_esperar(BOTOES_SEM_PRAZO);
+        }
     }
 
     return 0;
@@ -1,8 +1,9 @@
 #include "temperature.h"
 
 // Constantes da fórmula
+// Um LSB do ADC de 12 bits vale Vref / 2^12 (datasheet do RP2040, 4.9.5)
 const float ADC_VOLTAGE_REF = 3.3f;
-const float ADC_RESOLUTION = 4095.0f;
+const float ADC_RESOLUTION = 4096.0f;
 const float ADC_TEMP_OFFSET = 0.706f;
 const float ADC_TEMP_SLOPE = 0.001721f;
 
@@ -6,6 +6,9 @@
 /**
  * @brief Converte o valor lido pelo ADC do sensor de temperatura interno para graus Celsius.
  *
+ * Referência em float para a conversão em ponto fixo de
+ * comum/temperatura/temperatura.c, que é a usada no firmware.
+ *
  * @param adc_val O valor bruto de 12 bits lido do ADC.
  * @return A temperatura em graus Celsius.
  */
@@ -10,19 +10,14 @@
 // Definir o tipo para números de linha
 #define UNITY_LINE_TYPE unsigned int
 
-// Definir o tipo para inteiros COM SINAL
-#define UNITY_INT int32_t
-// #define UNITY_INT_WIDTH 32 // Unity pode usar isso internamente
-// #define UNITY_FIXTURE_INT_WIDTH 32
-
-// Definir o tipo para inteiros SEM SINAL
-#define UNITY_UINT uint32_t
-#define UNITY_UINT8 uint8_t
-// #define UNITY_UINT_WIDTH 32 // Unity pode usar isso internamente
-
-// Definir o tipo para ponto flutuante
-#define UNITY_FLOAT float
-// #define UNITY_FIXTURE_FLOAT_WIDTH 32 // Unity pode usar isso internamente
+// Larguras dos tipos no RP2040 (Cortex-M0+, 32 bits)
+// O Unity cria os próprios typedefs (UNITY_INT, UNITY_UINT, UNITY_FLOAT...) a
+// partir das larguras; definir esses nomes como macros (#define UNITY_UINT
+// uint32_t) transformava o typedef interno em "typedef ... uint32_t" e era a
+// origem do erro "conflicting types" do Pico SDK
+#define UNITY_INT_WIDTH 32
+#define UNITY_LONG_WIDTH 32
+#define UNITY_POINTER_WIDTH 32
 
 // --- Saída do Unity ---
 // Como o Unity deve imprimir strings. Usaremos printf padrão via stdio.
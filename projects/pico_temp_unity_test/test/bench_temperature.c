@@ -0,0 +1,99 @@
+// Custo por conversão: float (adc_to_celsius) contra ponto fixo (temperatura.c)
+// No Pico conta ciclos com o SysTick (24 bits, clock do processador); no host
+// (TEMP_TEST_HOST) mede nanossegundos, só como referência: o x86 tem FPU e não
+// mostra o custo do float por software do M0+
+// Autor: Jorge Wilker Mamede de Andrade - 2025
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "temperature.h"
+#include "temperatura.h"
+
+#ifdef TEMP_TEST_HOST
+#include <time.h>
+#define REPETICOES      2000000u
+#define UNIDADE         "ns"
+
+static uint64_t agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t decorrido(uint64_t inicio, uint64_t fim) {
+    return fim - inicio;
+}
+#else
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+#define REPETICOES      4096u           // Cabe nos 24 bits do SysTick
+#define UNIDADE         "ciclos"
+
+static uint64_t agora(void) {
+    return systick_hw->cvr;             // Conta para baixo
+}
+
+static uint64_t decorrido(uint64_t inicio, uint64_t fim) {
+    return (inicio - fim) & 0x00FFFFFFu;
+}
+#endif
+
+static volatile int32_t sorvedouro;     // Impede o compilador de descartar o laço
+static volatile float sorvedouro_float;
+
+// Leituras na faixa usual do sensor (~0 °C a ~60 °C), variando a cada chamada
+#define LEITURA(i)      ((uint16_t)(820 + ((i) & 127)))
+
+static void medir(const char *nome, uint64_t total, uint32_t chamadas) {
+    printf("%-28s %8.2f %s/conversao\n", nome, (double)total / chamadas, UNIDADE);
+}
+
+int main(void) {
+#ifndef TEMP_TEST_HOST
+    stdio_init_all();
+    sleep_ms(2000);
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->csr = 0x5;              // Liga, clock do processador, sem interrupção
+#endif
+    uint16_t leituras[TEMPERATURA_AMOSTRAS];
+    uint64_t inicio;
+
+    for (uint32_t i = 0; i < TEMPERATURA_AMOSTRAS; i++) {
+        leituras[i] = LEITURA(i);
+    }
+
+    inicio = agora();
+    for (uint32_t i = 0; i < REPETICOES; i++) {
+        sorvedouro_float = adc_to_celsius(LEITURA(i));
+    }
+    medir("float (adc_to_celsius)", decorrido(inicio, agora()), REPETICOES);
+
+    inicio = agora();
+    for (uint32_t i = 0; i < REPETICOES; i++) {
+        sorvedouro = temperatura_centi_de_adc(LEITURA(i));
+    }
+    medir("ponto fixo, 1 leitura", decorrido(inicio, agora()), REPETICOES);
+
+    inicio = agora();
+    for (uint32_t i = 0; i < REPETICOES; i++) {
+        sorvedouro = temperatura_centi((uint16_t)(LEITURA(i) * TEMPERATURA_ESCALA + (i & 15)));
+    }
+    medir("ponto fixo, sobreamostrado", decorrido(inicio, agora()), REPETICOES);
+
+    // A soma das 256 leituras (feita uma vez por rajada) entra à parte
+    uint32_t rajadas = REPETICOES / TEMPERATURA_AMOSTRAS;
+    inicio = agora();
+    for (uint32_t i = 0; i < rajadas; i++) {
+        leituras[i % TEMPERATURA_AMOSTRAS] = LEITURA(i);
+        sorvedouro = temperatura_decimar(leituras, TEMPERATURA_AMOSTRAS);
+    }
+    medir("decimacao de 256 leituras", decorrido(inicio, agora()), rajadas);
+
+#ifndef TEMP_TEST_HOST
+    while (true) {
+        sleep_ms(1000);
+    }
+#endif
+    return 0;
+}
@@ -1,10 +1,13 @@
+#ifndef TEMP_TEST_HOST
 #include "pico/stdlib.h"
+#endif
 #include "unity.h"
 #include <math.h>
 #include <stdio.h> // Para printf de debug, se necessário
 
 // Inclui o cabeçalho da função a ser testada
 #include "temperature.h"
+#include "temperatura.h"
 
 // Função setUp (executada antes de cada teste)
 void setUp(void) {
@@ -16,12 +19,20 @@ void tearDown(void) {
     // Nada a limpar por enquanto
 }
 
+// Referência exata em double: código sobreamostrado (leitura * 16) -> centésimos
+// arredondados para o mais próximo
+static int32_t referencia_centi(uint32_t codigo) {
+    double volts = codigo * 3.3 / (4096.0 * TEMPERATURA_ESCALA);
+    double centi = (27.0 - (volts - 0.706) / 0.001721) * 100.0;
+    return (int32_t)floor(centi + 0.5);
+}
+
 // Teste para o valor conhecido (0.706V -> 27°C)
 void test_adc_to_celsius_known_value(void) {
     // 0.706V corresponde a 27°C
-    // V = (adc_val * 3.3) / 4095 => adc_val = (0.706 * 4095) / 3.3
+    // V = (adc_val * 3.3) / 4096 => adc_val = (0.706 * 4096) / 3.3
     // Usando float no cálculo para manter a precisão antes de converter para uint16_t
-    float adc_val_float = (0.706f * 4095.0f) / 3.3f;
+    float adc_val_float = (0.706f * 4096.0f) / 3.3f;
     uint16_t adc_val = (uint16_t)roundf(adc_val_float); // Arredonda para o inteiro mais próximo
 
     float temp = adc_to_celsius(adc_val);
@@ -31,26 +42,128 @@ void test_adc_to_celsius_known_value(void) {
     // printf("Teste executado. ADC: %d, Temp: %f\n", adc_val, temp); // Debug opcional
 }
 
+// Todos os códigos de 16 bits: dentro da faixa o ponto fixo só pode errar o
+// arredondamento quando o valor exato cai a menos de ~0,06 centésimo de um
+// meio centésimo; fora dela satura nos extremos
+void test_centi_exato_contra_referencia(void) {
+    uint32_t exatos = 0, na_faixa = 0;
+
+    for (uint32_t codigo = 0; codigo <= UINT16_MAX; codigo++) {
+        int32_t ref = referencia_centi(codigo);
+        int32_t centi = temperatura_centi((uint16_t)codigo);
+
+        if (ref > TEMPERATURA_MAX_CENTI) {
+            TEST_ASSERT_INT32_WITHIN(1, TEMPERATURA_MAX_CENTI, centi);
+        } else if (ref < TEMPERATURA_MIN_CENTI) {
+            TEST_ASSERT_INT32_WITHIN(1, TEMPERATURA_MIN_CENTI, centi);
+        } else {
+            TEST_ASSERT_INT32_WITHIN(1, ref, centi);
+            na_faixa++;
+            exatos += (centi == ref);
+        }
+    }
+    printf("ponto fixo: %lu de %lu codigos iguais a referencia arredondada\n",
+           (unsigned long)exatos, (unsigned long)na_faixa);
+    TEST_ASSERT_TRUE(exatos * 100 >= na_faixa * 99);
+}
+
+// A conversão de uma leitura concorda com a referência em float
+void test_centi_de_adc_contra_float(void) {
+    for (uint16_t leitura = 620; leitura <= 1060; leitura++) {
+        float referencia = adc_to_celsius(leitura) * 100.0f;
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, referencia, (float)temperatura_centi_de_adc(leitura));
+    }
+}
+
+void test_decimar_arredonda_na_escala_do_codigo(void) {
+    uint16_t leituras[TEMPERATURA_AMOSTRAS];
+
+    for (int i = 0; i < TEMPERATURA_AMOSTRAS; i++) {
+        leituras[i] = 876;
+    }
+    TEST_ASSERT_EQUAL_UINT16(876 * TEMPERATURA_ESCALA, temperatura_decimar(leituras, TEMPERATURA_AMOSTRAS));
+
+    // Metade 876, metade 877: média 876,5 -> código 14024
+    for (int i = 0; i < TEMPERATURA_AMOSTRAS; i += 2) {
+        leituras[i] = 877;
+    }
+    TEST_ASSERT_EQUAL_UINT16(14024, temperatura_decimar(leituras, TEMPERATURA_AMOSTRAS));
+
+    // Extremo: soma de 256 leituras de 4095 sem estouro
+    for (int i = 0; i < TEMPERATURA_AMOSTRAS; i++) {
+        leituras[i] = 4095;
+    }
+    TEST_ASSERT_EQUAL_UINT16(4095 * TEMPERATURA_ESCALA, temperatura_decimar(leituras, TEMPERATURA_AMOSTRAS));
+}
+
+// Uma conversão a cada 100 ms, janela de 1 s: um valor por segundo, com a
+// média arredondada também abaixo de zero
+void test_fluxo_media_por_periodo(void) {
+    temperatura_fluxo_t f;
+    int32_t media = 0;
+    int publicados = 0;
+    int na_janela = 0;
+
+    // 5 s: a conversão de 5000 ms fecha a quinta janela
+    temperatura_fluxo_iniciar(&f, 1000);
+    for (uint32_t t = 0; t <= 5000; t += 100) {
+        int32_t centi = (t / 100) % 2 ? 2501 : 2500;
+        if (temperatura_fluxo_amostra(&f, centi, t, &media)) {
+            publicados++;
+            TEST_ASSERT_EQUAL_INT(10, na_janela);   // Sem a conversão que abre a seguinte
+            TEST_ASSERT_INT32_WITHIN(1, 2500, media);
+            TEST_ASSERT_EQUAL_UINT32(t, f.inicio_ms);
+            na_janela = 0;
+        }
+        na_janela++;
+    }
+    TEST_ASSERT_EQUAL_INT(5, publicados);
+
+    // Conversões atrasadas não empurram a grade: janelas em 0, 1000 e 3000
+    temperatura_fluxo_iniciar(&f, 1000);
+    TEST_ASSERT_FALSE(temperatura_fluxo_amostra(&f, 2500, 0, &media));
+    TEST_ASSERT_TRUE(temperatura_fluxo_amostra(&f, 2500, 1070, &media));
+    TEST_ASSERT_EQUAL_UINT32(1000, f.inicio_ms);
+    TEST_ASSERT_TRUE(temperatura_fluxo_amostra(&f, 2500, 3020, &media));
+    TEST_ASSERT_EQUAL_UINT32(3000, f.inicio_ms);
+
+    temperatura_fluxo_iniciar(&f, 200);
+    TEST_ASSERT_FALSE(temperatura_fluxo_amostra(&f, -101, 0, &media));
+    TEST_ASSERT_FALSE(temperatura_fluxo_amostra(&f, -102, 100, &media));
+    TEST_ASSERT_TRUE(temperatura_fluxo_amostra(&f, -103, 200, &media));
+    TEST_ASSERT_EQUAL_INT32(-102, media);       // -101,5 -> -102, sem o -103
+    TEST_ASSERT_TRUE(f.publicado);
+}
+
 // Função principal que executa os testes
 int main(void) {
+#ifndef TEMP_TEST_HOST
     // Inicializa a comunicação serial
     stdio_init_all();
 
     // Pequeno delay para garantir que a serial esteja pronta
     sleep_ms(2000);
+#endif
     // printf("Iniciando testes Unity...\n"); // Debug opcional
 
     UNITY_BEGIN();
     RUN_TEST(test_adc_to_celsius_known_value);
+    RUN_TEST(test_centi_exato_contra_referencia);
+    RUN_TEST(test_centi_de_adc_contra_float);
+    RUN_TEST(test_decimar_arredonda_na_escala_do_codigo);
+    RUN_TEST(test_fluxo_media_por_periodo);
     int failures = UNITY_END();
 
     // printf("Testes Unity concluídos com %d falhas.\n", failures); // Debug opcional
 
+#ifdef TEMP_TEST_HOST
+    // No host o ctest usa o código de saída
+    return failures;
+#else
     // Loop infinito ou simplesmente retorna o número de falhas
     // Dependendo se você quer que o programa pare ou continue após os testes
     while(true) {
         sleep_ms(1000); // Apenas para não deixar a CPU rodando a 100%
     }
-
-    // return failures; // Alternativa: retornar o número de falhas
-}
\ No newline at end of file
+#endif
+}
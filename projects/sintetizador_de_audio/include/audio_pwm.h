@@ -92,8 +92,8 @@ void audio_clear_buffer(void);
 // Obtém utilização atual do buffer
 uint32_t audio_get_buffer_usage(void);
 
-// Calcula tempo de gravação
-float audio_get_recording_time(void);
+// Calcula tempo de gravação em décimos de segundo
+uint32_t audio_get_recording_tenths(void);
 
 // Extrai dados da forma de onda para visualização
 void audio_get_waveform_data(uint8_t* display_buffer, uint8_t width, uint8_t height);
@@ -336,8 +336,9 @@ uint32_t audio_get_buffer_usage(void) {
     return audio_system.current_pos;
 }
 
-float audio_get_recording_time(void) {
-    return (float)audio_system.current_pos / SAMPLE_RATE;
+uint32_t audio_get_recording_tenths(void) {
+    // Arredondado como o %.1f fazia, só com inteiros
+    return (audio_system.current_pos * 10u + SAMPLE_RATE / 2) / SAMPLE_RATE;
 }
 
 void audio_get_waveform_data(uint8_t* display_buffer, uint8_t width, uint8_t height) {
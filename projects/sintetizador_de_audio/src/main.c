@@ -42,9 +42,10 @@
 
 // Incluir todas as bibliotecas do projeto
 #include "audio_pwm.h"
-#include "buttons.h"
+#include "botoes_irq.h"
 #include "led_rgb.h"
 #include "ssd1306_i2c.h"
+#include "formato.h"
 
 // Definições específicas para compatibilidade com display OLED
 #ifndef SSD1306_WIDTH
@@ -55,6 +56,11 @@
 #define SSD1306_HEIGHT 64
 #endif
 
+// Botões A e B da placa; A+B pressionados juntos formam o acorde de limpar
+static const uint BUTTON_PINS[] = {5, 6};
+#define BUTTON_A 0
+#define BUTTON_B 1
+
 // Estados do sistema
 typedef enum {
     SYSTEM_STARTUP,
@@ -81,6 +87,8 @@ static const rgb_color_t LED_COLOR_OFF = {0, 0, 0};       // Desligado
 void system_init(void);
 void system_update(void);
 void handle_button_events(void);
+void handle_button_a(void);
+void handle_button_b(void);
 void update_display(void);
 void update_leds(void);
 void show_startup_screen(void);
@@ -110,7 +118,12 @@ int main() {
     // Loop principal
     while (true) {
         system_update();
-        sleep_ms(10);  // Pequeno delay para evitar uso excessivo de CPU
+        if (current_system_state == SYSTEM_IDLE) {
+            // Ocioso: dorme (__wfi) até um botão ou a próxima atualização do display
+            botoes_esperar(to_us_since_boot(last_display_update) + 100000);
+        } else {
+            sleep_ms(10);  // Gravação desenha a forma de onda a cada iteração
+        }
     }
     
     return 0;
@@ -120,9 +133,9 @@ int main() {
 void system_init(void) {
     printf("Inicializando subsistemas:\n");
     
-    // Inicializar botões
+    // Inicializar botões (interrupção de borda, A+B como acorde)
     printf("- Botões... ");
-    buttons_init();
+    botoes_iniciar(BUTTON_PINS, 2, (1u << BUTTON_A) | (1u << BUTTON_B));
     printf("OK\n");
     
     // Inicializar LEDs RGB
@@ -156,10 +169,7 @@ void system_init(void) {
 
 // Atualizar sistema principal
 void system_update(void) {
-    // Atualizar estado dos botões
-    buttons_update();
-    
-    // Processar eventos dos botões
+    // Processar os gestos dos botões (bordas marcadas pela interrupção)
     handle_button_events();
     
     // Atualizar callback de áudio para gravação
@@ -186,84 +196,33 @@ void system_update(void) {
 }
 
 // Processar eventos dos botões
+// A e B são retidos por até 50 ms esperando o parceiro do acorde; uma pressão
+// isolada chega como PRESSIONADO com o instante da borda
 void handle_button_events(void) {
-    bool button_a = button_a_pressed();
-    bool button_b = button_b_pressed();
-    bool both_buttons = button_a_held() && button_b_held();
+    botao_evento_t event;
     
-    // Verificar se ambos os botões estão pressionados (limpar buffer)
-    if (both_buttons && current_system_state == SYSTEM_IDLE) {
-        printf("Limpando buffer de áudio...\n");
-        audio_clear_buffer();
-        ssd1306_clear();
-        ssd1306_draw_string_centered(20, "BUFFER LIMPO", true);
-        ssd1306_display();
-        sleep_ms(1000);
-        return;
-    }
-    
-    // Processar botão A (gravação)
-    if (button_a) {
-        switch (current_system_state) {
-            case SYSTEM_IDLE:
-                if (audio_start_recording()) {
-                    current_system_state = SYSTEM_RECORDING;
-                    recording_start_time = get_absolute_time();
-                    recording_duration = 0;
-                    
-                    // Inicializar visualização da forma de onda
-                    ssd1306_waveform_init();
-                    printf("Gravação iniciada com visualização da forma de onda\n");
-                } else {
-                    show_error_message("Erro ao iniciar gravacao");
-                }
-                break;
-                
-            case SYSTEM_RECORDING:
-                printf("Parando gravação...\n");
-                audio_stop_recording();
-                current_system_state = SYSTEM_IDLE;
-                printf("Gravação finalizada - %d amostras\n", audio_get_buffer_usage());
-                break;
-                
-            case SYSTEM_PLAYING:
-                // Não fazer nada durante reprodução
-                break;
-                
-            default:
-                break;
+    while (botoes_ler(&event)) {
+        if (event.gesto != BOTAO_PRESSIONADO && event.gesto != BOTAO_ACORDE) {
+            continue;
         }
-    }
-    
-    // Processar botão B (reprodução)
-    if (button_b) {
-        switch (current_system_state) {
-            case SYSTEM_IDLE:
-                if (audio_get_buffer_usage() > 0) {
-                    printf("Iniciando reprodução...\n");
-                    if (audio_start_playback()) {
-                        current_system_state = SYSTEM_PLAYING;
-                    } else {
-                        show_error_message("Erro ao iniciar reproducao");
-                    }
-                } else {
-                    show_error_message("Nenhum audio gravado");
-                    sleep_ms(1500);
-                }
-                break;
-                
-            case SYSTEM_PLAYING:
-                printf("Parando reprodução...\n");
-                audio_stop_playback();
-                current_system_state = SYSTEM_IDLE;
-                break;
-                
-            case SYSTEM_RECORDING:
-                // Não fazer nada durante gravação
-                break;
-                
-            default:
-                break;
+        printf("Botão %s (latência %llu us)\n",
+               event.gesto == BOTAO_ACORDE ? "A+B" : (event.botao == BUTTON_A ? "A" : "B"),
+               (unsigned long long)(time_us_64() - event.instante_us));
+        
+        // Acorde A+B (limpar buffer)
+        if (event.gesto == BOTAO_ACORDE) {
+            if (current_system_state == SYSTEM_IDLE) {
+                printf("Limpando buffer de áudio...\n");
+                audio_clear_buffer();
+                ssd1306_clear();
+                ssd1306_draw_string_centered(20, "BUFFER LIMPO", true);
+                ssd1306_display();
+                sleep_ms(1000);
+            }
+        } else if (event.botao == BUTTON_A) {
+            handle_button_a();
+        } else {
+            handle_button_b();
         }
     }
     
@@ -274,6 +233,71 @@ void handle_button_events(void) {
     }
 }
 
+// Processar botão A (gravação)
+void handle_button_a(void) {
+    switch (current_system_state) {
+        case SYSTEM_IDLE:
+            if (audio_start_recording()) {
+                current_system_state = SYSTEM_RECORDING;
+                recording_start_time = get_absolute_time();
+                recording_duration = 0;
+                
+                // Inicializar visualização da forma de onda
+                ssd1306_waveform_init();
+                printf("Gravação iniciada com visualização da forma de onda\n");
+            } else {
+                show_error_message("Erro ao iniciar gravacao");
+            }
+            break;
+            
+        case SYSTEM_RECORDING:
+            printf("Parando gravação...\n");
+            audio_stop_recording();
+            current_system_state = SYSTEM_IDLE;
+            printf("Gravação finalizada - %d amostras\n", audio_get_buffer_usage());
+            break;
+            
+        case SYSTEM_PLAYING:
+            // Não fazer nada durante reprodução
+            break;
+            
+        default:
+            break;
+    }
+}
+
+// Processar botão B (reprodução)
+void handle_button_b(void) {
+    switch (current_system_state) {
+        case SYSTEM_IDLE:
+            if (audio_get_buffer_usage() > 0) {
+                printf("Iniciando reprodução...\n");
+                if (audio_start_playback()) {
+                    current_system_state = SYSTEM_PLAYING;
+                } else {
+                    show_error_message("Erro ao iniciar reproducao");
+                }
+            } else {
+                show_error_message("Nenhum audio gravado");
+                sleep_ms(1500);
+            }
+            break;
+            
+        case SYSTEM_PLAYING:
+            printf("Parando reprodução...\n");
+            audio_stop_playback();
+            current_system_state = SYSTEM_IDLE;
+            break;
+            
+        case SYSTEM_RECORDING:
+            // Não fazer nada durante gravação
+            break;
+            
+        default:
+            break;
+    }
+}
+
 // Atualizar display OLED
 void update_display(void) {
     ssd1306_clear();
@@ -293,8 +317,11 @@ void update_display(void) {
             // Mostrar informações do buffer se houver áudio gravado
             if (audio_get_buffer_usage() > 0) {
                 char buffer_info[32];
-                float duration = audio_get_recording_time();
-                snprintf(buffer_info, sizeof(buffer_info), "AUDIO: %.1fS", duration);
+                formato_t f;
+                formato_iniciar(&f, buffer_info, sizeof(buffer_info));
+                formato_texto(&f, "AUDIO: ");
+                formato_decimal(&f, (int32_t)audio_get_recording_tenths(), 1, 0);
+                formato_caractere(&f, 'S');
                 ssd1306_draw_string(10, 55, buffer_info, true);
             }
             break;
@@ -307,7 +334,8 @@ void update_display(void) {
             char time_str[16];
             uint32_t minutes = recording_duration / 60;
             uint32_t seconds = recording_duration % 60;
-            snprintf(time_str, sizeof(time_str), "%02d:%02d", minutes, seconds);
+            formato_snprintf(time_str, sizeof(time_str), "%02lu:%02lu",
+                             (unsigned long)minutes, (unsigned long)seconds);
             ssd1306_draw_string_centered(20, time_str, true);
             
             // Mostrar indicador de gravação
@@ -328,9 +356,12 @@ void update_display(void) {
             ssd1306_draw_string_centered(30, "B - PARAR", true);
             
             // Mostrar informações do áudio
-            float duration = audio_get_recording_time();
             char info_str[32];
-            snprintf(info_str, sizeof(info_str), "DURACAO: %.1fS", duration);
+            formato_t f;
+            formato_iniciar(&f, info_str, sizeof(info_str));
+            formato_texto(&f, "DURACAO: ");
+            formato_decimal(&f, (int32_t)audio_get_recording_tenths(), 1, 0);
+            formato_caractere(&f, 'S');
             ssd1306_draw_string_centered(45, info_str, true);
             break;
             
@@ -1,7 +1,6 @@
 // Bibliotecas necessárias
 #include <string.h>                 // Para funções de string como strlen()
-#include <stdio.h>                  // Para sprintf e printf
-#include <stdlib.h>                 // Para usar atof()
+#include <stdio.h>                  // Para printf
 #include <time.h>                   // Para usar a função time() para timestamps
 #include "pico/stdlib.h"            // Biblioteca padrão do Pico (GPIO, tempo, etc.)
 #include "pico/cyw43_arch.h"        // Driver WiFi para Pico W
@@ -11,6 +10,7 @@
 #include "../include/mqtt_comm.h"   // Funções personalizadas para MQTT
 #include "../include/xor_cipher.h"  // Funções de cifra XOR
 #include "../include/ssd1306_i2c.h" // Driver do display OLED
+#include "formato.h"                // Formatação só com inteiros (projects/comum/formato)
 
 /**
  * @brief Configurações do hardware para comunicação I2C com o display OLED
@@ -70,12 +70,13 @@ void display_draw_text(const char *text, int x, int y)
  *
  * @param wifi_status Status da conexão WiFi
  * @param mqtt_status Status da conexão MQTT
- * @param temperatura Valor atual da temperatura
+ * @param temperatura_decimos Valor atual da temperatura em décimos de grau
  * @param timestamp Timestamp atual
  */
-void display_show_system_status(bool wifi_status, bool mqtt_status, float temperatura, unsigned long timestamp)
+void display_show_system_status(bool wifi_status, bool mqtt_status, int32_t temperatura_decimos, unsigned long timestamp)
 {
     char buffer[32];
+    formato_t f;
     
     // Limpa o display
     ssd1306_clear(&display);
@@ -100,26 +101,29 @@ void display_show_system_status(bool wifi_status, bool mqtt_status, float temper
     ssd1306_draw_line(&display, 0, 22, 127, 22, true);
     
     // Temperatura atual
-    snprintf(buffer, sizeof(buffer), "TEMP: %.1f C", temperatura);
+    formato_iniciar(&f, buffer, sizeof(buffer));
+    formato_texto(&f, "TEMP: ");
+    formato_decimal(&f, temperatura_decimos, 1, 0);
+    formato_texto(&f, " C");
     display_draw_text(buffer, 0, 26);
     
     // Timestamp normal e criptografado na mesma linha
-    snprintf(buffer, sizeof(buffer), "TS: %lu", timestamp);
+    formato_snprintf(buffer, sizeof(buffer), "TS: %lu", timestamp);
     display_draw_text(buffer, 0, 36);
     
     // Timestamp criptografado na mesma linha, mais à frente
     // Criptografa apenas o valor numérico do timestamp
     char ts_numeric[16];
-    snprintf(ts_numeric, sizeof(ts_numeric), "%lu", timestamp);
+    formato_snprintf(ts_numeric, sizeof(ts_numeric), "%lu", timestamp);
     uint8_t ts_encrypted[16];
     xor_encrypt((uint8_t *)ts_numeric, ts_encrypted, strlen(ts_numeric), 42);
     
     // Converte para hexadecimal legível (mostra apenas os primeiros 4 caracteres hex)
     char hex_display[16];
-    for (int i = 0; i < 2 && i < strlen(ts_numeric); i++) {
-        sprintf(&hex_display[i*2], "%02X", ts_encrypted[i]);
+    formato_iniciar(&f, hex_display, sizeof(hex_display));
+    for (size_t i = 0; i < 2 && i < strlen(ts_numeric); i++) {
+        formato_hex(&f, ts_encrypted[i], 2);
     }
-    hex_display[4] = '\0';
     display_draw_text(hex_display, 85, 36);
     
     // Status de criptografia
@@ -223,8 +227,7 @@ int main() {
     mqtt_setup("bitdog1", "192.168.43.212", "aluno", "senha123");
 
     // Mensagem original a ser enviada (agora apenas como base para o valor)
-    const char *mensagem = "26.5";
-    float temperatura = atof(mensagem);
+    const int32_t temperatura_decimos = 265;    // 26,5 °C em décimos de grau
     
     // Buffer para a mensagem JSON formatada (temporariamente antes do XOR)
     char json_buffer[64]; // Tamanho suficiente para "{"valor":XX.X,"ts":XXXXXXXXXX}"
@@ -240,23 +243,29 @@ int main() {
         bool mqtt_connected = mqtt_is_connected();
         
         // Atualiza o display com informações REAIS do sistema
-        display_show_system_status(wifi_connected, mqtt_connected, temperatura, current_timestamp);
+        display_show_system_status(wifi_connected, mqtt_connected, temperatura_decimos, current_timestamp);
         
         // Formata a mensagem como JSON com valor e timestamp no json_buffer
-        sprintf(json_buffer, "{\"valor\":%.1f,\"ts\":%lu}", temperatura, current_timestamp);
+        formato_t f;
+        formato_iniciar(&f, json_buffer, sizeof(json_buffer));
+        formato_texto(&f, "{\"valor\":");
+        formato_decimal(&f, temperatura_decimos, 1, 0);
+        formato_texto(&f, ",\"ts\":");
+        formato_natural(&f, (uint32_t)current_timestamp, 0, ' ');
+        formato_caractere(&f, '}');
 
         // Criptografa apenas o timestamp numérico para demonstração
         char ts_only[16];
-        sprintf(ts_only, "%lu", current_timestamp);
+        formato_snprintf(ts_only, sizeof(ts_only), "%lu", current_timestamp);
         uint8_t ts_encrypted[16];
         xor_encrypt((uint8_t *)ts_only, ts_encrypted, strlen(ts_only), 42);
         
         // Converte bytes criptografados para hexadecimal legível
         char hex_encrypted[32];
-        for (int i = 0; i < strlen(ts_only); i++) {
-            sprintf(&hex_encrypted[i*2], "%02X", ts_encrypted[i]);
+        formato_iniciar(&f, hex_encrypted, sizeof(hex_encrypted));
+        for (size_t i = 0; i < strlen(ts_only); i++) {
+            formato_hex(&f, ts_encrypted[i], 2);
         }
-        hex_encrypted[strlen(ts_only)*2] = '\0';
 
         // === FINS DIDÁTICOS: Publica AMBAS as versões ===
         
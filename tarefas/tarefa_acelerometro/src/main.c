@@ -25,8 +25,11 @@
 #include "pico/stdlib.h"
 #include "pico/binary_info.h"
 #include "hardware/i2c.h"
+#include "hardware/sync.h"
 #include "ssd1306_i2c.h"
 #include "ssd1306.h"
+#include "formato.h"
+#include "mpu6050_irq.h"
 
 // Configuração de hardware para arquitetura dual I2C BitDogLab
 // Implementa isolamento de barramento entre sensor inercial e display
@@ -44,9 +47,25 @@
 #define OLED_I2C_PORT i2c1              // Controlador I2C1 do RP2040
 
 // Endereçamento I2C de dispositivos periféricos
-#define MPU6050_ADDR 0x68               // Endereço padrão MPU-6050 (AD0=LOW)
 #define OLED_ADDR 0x3C                  // Endereço padrão SSD1306 (SA0=LOW)
 
+// GPIO ligado ao pino INT do MPU-6050 (data-ready); sem o fio o driver
+// cai no temporizador com a mesma taxa
+#ifndef MPU6050_INT_PIN
+#define MPU6050_INT_PIN 17
+#endif
+
+// 1: o sensor guarda os quadros no FIFO e o driver drena um lote a cada
+// 20 ms (o INT avisa o estouro); 0: uma rajada por data-ready, com a
+// temperatura, que não entra no FIFO
+#ifndef MPU6050_FIFO
+#define MPU6050_FIFO 0
+#endif
+
+// Amostragem: filtro de 44 Hz e 1 kHz (base de 1 kHz, divisor 0), ±2 g e ±250 °/s
+static const mpu6050_config_t mpu_config = { .dlpf = 3, .divisor = 0, .faixa_acel = 0, .faixa_giro = 0 };
+#define DISPLAY_PERIOD_US 1000000       // Terminal e OLED uma vez por segundo
+
 // Buffer de framebuffer para display OLED SSD1306
 static uint8_t oled_buffer[ssd1306_buffer_length];
 static struct render_area area_display = {
@@ -56,51 +75,28 @@ static struct render_area area_display = {
     .end_page = ssd1306_n_pages - 1     // Altura completa: 8 páginas (64 pixels)
 };
 
-// Rotina de inicialização e configuração do sensor MPU-6050
-static void mpu6050_reset() {
-    // Sequência de reset do dispositivo via registro 0x6B
-    uint8_t buf[] = {0x6B, 0x80};
-    i2c_write_blocking(BITDOGLAB_I2C_PORT, MPU6050_ADDR, buf, 2, false);
-    sleep_ms(100); // Tempo de estabilização após reset do dispositivo
-
-    // Desabilita modo sleep através do registro 0x6B
-    buf[1] = 0x00;  // Valor 0x00 remove o modo sleep do MPU-6050
-    i2c_write_blocking(BITDOGLAB_I2C_PORT, MPU6050_ADDR, buf, 2, false); 
-    sleep_ms(10); // Tempo de estabilização após saída do modo sleep
-}
-
-// Aquisição de dados inerciais do sensor MPU-6050 via protocolo I2C
-static void mpu6050_read_raw(int16_t accel[3], int16_t gyro[3]) {
-    // Implementa leitura sequencial com auto-incremento de registros
-    // Protocolo otimizado para minimizar transações I2C
-    
-    uint8_t buffer[6];
-
-    // Leitura dos registros de aceleração (0x3B a 0x40) - 6 bytes
-    uint8_t val = 0x3B;
-    i2c_write_blocking(BITDOGLAB_I2C_PORT, MPU6050_ADDR, &val, 1, true); // Mantém controle do barramento
-    i2c_read_blocking(BITDOGLAB_I2C_PORT, MPU6050_ADDR, buffer, 6, false);
+// Linha "R:%5d" do display, só com inteiros (projects/comum/formato)
+static void draw_axis(int16_t x, int16_t y, char rotulo, int16_t valor) {
+    char line_buffer[16];
+    formato_t f;
 
-    // Conversão dos dados de aceleração para formato int16_t
-    for (int i = 0; i < 3; i++) {
-        accel[i] = (buffer[i * 2] << 8 | buffer[(i * 2) + 1]);
-    }
+    formato_iniciar(&f, line_buffer, sizeof(line_buffer));
+    formato_caractere(&f, rotulo);
+    formato_caractere(&f, ':');
+    formato_inteiro(&f, valor, 5, ' ');
+    ssd1306_draw_string(oled_buffer, x, y, line_buffer);
+}
 
-    // Leitura dos registros de giroscópio (0x43 a 0x48) - 6 bytes
-    val = 0x43;
-    i2c_write_blocking(BITDOGLAB_I2C_PORT, MPU6050_ADDR, &val, 1, true);
-    i2c_read_blocking(BITDOGLAB_I2C_PORT, MPU6050_ADDR, buffer, 6, false);  // Libera controle do barramento
+// Linha dos três eixos no terminal serial; fputs não interpreta formato
+static void print_axes(const int16_t v[3]) {
+    char linha[48];
 
-    // Conversão dos dados de giroscópio para formato int16_t
-    for (int i = 0; i < 3; i++) {
-        gyro[i] = (buffer[i * 2] << 8 | buffer[(i * 2) + 1]);
-    }
+    formato_snprintf(linha, sizeof(linha), "  X = %7d  Y = %7d  Z = %7d\n", v[0], v[1], v[2]);
+    fputs(linha, stdout);
 }
 
 // Renderização de dados inerciais no display OLED SSD1306
 static void display_sensor_data(int16_t accel[3], int16_t gyro[3]) {
-    char line_buffer[16];
-    
     // Limpa o buffer do display
     ssd1306_clear(oled_buffer);
     
@@ -108,27 +104,21 @@ static void display_sensor_data(int16_t accel[3], int16_t gyro[3]) {
     ssd1306_draw_string(oled_buffer, 0, 0, "ACEL:");
     
     // Linha 1: X e Y do acelerômetro
-    snprintf(line_buffer, sizeof(line_buffer), "X:%5d", accel[0]);
-    ssd1306_draw_string(oled_buffer, 0, 8, line_buffer);
-    snprintf(line_buffer, sizeof(line_buffer), "Y:%5d", accel[1]);
-    ssd1306_draw_string(oled_buffer, 64, 8, line_buffer);
+    draw_axis(0, 8, 'X', accel[0]);
+    draw_axis(64, 8, 'Y', accel[1]);
     
     // Linha 2: Z do acelerômetro
-    snprintf(line_buffer, sizeof(line_buffer), "Z:%5d", accel[2]);
-    ssd1306_draw_string(oled_buffer, 0, 16, line_buffer);
+    draw_axis(0, 16, 'Z', accel[2]);
     
     // Seção Giroscópio (títulos curtos)
     ssd1306_draw_string(oled_buffer, 0, 32, "GIRO:");
     
     // Linha 1: X e Y do giroscópio
-    snprintf(line_buffer, sizeof(line_buffer), "X:%5d", gyro[0]);
-    ssd1306_draw_string(oled_buffer, 0, 40, line_buffer);
-    snprintf(line_buffer, sizeof(line_buffer), "Y:%5d", gyro[1]);
-    ssd1306_draw_string(oled_buffer, 64, 40, line_buffer);
+    draw_axis(0, 40, 'X', gyro[0]);
+    draw_axis(64, 40, 'Y', gyro[1]);
     
     // Linha 2: Z do giroscópio
-    snprintf(line_buffer, sizeof(line_buffer), "Z:%5d", gyro[2]);
-    ssd1306_draw_string(oled_buffer, 0, 48, line_buffer);
+    draw_axis(0, 48, 'Z', gyro[2]);
     
     // Transfere framebuffer para controlador SSD1306 via I2C
     render_on_display(oled_buffer, &area_display);
@@ -169,7 +159,9 @@ int main() {
     
     // Inicialização do sensor MPU-6050
     printf("Inicializando MPU-6050...\n");
-    mpu6050_reset();
+    if (!mpu6050_iniciar(BITDOGLAB_I2C_PORT, &mpu_config)) {
+        printf("ERRO: MPU-6050 nao respondeu no endereco 0x%02X\n", MPU6050_ENDERECO);
+    }
     
     // Inicialização do display OLED (conforme projeto de referência)
     printf("Inicializando OLED...\n");
@@ -177,27 +169,75 @@ int main() {
     calculate_render_area_buffer_length(&area_display);
     ssd1306_clear(oled_buffer);
 
-    // Variáveis para armazenamento dos dados capturados
-    int16_t acceleration[3], gyro[3];
-
-    printf("Iniciando leitura contínua do MPU-6050 com exibição no OLED...\n");
-
-    // Loop principal de aquisição e exibição de dados
+#if MPU6050_FIFO
+    // Aquisição em lotes: instantes reconstruídos pela ODR
+    const char *modo = "FIFO";
+    if (!mpu6050_iniciar_fifo(MPU6050_INT_PIN, MPU6050_PERIODO_LOTE_US)) {
+        printf("ERRO: MPU-6050 recusou a configuracao do FIFO, usando data-ready\n");
+        modo = mpu6050_iniciar_irq(MPU6050_INT_PIN) ? "INT" : "temporizador";
+    }
+#else
+    // Aquisição por data-ready: cada amostra chega com o instante da borda do INT
+    const char *modo = mpu6050_iniciar_irq(MPU6050_INT_PIN) ? "INT" : "temporizador";
+#endif
+    printf("Iniciando leitura contínua do MPU-6050 a %lu Hz (%s) com exibição no OLED...\n",
+           (unsigned long)mpu6050_taxa_hz(&mpu_config), modo);
+
+    mpu6050_amostra_t ultima = {0};
+    uint32_t recebidas = 0;
+#if MPU6050_FIFO
+    uint32_t lotes_anteriores = 0;
+#endif
+    uint64_t proxima_exibicao = time_us_64() + DISPLAY_PERIOD_US;
+
+    // Loop principal: esvazia o anel e exibe a amostra mais recente uma vez por segundo
     while (1) {
-        mpu6050_read_raw(acceleration, gyro);
-
-        // Exibição dos dados no terminal serial
-        printf("\n=== LEITURA MPU-6050 ===\n");
-        printf("Acelerômetro:\n");
-        printf("  X = %7d  Y = %7d  Z = %7d\n", acceleration[0], acceleration[1], acceleration[2]);
-        printf("Giroscópio:\n");
-        printf("  X = %7d  Y = %7d  Z = %7d\n", gyro[0], gyro[1], gyro[2]);
-        printf("========================\n");
-        
-        // Exibição dos dados no display OLED
-        display_sensor_data(acceleration, gyro);
-
-        sleep_ms(1000); // Taxa de amostragem de 1Hz para visualização confortável
+        mpu6050_amostra_t amostra;
+        while (mpu6050_proxima(&amostra)) {
+            ultima = amostra;
+            recebidas++;
+        }
+
+        if (time_us_64() >= proxima_exibicao) {
+            proxima_exibicao += DISPLAY_PERIOD_US;
+
+            mpu6050_metricas_t m;
+            mpu6050_metricas(&m);
+            char linha[64];
+
+            // Exibição dos dados no terminal serial
+            printf("\n=== LEITURA MPU-6050 ===\n");
+            printf("Acelerômetro:\n");
+            print_axes(ultima.acel);
+            printf("Giroscópio:\n");
+            print_axes(ultima.giro);
+            if (ultima.temperatura != MPU6050_SEM_TEMPERATURA) {
+                formato_t f;
+                formato_iniciar(&f, linha, sizeof(linha));
+                formato_texto(&f, "Temperatura: ");
+                formato_decimal(&f, mpu6050_temperatura_centi(ultima.temperatura), 2, 0);
+                formato_texto(&f, " C\n");
+                fputs(linha, stdout);
+            }
+            formato_snprintf(linha, sizeof(linha), "Amostras: %lu/s | intervalo max %lu us | perdidas %lu\n",
+                             (unsigned long)recebidas, (unsigned long)m.intervalo_max_us,
+                             (unsigned long)(m.ocupado + m.anel_cheio + m.erros));
+            fputs(linha, stdout);
+#if MPU6050_FIFO
+            formato_snprintf(linha, sizeof(linha), "Lotes: %lu/s | maior %lu quadros | estouros %lu\n",
+                             (unsigned long)(m.lotes - lotes_anteriores), (unsigned long)m.quadros_lote_max,
+                             (unsigned long)m.estouros);
+            fputs(linha, stdout);
+            lotes_anteriores = m.lotes;
+#endif
+            printf("========================\n");
+            recebidas = 0;
+
+            // Exibição dos dados no display OLED
+            display_sensor_data(ultima.acel, ultima.giro);
+        }
+
+        __wfi();    // Próxima interrupção: amostra a cada 1 ms ou lote a cada 20 ms
     }
     
     return 0;
@@ -26,8 +26,11 @@
 #include "pico/stdlib.h"
 #include "pico/binary_info.h"
 #include "hardware/i2c.h"
+#include "hardware/sync.h"
 #include "ssd1306_i2c.h"
 #include "ssd1306.h"
+#include "formato.h"
+#include "mpu6050_irq.h"
 #include "tb6612fng.h"
 
 // Configuração de hardware para arquitetura multi-periférico BitDogLab
@@ -46,9 +49,18 @@
 #define OLED_I2C_PORT i2c1              // Controlador I2C1 do RP2040
 
 // Endereçamento I2C de dispositivos periféricos
-#define MPU6050_ADDR 0x68               // Endereço padrão MPU-6050 (AD0=LOW)
 #define OLED_ADDR 0x3C                  // Endereço padrão SSD1306 (SA0=LOW)
 
+// GPIO ligado ao pino INT do MPU-6050 (data-ready); sem o fio o driver
+// cai no temporizador com a mesma taxa
+#ifndef MPU6050_INT_PIN
+#define MPU6050_INT_PIN 17
+#endif
+
+// Amostragem: filtro de 44 Hz e 1 kHz (base de 1 kHz, divisor 0), ±2 g e ±250 °/s
+static const mpu6050_config_t mpu_config = { .dlpf = 3, .divisor = 0, .faixa_acel = 0, .faixa_giro = 0 };
+#define CONTROL_PERIOD_US 500000        // Controle, terminal e OLED a 2 Hz
+
 // Buffer de framebuffer para display OLED SSD1306
 static uint8_t oled_buffer[ssd1306_buffer_length];
 static struct render_area area_display = {
@@ -67,65 +79,39 @@ static tb6612fng_t motor_driver;
 #define MAX_MOTOR_SPEED 80      // Velocidade máxima dos motores (0-100%)
 #define MIN_MOTOR_SPEED 30      // Velocidade mínima dos motores (0-100%)
 
-// Inicialização e configuração do sensor MPU-6050 via I2C
-static void mpu6050_reset() {
-    // Reset completo do dispositivo através do registro 0x6B
-    uint8_t buf[] = {0x6B, 0x80};
-    i2c_write_blocking(BITDOGLAB_I2C_PORT, MPU6050_ADDR, buf, 2, false);
-    sleep_ms(100); // Estabilização após reset de hardware
+// Linha "R:%5d" do display, só com inteiros (projects/comum/formato)
+static void draw_axis(int16_t x, int16_t y, char rotulo, int16_t valor) {
+    char line_buffer[16];
+    formato_t f;
 
-    // Saída do modo sleep para operação normal
-    buf[1] = 0x00;  // Ativa o MPU-6050 removendo flag de sleep
-    i2c_write_blocking(BITDOGLAB_I2C_PORT, MPU6050_ADDR, buf, 2, false); 
-    sleep_ms(10); // Estabilização após ativação do sensor
+    formato_iniciar(&f, line_buffer, sizeof(line_buffer));
+    formato_caractere(&f, rotulo);
+    formato_caractere(&f, ':');
+    formato_inteiro(&f, valor, 5, ' ');
+    ssd1306_draw_string(oled_buffer, x, y, line_buffer);
 }
 
-// Aquisição de dados inerciais do sensor MPU-6050 via protocolo I2C
-static void mpu6050_read_raw(int16_t accel[3], int16_t gyro[3]) {
-    // Leitura sequencial otimizada com auto-incremento de registros
-    // Minimiza transações I2C para melhor performance
-    
-    uint8_t buffer[6];
-
-    // Leitura dos registros de aceleração (0x3B-0x40) em bloco único
-    uint8_t val = 0x3B;
-    i2c_write_blocking(BITDOGLAB_I2C_PORT, MPU6050_ADDR, &val, 1, true); // Mantém barramento ativo
-    i2c_read_blocking(BITDOGLAB_I2C_PORT, MPU6050_ADDR, buffer, 6, false);
+// Linha dos três eixos no terminal serial; fputs não interpreta formato
+static void print_axes(const int16_t v[3]) {
+    char linha[48];
 
-    // Conversão de dados big-endian para int16_t dos eixos X, Y, Z
-    for (int i = 0; i < 3; i++) {
-        accel[i] = (buffer[i * 2] << 8 | buffer[(i * 2) + 1]);
-    }
-
-    // Leitura dos registros de giroscópio (0x43-0x48) em bloco único
-    val = 0x43;
-    i2c_write_blocking(BITDOGLAB_I2C_PORT, MPU6050_ADDR, &val, 1, true);
-    i2c_read_blocking(BITDOGLAB_I2C_PORT, MPU6050_ADDR, buffer, 6, false);  // Libera barramento
-
-    // Conversão de dados big-endian para int16_t dos eixos X, Y, Z
-    for (int i = 0; i < 3; i++) {
-        gyro[i] = (buffer[i * 2] << 8 | buffer[(i * 2) + 1]);
-    }
+    formato_snprintf(linha, sizeof(linha), "  X = %7d  Y = %7d  Z = %7d\n", v[0], v[1], v[2]);
+    fputs(linha, stdout);
 }
 
 // Renderização de dados inerciais e status dos motores no display OLED
 static void display_sensor_data(int16_t accel[3], int16_t gyro[3]) {
-    char line_buffer[16];
-    
     // Limpa o buffer do display
     ssd1306_clear(oled_buffer);
     
     // Seção Acelerômetro (compacta)
     ssd1306_draw_string(oled_buffer, 0, 0, "ACEL:");
-    snprintf(line_buffer, sizeof(line_buffer), "X:%5d", accel[0]);
-    ssd1306_draw_string(oled_buffer, 0, 8, line_buffer);
-    snprintf(line_buffer, sizeof(line_buffer), "Y:%5d", accel[1]);
-    ssd1306_draw_string(oled_buffer, 64, 8, line_buffer);
+    draw_axis(0, 8, 'X', accel[0]);
+    draw_axis(64, 8, 'Y', accel[1]);
     
     // Seção Giroscópio (compacta)
     ssd1306_draw_string(oled_buffer, 0, 16, "GIRO:");
-    snprintf(line_buffer, sizeof(line_buffer), "Z:%5d", gyro[2]);
-    ssd1306_draw_string(oled_buffer, 0, 24, line_buffer);
+    draw_axis(0, 24, 'Z', gyro[2]);
     
     // Status do driver de motores
     ssd1306_draw_string(oled_buffer, 0, 40, "MOTORS:");
@@ -228,11 +214,13 @@ static void control_motors_from_imu(int16_t accel[3], int16_t gyro[3]) {
     
     // Debug via serial
     if (speed_a > 0 || speed_b > 0) {
-        printf("Motores: A[%s:%d%%] B[%s:%d%%]\n", 
-               (dir_a == MOTOR_FORWARD) ? "FWD" : (dir_a == MOTOR_BACKWARD) ? "BWD" : "STP",
-               speed_a,
-               (dir_b == MOTOR_FORWARD) ? "FWD" : (dir_b == MOTOR_BACKWARD) ? "BWD" : "STP",
-               speed_b);
+        char linha[40];
+        formato_snprintf(linha, sizeof(linha), "Motores: A[%s:%d%%] B[%s:%d%%]\n",
+                         (dir_a == MOTOR_FORWARD) ? "FWD" : (dir_a == MOTOR_BACKWARD) ? "BWD" : "STP",
+                         speed_a,
+                         (dir_b == MOTOR_FORWARD) ? "FWD" : (dir_b == MOTOR_BACKWARD) ? "BWD" : "STP",
+                         speed_b);
+        fputs(linha, stdout);
     }
 }
 
@@ -274,7 +262,9 @@ int main() {
     
     // Inicialização do sensor MPU-6050
     printf("Inicializando MPU-6050...\n");
-    mpu6050_reset();
+    if (!mpu6050_iniciar(BITDOGLAB_I2C_PORT, &mpu_config)) {
+        printf("ERRO: MPU-6050 nao respondeu no endereco 0x%02X\n", MPU6050_ENDERECO);
+    }
     
     // Inicialização do display OLED (conforme projeto de referência)
     printf("Inicializando OLED...\n");
@@ -290,30 +280,40 @@ int main() {
         printf("ERRO: Falha na inicialização do driver de motores!\n");
     }
 
-    // Variáveis para armazenamento dos dados capturados
-    int16_t acceleration[3], gyro[3];
+    // Aquisição por data-ready: cada amostra chega com o instante da borda do INT
+    bool por_int = mpu6050_iniciar_irq(MPU6050_INT_PIN);
+    printf("Iniciando sistema de controle de motores baseado em IMU (%lu Hz, %s)...\n",
+           (unsigned long)mpu6050_taxa_hz(&mpu_config), por_int ? "INT" : "temporizador");
 
-    printf("Iniciando sistema de controle de motores baseado em IMU...\n");
+    mpu6050_amostra_t ultima = {0};
+    uint64_t proximo_controle = time_us_64() + CONTROL_PERIOD_US;
 
-    // Loop principal de aquisição, exibição e controle
+    // Loop principal: esvazia o anel e controla com a amostra mais recente
     while (1) {
-        mpu6050_read_raw(acceleration, gyro);
+        mpu6050_amostra_t amostra;
+        while (mpu6050_proxima(&amostra)) {
+            ultima = amostra;
+        }
 
-        // Exibição dos dados no terminal serial
-        printf("\n=== LEITURA MPU-6050 ===\n");
-        printf("Acelerômetro:\n");
-        printf("  X = %7d  Y = %7d  Z = %7d\n", acceleration[0], acceleration[1], acceleration[2]);
-        printf("Giroscópio:\n");
-        printf("  X = %7d  Y = %7d  Z = %7d\n", gyro[0], gyro[1], gyro[2]);
-        printf("========================\n");
-        
-        // Controle inteligente dos motores baseado em dados inerciais
-        control_motors_from_imu(acceleration, gyro);
-        
-        // Exibição dos dados no display OLED
-        display_sensor_data(acceleration, gyro);
+        if (time_us_64() >= proximo_controle) {
+            proximo_controle += CONTROL_PERIOD_US;
+
+            // Exibição dos dados no terminal serial
+            printf("\n=== LEITURA MPU-6050 ===\n");
+            printf("Acelerômetro:\n");
+            print_axes(ultima.acel);
+            printf("Giroscópio:\n");
+            print_axes(ultima.giro);
+            printf("========================\n");
+
+            // Controle inteligente dos motores baseado em dados inerciais
+            control_motors_from_imu(ultima.acel, ultima.giro);
+
+            // Exibição dos dados no display OLED
+            display_sensor_data(ultima.acel, ultima.giro);
+        }
 
-        sleep_ms(500); // Taxa de amostragem de 2Hz para controle responsivo
+        __wfi();    // Próxima interrupção: amostra a cada 1 ms
     }
     
     return 0;
@@ -1,5 +1,6 @@
 // Sistema de Controle de Caldeira Industrial com FreeRTOS
 // Implementa simulação de caldeira com 4 estados críticos e prioridades diferenciadas
+// Modelo físico integrado a 100 Hz; o joystick injeta perturbações no processo
 // Utiliza joystick analógico, display OLED SSD1306 e matriz LED NeoPixel 5x5
 // Arquitetura RTOS pura com preempção natural para gerenciamento de emergências
 // Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
@@ -9,85 +10,103 @@
 #include "queue.h"
 #include "timers.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "pico/stdlib.h"
 #include <stdint.h>
 #include <stdbool.h>
-#include "hardware/gpio.h"
-#include "hardware/adc.h"
-#include "hardware/i2c.h"
-#include "hardware/pio.h"
-#include "hardware/clocks.h"
 #include "ssd1306.h"
-
-// Programa PIO para controle de matriz LED WS2812B
-#include "ws2818b.pio.h"
+#include "caldeira_hw.h"
+#include "modelo_caldeira.h"
+#include "perfil_rtos.h"
+#include "trace_rtos.h"
+#include "consumo_rtos.h"
+#include "memoria_caldeira.h"
+#include "supervisor_rtos.h"
+#include "cor_led.h"
+#include "efeitos_led.h"
+#include "formato.h"
+#include "joystick_filtro.h"
 
 // =============================================================================
 // CONFIGURAÇÕES DE HARDWARE E CONSTANTES DO SISTEMA
 // =============================================================================
 
-// Configuração dos pinos do joystick analógico
-#define VRX_PIN         26      // Eixo X do joystick conectado ao ADC0
-#define VRY_PIN         27      // Eixo Y do joystick conectado ao ADC1
-
-// Configuração do display OLED SSD1306 via I2C
-#define SDA_PIN         14      // Linha de dados I2C
-#define SCL_PIN         15      // Linha de clock I2C
+// Pinos e canais ADC ficam em caldeira_hw.h, junto do acesso ao hardware
 
 // Configuração da matriz de LEDs NeoPixel WS2812B
-#define LED_PIN         7       // Pino de controle PIO para matriz LED
-#define LED_COUNT       25      // Matriz 5x5 = 25 LEDs individuais
+#define LED_COUNT       EFEITOS_PIXELS  // Matriz 5x5 = 25 LEDs individuais
+
+// Calibração, zona morta e debounce do joystick ficam em joystick_filtro.h
+// (centro aprendido no boot em vez de limiares fixos)
+
+// Período do laço de controle (integração do modelo e lógica dos atuadores)
+#define CONTROLE_PERIODO_MS     10      // 100 Hz
+
+// Intervalo mínimo entre redesenhos do display por mudança de valor: agrupa as
+// mudanças seguidas (o processo varia continuamente); mudança de estado ou de
+// atuador redesenha na hora
+#define DISPLAY_INTERVALO_MIN_MS 1000
+
+// Texto do display: 7 linhas de 16 caracteres 8x8, uma página SSD1306 por linha
+#define DISPLAY_LINHAS          7
+#define DISPLAY_COLUNAS         16
 
-// Canais ADC para leitura do joystick
-#define ADC_CH_X        0       // Canal ADC para eixo X
-#define ADC_CH_Y        1       // Canal ADC para eixo Y
+// Tarefas que podem assinar o canal de telemetria e bits da notificação
+#define TELEMETRIA_MAX_ASSINANTES 2
+#define TELEMETRIA_MUDOU_VALOR  (1u << 0)   // Pressão, temperatura ou nível (inteiros)
+#define TELEMETRIA_MUDOU_ESTADO (1u << 1)   // Estado da caldeira ou atuadores
 
-// Calibração de sensibilidade do joystick analógico
-// Valores baseados em ADC de 12 bits (0-4095) do RP2040
-#define JOY_CENTER_MIN  1800    // Limite inferior da zona morta central
-#define JOY_CENTER_MAX  2300    // Limite superior da zona morta central
-#define JOY_THRESHOLD   1000    // Sensibilidade para detecção de movimento
+// Prazos de atuação (detecção no controle -> tarefa do estado sinalizar)
+// Emergência: bem abaixo de um período de amostragem; demais: um período
+#define PRAZO_EMERGENCIA_US     10000
+#define PRAZO_ESTADO_US         100000
+
+// Prazos das demais tarefas monitoradas pelo supervisor (liberação -> conclusão)
+#define PRAZO_CONTROLE_US       (CONTROLE_PERIODO_MS * 1000)
+#define BATIMENTO_CONTROLE_US   (10 * PRAZO_CONTROLE_US)    // 10 períodos sem iteração: travado
+#define PRAZO_JOYSTICK_US       100000  // Evento de direção -> perturbação aplicada
+#define PRAZO_MATRIZ_US         20000   // Seleção do efeito -> primeiro quadro publicado
+#define PRAZO_DISPLAY_US        (DISPLAY_INTERVALO_MIN_MS * 1000 + 500000)
+
+// Modos de build (definidos pelo CMakeLists.txt)
+#ifndef CALDEIRA_SMP
+#define CALDEIRA_SMP            0       // 1: FreeRTOS SMP nos dois núcleos do RP2040
+#endif
+#ifndef CALDEIRA_CARGA_DISPLAY
+#define CALDEIRA_CARGA_DISPLAY  0       // 1: display redesenha sem pausa (teste de carga)
+#endif
+#ifndef CALDEIRA_DITHER
+#define CALDEIRA_DITHER         0       // 1: dithering temporal na matriz LED
+#endif
+
+// Afinidade de núcleo no modo SMP
+#define NUCLEO_CONTROLE         (1 << 0)  // Controle, joystick e tarefas de estado/emergência
+#define NUCLEO_IO               (1 << 1)  // Display e matriz LED
 
 // =============================================================================
 // ESTRUTURAS E TIPOS DE DADOS DO SISTEMA
 // =============================================================================
 
-// Enumeração dos estados críticos da caldeira industrial
-// Organizados por prioridade crescente para escalonamento RTOS
-typedef enum {
-    CALDEIRA_OK = 0,           // Prioridade 1: operação normal (baixa)
-    CALDEIRA_NIVEL_BAIXO,      // Prioridade 2: água insuficiente (baixa)
-    CALDEIRA_TEMP_ALTA,        // Prioridade 3: superaquecimento (média)
-    CALDEIRA_PRESSAO_ALTA      // Prioridade 4: emergência crítica (máxima)
-} estado_caldeira_t;
+// Estados da caldeira (estado_caldeira_t) ficam em modelo_caldeira.h
 
 // Estrutura de dados completa do estado da caldeira
 // Contém telemetria e status dos atuadores em tempo real
 typedef struct {
     estado_caldeira_t estado;  // Estado operacional atual
     float pressao;             // Pressão interna em kPa
-    float temperatura;         // Temperatura do vapor em °C
+    float temperatura;         // Temperatura da água em °C
     float nivel_agua;          // Nível do reservatório em %
     bool aquecedor;            // Status do sistema de aquecimento
     bool bomba;                // Status da bomba de alimentação
     bool alivio;               // Status da válvula de alívio
 } dados_caldeira_t;
 
-// Estrutura de pixel para matriz LED WS2812B
-// Ordenação GRB conforme protocolo nativo do controlador
-typedef struct {
-    uint8_t G, R, B;           // Verde, Vermelho, Azul (8 bits cada)
-} pixel_t;
-
-// Enumeração das direções do joystick analógico
-// Mapeamento direto para comandos de estado da caldeira
-typedef enum {
-    JOY_CENTER = 0,            // Posição neutra (sem comando)
-    JOY_RIGHT,                 // Direita: aciona estado OK
-    JOY_LEFT,                  // Esquerda: simula nível baixo
-    JOY_DOWN,                  // Baixo: simula temperatura alta
-    JOY_UP                     // Cima: simula pressão alta (emergência)
-} joystick_dir_t;
+// Estrutura de pixel da matriz LED (pixel_t) fica em cor_led.h
+
+// Direções do joystick (joystick_dir_t) ficam em joystick_filtro.h
+// Direita remove as perturbações; esquerda, baixo e cima injetam vazamento,
+// queimador travado e saída de vapor bloqueada
 
 // =============================================================================
 // VARIÁVEIS GLOBAIS DO SISTEMA FREERTOS
@@ -95,16 +114,81 @@ typedef enum {
 
 // Handles das tarefas FreeRTOS para controle de ciclo de vida
 // Cada tarefa possui prioridade específica conforme criticidade
+TaskHandle_t xControleTaskHandle = NULL;      // Laço de controle: prioridade 6
 TaskHandle_t xJoystickTaskHandle = NULL;      // Tarefa de entrada: prioridade 5
 TaskHandle_t xCaldeiraOKTaskHandle = NULL;    // Estado normal: prioridade 1
 TaskHandle_t xCaldeiraNivelTaskHandle = NULL; // Nível baixo: prioridade 2
 TaskHandle_t xCaldeiraTempTaskHandle = NULL;  // Temperatura: prioridade 3
 TaskHandle_t xCaldeiraPressaoTaskHandle = NULL; // Emergência: prioridade 4
 TaskHandle_t xDisplayTaskHandle = NULL;       // Interface: prioridade 1
+TaskHandle_t xMatrizTaskHandle = NULL;        // Saída da matriz LED: prioridade 4
+TaskHandle_t xSupervisorTaskHandle = NULL;    // Prazos e watchdog: prioridade 7
+
+// Identificadores das tarefas no supervisor (supervisor_registrar na main)
+int sup_controle, sup_joystick, sup_estado[4], sup_display, sup_matriz;
+
+// Memória das tarefas, reservada em tempo de compilação
+// (tamanhos das pilhas em memoria_caldeira.h; nada vem do heap)
+static StackType_t pilha_controle[PILHA_CONTROLE];
+static StackType_t pilha_joystick[PILHA_JOYSTICK];
+static StackType_t pilha_caldeira_ok[PILHA_ESTADO_OK];
+static StackType_t pilha_caldeira_nivel[PILHA_ESTADO];
+static StackType_t pilha_caldeira_temp[PILHA_ESTADO];
+static StackType_t pilha_caldeira_pressao[PILHA_ESTADO];
+static StackType_t pilha_display[PILHA_DISPLAY];
+static StackType_t pilha_matriz[PILHA_MATRIZ];
+static StackType_t pilha_supervisor[PILHA_SUPERVISOR];
+static StaticTask_t tcb_tarefas[MEMORIA_TAREFAS_APP];
+
+// Estatística de latência detecção -> atuação, por estado de destino
+// Tempo medido da iteração do controle que detectou a mudança até a tarefa
+// dona do estado selecionar o efeito da matriz (o quadro sai depois, pela
+// tarefa da matriz e pelo DMA)
+typedef struct {
+    uint32_t despachados;             // Comandos entregues à tarefa do estado
+    uint32_t amostras;                // Quantidade de comandos medidos (atuados)
+    uint32_t min_us;                  // Menor latência observada
+    uint32_t max_us;                  // Pior caso observado
+    uint64_t soma_us;                 // Soma para cálculo da média
+    uint32_t prazo_perdido;           // Atuações acima de prazo_atuacao_us
+} latencia_t;
+
+latencia_t latencia_estado[4];
+
+const uint32_t prazo_atuacao_us[4] = {
+    PRAZO_ESTADO_US, PRAZO_ESTADO_US, PRAZO_ESTADO_US, PRAZO_EMERGENCIA_US
+};
+
+// Perturbações ativas (PERTURBACAO_*), escritas pelo joystick e lidas pelo
+// controle; palavra de 32 bits alinhada, lida e escrita de uma vez só
+volatile uint32_t perturbacoes_ativas = PERTURBACAO_NENHUMA;
+
+// Temporização do laço de controle
+// Jitter: desvio do intervalo entre duas iterações em relação ao período
+typedef struct {
+    uint32_t iteracoes;
+    uint32_t atrasos;                 // xTaskDelayUntil sem espera (período estourado)
+    uint32_t jitter_max_us;
+    uint64_t jitter_soma_us;
+    uint32_t custo_max_us;            // Tempo de CPU de uma iteração
+    uint64_t custo_soma_us;
+} metricas_controle_t;
+
+metricas_controle_t metricas_controle;
+
+// Tick em que o laço de controle começou: as iterações caem nos múltiplos do
+// período a partir dele (a matriz LED alinha os seus quadros a essa grade)
+TickType_t fase_controle;
+
+// Efeitos da matriz LED: seleções e quadros do escalonador de quadros
+typedef struct {
+    uint32_t selecoes;                // Efeitos selecionados pelas tarefas de estado
+    uint32_t sobrescritos;            // Seleções trocadas antes do primeiro quadro
+    uint32_t quadros;                 // Quadros renderizados e publicados
+    uint32_t atrasados;               // Instantes de quadro já vencidos ao acordar
+} metricas_matriz_t;
 
-// Fila de comunicação inter-tarefas para comandos de estado
-// Implementa padrão producer-consumer thread-safe
-QueueHandle_t xEstadoQueue;
+metricas_matriz_t metricas_matriz;
 
 // Buffer de framebuffer para display OLED SSD1306
 // Área de renderização configurada para tela completa 128x64
@@ -117,56 +201,70 @@ struct render_area area_display = {
 };
 
 // Buffer de pixels para matriz LED 5x5 NeoPixel
-// Cada pixel contém componentes GRB de 8 bits
+// Cada pixel contém componentes GRB de 8 bits, sem gama nem brilho
 pixel_t leds[LED_COUNT];
 
-// Recursos de hardware PIO para controle WS2812B
-// PIO permite comunicação de alta velocidade com protocolo proprietário
-PIO np_pio;                           // Instância PIO (0 ou 1)
-uint sm;                              // Máquina de estado PIO
+// Pipeline de cor (gama + brilho por tabela) e frações do dithering temporal
+cor_led_t cores_matriz;
+static uint8_t residuos_matriz[3 * LED_COUNT];
+
+// Quadros transmitidos para a matriz (escrita e transmissão), no formato
+// HW_MATRIZ_GRB; o envio é feito por DMA enquanto o outro quadro é escrito
+static uint32_t quadros_matriz[2][LED_COUNT];
 
 // Estado de telemetria atual da caldeira industrial
-// Inicializado com valores de operação normal segura
+// Publicado pelo laço de controle a cada iteração; inicializado no ponto nominal
+// Acesso somente por publicar_estado()/ler_estado(): no modo SMP escritores e
+// leitores rodam em núcleos diferentes e a cópia precisa ser atômica
 dados_caldeira_t estado_atual = {
     .estado = CALDEIRA_OK,            // Operação normal
     .pressao = 300.0,                 // 300 kPa (pressão segura)
-    .temperatura = 90.0,              // 90°C (temperatura controlada)
+    .temperatura = 130.0,             // 130°C (temperatura controlada)
     .nivel_agua = 54.0,               // 54% (nível adequado)
     .aquecedor = true,                // Aquecimento ativo
     .bomba = false,                   // Bomba inativa
     .alivio = false                   // Válvula fechada
 };
 
+// Canal de telemetria: a versão avança quando muda algo na resolução exibida
+// (inteiros, estado e atuadores); cada avanço notifica as tarefas assinantes
+// com os bits TELEMETRIA_MUDOU_* do que mudou
+uint32_t versao_telemetria;
+uint32_t instante_versao_us;          // time_us_32() do último avanço de versão
+dados_caldeira_t telemetria_versionada;
+TaskHandle_t assinantes_telemetria[TELEMETRIA_MAX_ASSINANTES];
+uint32_t total_assinantes;
+
+// Atualização do display: quadros, linhas enviadas e atraso publicação -> tela
+typedef struct {
+    uint32_t redesenhos;
+    uint32_t linhas;                  // Páginas de 128 bytes enviadas por I2C
+    uint32_t amostras;                // Versões exibidas com atraso medido
+    uint32_t atraso_max_us;
+    uint64_t atraso_soma_us;
+} metricas_display_t;
+
+metricas_display_t metricas_display;
+
 // =============================================================================
 // FUNÇÕES DE CONTROLE DA MATRIZ LED NEOPIXEL WS2812B
 // =============================================================================
 
-// Fator de atenuação de brilho para conforto visual
+// Brilho da matriz para conforto visual, em milésimos (cor_led.h)
 // Reduz intensidade luminosa para 1% da potência máxima
-#define BRIGHTNESS_FACTOR 0.01f  // 1% para evitar ofuscamento em ambientes
+#define MATRIZ_BRILHO_PERMIL    10      // 1% para evitar ofuscamento em ambientes
 
-// Aplica redução de brilho proporcional nos componentes RGB
-// Implementa controle de intensidade luminosa por software
-uint8_t apply_brightness(uint8_t color_value) {
-    return (uint8_t)(color_value * BRIGHTNESS_FACTOR);
-}
+// Período de quadro dos efeitos animados (e do dithering com fração a
+// distribuir); igual ao do controle, os despertares caem no mesmo tick
+#define MATRIZ_QUADRO_MS        10      // 100 quadros/s
 
 // Inicializa interface PIO para comunicação com matriz WS2812B
-// Configura máquina de estado PIO e define frequência de transmissão
+// Configura máquina de estado PIO, DMA, frequência de transmissão e a
+// tabela de gama + brilho
 void neopixel_init(uint pin) {
-    // Carrega programa PIO para protocolo WS2812B no bloco PIO0
-    uint offset = pio_add_program(pio0, &ws2818b_program);
-    np_pio = pio0;
-    
-    // Tenta alocar máquina de estado no PIO0, fallback para PIO1
-    sm = pio_claim_unused_sm(np_pio, false);
-    if (sm < 0) {
-        np_pio = pio1;
-        sm = pio_claim_unused_sm(np_pio, true);  // Força alocação em PIO1
-    }
-    
-    // Inicializa programa PIO com frequência de 800 kHz (padrão WS2812B)
-    ws2818b_program_init(np_pio, sm, offset, pin, 800000.f);
+    hw_matriz_iniciar(pin, quadros_matriz[0], LED_COUNT);
+    cor_led_iniciar(&cores_matriz, MATRIZ_BRILHO_PERMIL,
+                    CALDEIRA_DITHER ? residuos_matriz : NULL, LED_COUNT);
     
     // Zera buffer de pixels para estado inicial apagado
     for (uint i = 0; i < LED_COUNT; ++i) {
@@ -176,13 +274,13 @@ void neopixel_init(uint pin) {
     }
 }
 
-// Define cor de um LED específico na matriz com controle de brilho
-// Aplica automaticamente fator de atenuação configurado
+// Define cor de um LED específico na matriz
+// Gama e brilho são aplicados pela tabela no empacotamento do quadro
 void neopixel_set_led(const uint index, const uint8_t r, const uint8_t g, const uint8_t b) {
     if (index < LED_COUNT) {
-        leds[index].R = apply_brightness(r);  // Componente vermelho atenuado
-        leds[index].G = apply_brightness(g);  // Componente verde atenuado
-        leds[index].B = apply_brightness(b);  // Componente azul atenuado
+        leds[index].R = r;
+        leds[index].G = g;
+        leds[index].B = b;
     }
 }
 
@@ -194,358 +292,745 @@ void neopixel_clear() {
     }
 }
 
-// Transmite buffer de pixels via PIO para matriz WS2812B
-// Converte formato RGB para GRB conforme protocolo do controlador
-void neopixel_write() {
-    for (uint i = 0; i < LED_COUNT; ++i) {
-        // Reorganiza componentes para formato GRB nativo
-        uint32_t pixel_grb = (leds[i].G << 16) | (leds[i].R << 8) | leds[i].B;
-        // Transmite pixel com shift de 8 bits conforme protocolo
-        pio_sm_put_blocking(np_pio, sm, pixel_grb << 8u);
-    }
-    sleep_ms(1);  // Delay mínimo para estabilização do sinal
+// Publica o buffer de pixels para a matriz WS2812B
+// Uma passada pela tabela de gama + brilho gera as palavras GRB no quadro de
+// escrita; a transmissão (DMA + reset por alarme) segue sem a CPU
+// Retorna true se o dithering ainda tem fração a distribuir nos próximos quadros
+bool neopixel_write() {
+    bool fracionado = cor_led_empacotar(&cores_matriz, leds, hw_matriz_quadro(), LED_COUNT);
+    hw_matriz_publicar();
+    return CALDEIRA_DITHER && fracionado;
+}
+
+// Mapeamento serpentina (get_led_index) fica em efeitos_led.c, com os padrões
+
+// Desenha o efeito no instante 'tempo_ms' desde a seleção e publica o quadro
+// Retorna true se a matriz precisa de outro quadro (efeito animado ou
+// dithering com fração a distribuir)
+bool exibir_efeito_matriz(efeito_id_t efeito, uint32_t tempo_ms, uint32_t nivel_pct) {
+    efeito_renderizar(efeito, tempo_ms, nivel_pct, leds);
+    bool fracionado = neopixel_write();
+    return efeito_animado(efeito) || fracionado;
+}
+
+// =============================================================================
+// FUNÇÕES DE LEITURA E PROCESSAMENTO DO JOYSTICK ANALÓGICO
+// =============================================================================
+
+// Filtro do joystick: mediana + IIR, centro aprendido e debounce
+// Alimentado só pelo laço de controle
+joystick_filtro_t filtro_joystick;
+
+// Evento de direção confirmada pelo filtro: acorda a tarefa do joystick
+// Chamado de dentro de ler_joystick(), no laço de controle
+static void joystick_evento(joystick_dir_t direcao, uint32_t instante_ms, void *contexto) {
+    (void)instante_ms;
+    (void)contexto;
+    supervisor_liberar(sup_joystick, time_us_32());
+    xTaskNotify(xJoystickTaskHandle, direcao, eSetValueWithOverwrite);
+}
+
+// Lê os dois eixos e alimenta o filtro; uma mudança de direção confirmada
+// sai pelo evento, a tarefa do joystick não faz polling
+// Retorna a direção confirmada atual
+joystick_dir_t ler_joystick(uint32_t instante_ms) {
+    uint16_t x, y;
+    hw_ler_joystick(&x, &y);                   // Eixos X/Y (ADC ou roteiro no host)
+    return joystick_filtro_amostra(&filtro_joystick, x, y, instante_ms);
+}
+
+// =============================================================================
+// ACESSO À TELEMETRIA COMPARTILHADA
+// =============================================================================
+
+// Arredonda para o inteiro mais próximo (o que o display e o log mostram)
+int32_t arredondar(float valor) {
+    return valor >= 0.0f ? (int32_t)(valor + 0.5f) : -(int32_t)(0.5f - valor);
 }
 
-// Converte coordenadas cartesianas (x,y) para índice linear da matriz
-// Implementa mapeamento serpentina para disposição física dos LEDs
-int get_led_index(int x, int y) {
-    if (y % 2 == 0) {
-        // Linhas pares: da esquerda para direita
-        return 24 - (y * 5 + x);
-    } else {
-        // Linhas ímpares: da direita para esquerda (padrão serpentina)
-        return 24 - (y * 5 + (4 - x));
+// Compara o que o display mostra e retorna os bits TELEMETRIA_MUDOU_* do que
+// difere (0: iguais na resolução exibida)
+uint32_t telemetria_diferencas(const dados_caldeira_t *a, const dados_caldeira_t *b) {
+    uint32_t bits = 0;
+    
+    if (a->estado != b->estado || a->aquecedor != b->aquecedor ||
+        a->bomba != b->bomba || a->alivio != b->alivio) {
+        bits |= TELEMETRIA_MUDOU_ESTADO;
+    }
+    if (arredondar(a->pressao) != arredondar(b->pressao) ||
+        arredondar(a->temperatura) != arredondar(b->temperatura) ||
+        arredondar(a->nivel_agua) != arredondar(b->nivel_agua)) {
+        bits |= TELEMETRIA_MUDOU_VALOR;
     }
+    return bits;
 }
 
-// Exibe cor sólida em toda matriz LED para indicação de estado
-// Utiliza brilho padrão configurado globalmente
-void exibir_cor_matriz(uint8_t r, uint8_t g, uint8_t b) {
-    for (int i = 0; i < LED_COUNT; i++) {
-        neopixel_set_led(i, r, g, b);
+// Registra uma tarefa para ser notificada (xTaskNotify com eSetBits) a cada nova versão
+// Chamar antes de iniciar o escalonador
+void assinar_telemetria(TaskHandle_t tarefa) {
+    configASSERT(total_assinantes < TELEMETRIA_MAX_ASSINANTES);
+    assinantes_telemetria[total_assinantes++] = tarefa;
+}
+
+// Substitui a telemetria inteira dentro de seção crítica
+// No build SMP taskENTER_CRITICAL também adquire o spinlock entre núcleos
+// Publicações sem mudança visível (a 100 Hz, a maioria) não acordam ninguém
+void publicar_estado(const dados_caldeira_t *novo) {
+    uint32_t mudancas;
+    uint32_t instante_us = time_us_32();
+    
+    taskENTER_CRITICAL();
+    estado_atual = *novo;
+    mudancas = telemetria_diferencas(novo, &telemetria_versionada);
+    if (mudancas) {
+        telemetria_versionada = *novo;
+        versao_telemetria++;
+        instante_versao_us = instante_us;
+    }
+    taskEXIT_CRITICAL();
+    
+    if (mudancas) {
+        supervisor_liberar(sup_display, instante_us);
+        for (uint32_t i = 0; i < total_assinantes; i++) {
+            xTaskNotify(assinantes_telemetria[i], mudancas, eSetBits);
+        }
     }
-    neopixel_write();  // Efetiva transmissão para hardware
 }
 
-// Exibe cor sólida com controle de brilho personalizado
-// Permite ajuste dinâmico de intensidade luminosa (0.0 a 1.0)
-void exibir_cor_matriz_com_brilho(uint8_t r, uint8_t g, uint8_t b, float brightness) {
-    // Aplica fator de brilho customizado nos componentes RGB
-    uint8_t adj_r = (uint8_t)(r * brightness);
-    uint8_t adj_g = (uint8_t)(g * brightness);
-    uint8_t adj_b = (uint8_t)(b * brightness);
-    
-    for (int i = 0; i < LED_COUNT; i++) {
-        // Define pixel diretamente para evitar dupla atenuação
-        leds[i].R = adj_r;
-        leds[i].G = adj_g;
-        leds[i].B = adj_b;
+// Copia a telemetria inteira dentro de seção crítica (nunca lê um estado pela metade)
+// Retorna a versão da telemetria no momento da cópia
+uint32_t ler_estado(dados_caldeira_t *copia) {
+    uint32_t versao;
+    
+    taskENTER_CRITICAL();
+    *copia = estado_atual;
+    versao = versao_telemetria;
+    taskEXIT_CRITICAL();
+    
+    return versao;
+}
+
+// Imprime a telemetria de uma cópia local (sem segurar a seção crítica durante o printf)
+// No build de trace só registra o evento: sete linhas de printf por troca de
+// estado dominariam a linha do tempo e disputariam a USB com os blocos binários
+void imprimir_telemetria(const dados_caldeira_t *dados) {
+#if CALDEIRA_TRACE
+    TRACE_EVT(TRACE_APP_TELEMETRIA, dados->estado);
+#else
+    printf("Pressao: %ld kPa\n", (long)arredondar(dados->pressao));
+    printf("Temperatura: %ld C\n", (long)arredondar(dados->temperatura));
+    printf("Nivel: %ld%%\n", (long)arredondar(dados->nivel_agua));
+    printf("Aquecedor: %s\n", dados->aquecedor ? "Ligado" : "Desligado");
+    printf("Bomba: %s\n", dados->bomba ? "Ligado" : "Desligado");
+    printf("Alivio: %s\n", dados->alivio ? "Ligado" : "Desligado");
+#endif
+}
+
+// Seleciona o efeito da matriz LED sem bloquear nem tocar no hardware
+// O identificador vai na notificação da tarefa_matriz_led, que desenha os
+// quadros; vale a seleção mais recente
+void selecionar_efeito_matriz(efeito_id_t efeito) {
+    supervisor_liberar(sup_matriz, time_us_32());
+    taskENTER_CRITICAL();
+    metricas_matriz.selecoes++;
+    taskEXIT_CRITICAL();
+    
+    if (xTaskNotify(xMatrizTaskHandle, efeito, eSetValueWithoutOverwrite) == pdFAIL) {
+        taskENTER_CRITICAL();
+        metricas_matriz.sobrescritos++;        // Efeito anterior ainda não desenhado
+        taskEXIT_CRITICAL();
+        xTaskNotify(xMatrizTaskHandle, efeito, eSetValueWithOverwrite);
     }
-    neopixel_write();  // Transmite dados para matriz LED
 }
 
 // =============================================================================
-// FUNÇÕES DE LEITURA E PROCESSAMENTO DO JOYSTICK ANALÓGICO
+// DESPACHO DE COMANDOS E MEDIÇÃO DE LATÊNCIA
 // =============================================================================
 
-// Lê posição atual do joystick e retorna direção detectada
-// Implementa zona morta central para evitar comandos espúrios
-joystick_dir_t ler_joystick() {
-    // Seleciona canal ADC do eixo X e aguarda estabilização
-    adc_select_input(ADC_CH_X);
-    sleep_us(2);  // Tempo de settling do multiplexer ADC
-    uint16_t x = adc_read();
-    
-    // Seleciona canal ADC do eixo Y e aguarda estabilização
-    adc_select_input(ADC_CH_Y);
-    sleep_us(2);  // Tempo de settling do multiplexer ADC
-    uint16_t y = adc_read();
-    
-    // Análise de direção baseada em thresholds calibrados
-    // Implementa zona morta central para estabilidade
-    if (x > (JOY_CENTER_MAX + JOY_THRESHOLD)) {
-        return JOY_RIGHT;  // Comando: acionar estado OK
+// Entrega o comando diretamente à tarefa dona do estado via notificação
+// O valor da notificação carrega o instante da detecção (time_us_32) para
+// medição de latência; eSetValueWithOverwrite mantém apenas o comando mais
+// recente, sem fila para encher nem reordenação entre tarefas
+void despachar_estado(estado_caldeira_t estado, uint32_t instante_us) {
+    TaskHandle_t destino;
+
+    switch (estado) {
+        case CALDEIRA_NIVEL_BAIXO:  destino = xCaldeiraNivelTaskHandle;   break;
+        case CALDEIRA_TEMP_ALTA:    destino = xCaldeiraTempTaskHandle;    break;
+        case CALDEIRA_PRESSAO_ALTA: destino = xCaldeiraPressaoTaskHandle; break;
+        case CALDEIRA_OK:
+        default:                    destino = xCaldeiraOKTaskHandle;      break;
+    }
+
+    taskENTER_CRITICAL();                      // Joystick e emergência despacham
+    latencia_estado[estado].despachados++;
+    taskEXIT_CRITICAL();
+    supervisor_liberar(sup_estado[estado], instante_us);
+    
+    PERFIL_MARCAR_NOTIFICACAO(estado);
+    TRACE_EVT(TRACE_APP_DESPACHO, estado);
+    xTaskNotify(destino, instante_us, eSetValueWithOverwrite);
+}
+
+// Registra a latência de um comando já atuado e retorna o valor medido
+uint32_t registrar_latencia(estado_caldeira_t estado, uint32_t instante_us) {
+    uint32_t latencia_us = time_us_32() - instante_us;
+    latencia_t *l = &latencia_estado[estado];
+
+    if (l->amostras == 0 || latencia_us < l->min_us) {
+        l->min_us = latencia_us;
     }
-    if (x < (JOY_CENTER_MIN - JOY_THRESHOLD)) {
-        return JOY_LEFT;   // Comando: simular nível baixo
+    if (latencia_us > l->max_us) {
+        l->max_us = latencia_us;
     }
-    if (y > (JOY_CENTER_MAX + JOY_THRESHOLD)) {
-        return JOY_UP;     // Comando: simular pressão alta (emergência)
+    l->soma_us += latencia_us;
+    l->amostras++;
+    if (latencia_us > prazo_atuacao_us[estado]) {
+        l->prazo_perdido++;
+    }
+    supervisor_concluir(sup_estado[estado]);   // Atuação conclui o trabalho do estado
+
+    TRACE_EVT(TRACE_APP_ATUACAO, latencia_us);
+
+    return latencia_us;
+}
+
+// Resumo de comandos, latências e prazos desde o boot; retorna os prazos perdidos
+// (atuação e supervisor)
+// Comandos coalescidos: sobrescritos na notificação antes de a tarefa acordar
+uint32_t imprimir_metricas(void) {
+    const char *nomes[] = {"OK", "Nivel baixo", "Temp alta", "Pressao alta"};
+    uint32_t prazos_perdidos = 0;
+    
+    printf("\n=== METRICAS (%s) ===\n", CALDEIRA_SMP ? "SMP" : "1 nucleo");
+    printf("%-13s %6s %6s %6s %8s %8s %8s %6s\n",
+           "Estado", "Desp", "Atuad", "Coal", "Min us", "Media us", "Max us", "Prazo");
+    for (int i = 0; i < 4; i++) {
+        latencia_t *l = &latencia_estado[i];
+        printf("%-13s %6lu %6lu %6lu %8lu %8lu %8lu %6lu\n", nomes[i],
+               (unsigned long)l->despachados, (unsigned long)l->amostras,
+               (unsigned long)(l->despachados - l->amostras),
+               (unsigned long)l->min_us,
+               (unsigned long)(l->amostras ? l->soma_us / l->amostras : 0),
+               (unsigned long)l->max_us, (unsigned long)l->prazo_perdido);
+        prazos_perdidos += l->prazo_perdido;
     }
-    if (y < (JOY_CENTER_MIN - JOY_THRESHOLD)) {
-        return JOY_DOWN;   // Comando: simular temperatura alta
+    uint32_t quadros_transmitidos, quadros_substituidos;
+    hw_matriz_estatisticas(&quadros_transmitidos, &quadros_substituidos);
+    metricas_matriz_t *mz = &metricas_matriz;
+    printf("Matriz LED: %lu efeitos, %lu sobrescritos | %lu quadros a %d Hz, %lu atrasados | %lu por DMA, %lu substituidos na espera da linha\n",
+           (unsigned long)mz->selecoes, (unsigned long)mz->sobrescritos,
+           (unsigned long)mz->quadros, 1000 / MATRIZ_QUADRO_MS, (unsigned long)mz->atrasados,
+           (unsigned long)quadros_transmitidos, (unsigned long)quadros_substituidos);
+    
+    metricas_display_t *d = &metricas_display;
+    printf("Display: %lu versoes, %lu redesenhos, %lu linhas enviadas | atraso medio %lu us max %lu us\n",
+           (unsigned long)versao_telemetria, (unsigned long)d->redesenhos, (unsigned long)d->linhas,
+           (unsigned long)(d->amostras ? d->atraso_soma_us / d->amostras : 0),
+           (unsigned long)d->atraso_max_us);
+    
+    metricas_controle_t *c = &metricas_controle;
+    if (c->iteracoes > 0) {
+        printf("Controle %d Hz: %lu iteracoes, %lu atrasos | jitter medio %lu us max %lu us | custo medio %lu us max %lu us\n",
+               1000 / CONTROLE_PERIODO_MS, (unsigned long)c->iteracoes, (unsigned long)c->atrasos,
+               (unsigned long)(c->jitter_soma_us / c->iteracoes), (unsigned long)c->jitter_max_us,
+               (unsigned long)(c->custo_soma_us / c->iteracoes), (unsigned long)c->custo_max_us);
     }
+    consumo_imprimir();
+    prazos_perdidos += supervisor_imprimir();
     
-    return JOY_CENTER;     // Posição neutra: sem comando ativo
+    return prazos_perdidos;
+}
+
+// =============================================================================
+// ORÇAMENTO DE MEMÓRIA ESTÁTICA
+// =============================================================================
+
+// Tarefas do kernel: uma idle por núcleo e a tarefa de timer
+#define MEMORIA_TAREFAS_KERNEL  (configNUMBER_OF_CORES + 1)
+#define MEMORIA_PILHAS_KERNEL   (configNUMBER_OF_CORES * configMINIMAL_STACK_SIZE + configTIMER_TASK_STACK_DEPTH)
+
+// Tarefas e RAM opcionais dos modos de perfil e trace
+#define MEMORIA_PILHAS_OPCIONAIS    (CALDEIRA_PROFILING * PILHA_PERFIL + CALDEIRA_TRACE * PILHA_TRACE)
+#define MEMORIA_TAREFAS_OPCIONAIS   (CALDEIRA_PROFILING + CALDEIRA_TRACE)
+#define MEMORIA_TRACE_BYTES         (CALDEIRA_TRACE * TRACE_RAM_BYTES)
+
+#define MEMORIA_PILHAS_BYTES    ((MEMORIA_PILHAS_APP + MEMORIA_PILHAS_KERNEL + MEMORIA_PILHAS_OPCIONAIS) \
+                                 * sizeof(StackType_t))
+#define MEMORIA_TCBS_BYTES      ((MEMORIA_TAREFAS_APP + MEMORIA_TAREFAS_KERNEL + MEMORIA_TAREFAS_OPCIONAIS) \
+                                 * sizeof(StaticTask_t))
+#define MEMORIA_TOTAL_BYTES     (MEMORIA_PILHAS_BYTES + MEMORIA_TCBS_BYTES + \
+                                 configTOTAL_HEAP_SIZE + MEMORIA_TRACE_BYTES)
+
+_Static_assert(MEMORIA_TOTAL_BYTES <= MEMORIA_ORCAMENTO_BYTES,
+               "Objetos do RTOS excedem MEMORIA_ORCAMENTO_BYTES (memoria_caldeira.h)");
+
+// Relatório do orçamento; tudo calculado em tempo de compilação, exceto o
+// número de alocações do heap (deve ser zero: nada é alocado dinamicamente)
+void imprimir_memoria(void) {
+    printf("\n=== MEMORIA ESTATICA (bytes) ===\n");
+    printf("Pilhas: %u aplicacao + %u kernel + %u perfil/trace = %lu\n",
+           (unsigned)(MEMORIA_PILHAS_APP * sizeof(StackType_t)),
+           (unsigned)(MEMORIA_PILHAS_KERNEL * sizeof(StackType_t)),
+           (unsigned)(MEMORIA_PILHAS_OPCIONAIS * sizeof(StackType_t)),
+           (unsigned long)MEMORIA_PILHAS_BYTES);
+    printf("TCBs: %d tarefas x %u = %lu\n",
+           MEMORIA_TAREFAS_APP + MEMORIA_TAREFAS_KERNEL + MEMORIA_TAREFAS_OPCIONAIS,
+           (unsigned)sizeof(StaticTask_t), (unsigned long)MEMORIA_TCBS_BYTES);
+    HeapStats_t heap;
+    vPortGetHeapStats(&heap);
+    printf("Heap FreeRTOS: %lu (%lu alocacoes)\n",
+           (unsigned long)configTOTAL_HEAP_SIZE, (unsigned long)heap.xNumberOfSuccessfulAllocations);
+    printf("Aneis de trace: %lu\n", (unsigned long)MEMORIA_TRACE_BYTES);
+    printf("Total: %lu de %lu (%lu%%)\n", (unsigned long)MEMORIA_TOTAL_BYTES,
+           (unsigned long)MEMORIA_ORCAMENTO_BYTES,
+           (unsigned long)(MEMORIA_TOTAL_BYTES * 100 / MEMORIA_ORCAMENTO_BYTES));
+}
+
+#if CALDEIRA_HEAP_ESTRITO
+// Alocação do heap do FreeRTOS com o escalonador rodando (traceMALLOC no
+// FreeRTOSConfig.h): toda a memória deveria ter sido reservada no boot
+void caldeira_heap_apos_inicio(unsigned int tamanho) {
+    printf("Erro: %u bytes alocados do heap apos iniciar o escalonador\n", tamanho);
+    fflush(stdout);
+    abort();
+}
+#endif
+
+// Estouro de pilha detectado na troca de contexto (configCHECK_FOR_STACK_OVERFLOW 2):
+// a pilha da tarefa em memoria_caldeira.h está subdimensionada
+// O laço infinito para o escalonador; o watchdog sem alimentação reinicia a placa
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName) {
+    printf("Erro: estouro de pilha em %s\n", pcTaskName);
+    while(1);
 }
 
 // =============================================================================
 // FUNÇÕES DE INTERFACE VISUAL COM DISPLAY OLED SSD1306
 // =============================================================================
 
-// Atualiza interface do display com telemetria atual da caldeira
-// Exibe 7 linhas de informações conforme especificação do sistema
-void atualizar_display(dados_caldeira_t *dados) {
-    char texto[32];                    // Buffer temporário para formatação de texto
-    ssd1306_clear(display_buffer);     // Limpa framebuffer antes da renderização
+// Monta as 7 linhas de texto da telemetria conforme especificação do sistema
+// Formatação só com inteiros (comum/formato): sem o float do sprintf e
+// cortando o que não couber nas 16 colunas
+void formatar_linhas_display(const dados_caldeira_t *dados,
+                             char linhas[DISPLAY_LINHAS][DISPLAY_COLUNAS + 1]) {
+    const char* estados[] = {"OK", "Nv Low", "Tp High", "Pr high"};
+    formato_t f;
     
     // Linha 1: Identificação do estado operacional atual
-    const char* estados[] = {"OK", "Nv Low", "Tp High", "Pr high"};
-    sprintf(texto, "Estado: %s", estados[dados->estado]);
-    ssd1306_draw_string(display_buffer, 0, 0, texto);
+    formato_iniciar(&f, linhas[0], DISPLAY_COLUNAS + 1);
+    formato_texto(&f, "Estado: ");
+    formato_texto(&f, estados[dados->estado]);
     
     // Linha 2: Pressão interna do sistema em kPa
-    sprintf(texto, "Pressao:%.0f kPa", dados->pressao);
-    ssd1306_draw_string(display_buffer, 0, 8, texto);
+    formato_iniciar(&f, linhas[1], DISPLAY_COLUNAS + 1);
+    formato_texto(&f, "Pressao:");
+    formato_inteiro(&f, arredondar(dados->pressao), 0, ' ');
+    formato_texto(&f, " kPa");
     
     // Linha 3: Temperatura do vapor em graus Celsius
-    sprintf(texto, "Temp:   %.0f C", dados->temperatura);
-    ssd1306_draw_string(display_buffer, 0, 16, texto);
+    formato_iniciar(&f, linhas[2], DISPLAY_COLUNAS + 1);
+    formato_texto(&f, "Temp:   ");
+    formato_inteiro(&f, arredondar(dados->temperatura), 0, ' ');
+    formato_texto(&f, " C");
     
     // Linha 4: Nível percentual do reservatório de água
-    sprintf(texto, "Nivel:  %.0f%%", dados->nivel_agua);
-    ssd1306_draw_string(display_buffer, 0, 24, texto);
+    formato_iniciar(&f, linhas[3], DISPLAY_COLUNAS + 1);
+    formato_texto(&f, "Nivel:  ");
+    formato_inteiro(&f, arredondar(dados->nivel_agua), 0, ' ');
+    formato_texto(&f, "%");
     
-    // Linha 5: Status do sistema de aquecimento
-    sprintf(texto, "Aquec:  %s", dados->aquecedor ? "On" : "Off");
-    ssd1306_draw_string(display_buffer, 0, 32, texto);
-    
-    // Linha 6: Status da bomba de alimentação de água
-    sprintf(texto, "Bomba:  %s", dados->bomba ? "On" : "Off");
-    ssd1306_draw_string(display_buffer, 0, 40, texto);
-    
-    // Linha 7: Status da válvula de alívio de pressão
-    sprintf(texto, "Alivio: %s", dados->alivio ? "On" : "Off");
-    ssd1306_draw_string(display_buffer, 0, 48, texto);
+    // Linhas 5 a 7: Aquecimento, bomba de alimentação e válvula de alívio
+    formato_iniciar(&f, linhas[4], DISPLAY_COLUNAS + 1);
+    formato_texto(&f, "Aquec:  ");
+    formato_texto(&f, dados->aquecedor ? "On" : "Off");
+    formato_iniciar(&f, linhas[5], DISPLAY_COLUNAS + 1);
+    formato_texto(&f, "Bomba:  ");
+    formato_texto(&f, dados->bomba ? "On" : "Off");
+    formato_iniciar(&f, linhas[6], DISPLAY_COLUNAS + 1);
+    formato_texto(&f, "Alivio: ");
+    formato_texto(&f, dados->alivio ? "On" : "Off");
+}
+
+// Texto atualmente na tela, para enviar só as linhas que mudaram
+static char linhas_exibidas[DISPLAY_LINHAS][DISPLAY_COLUNAS + 1];
+
+// Atualiza interface do display com telemetria atual da caldeira
+// Cada linha de texto ocupa uma página de 8 pixels: só as páginas cujo texto
+// mudou são redesenhadas e enviadas (128 bytes cada, em vez do quadro de 1 KB)
+// 'completo' redesenha e envia a tela inteira
+void atualizar_display(const dados_caldeira_t *dados, bool completo) {
+    char linhas[DISPLAY_LINHAS][DISPLAY_COLUNAS + 1];
+    formatar_linhas_display(dados, linhas);
     
-    render_on_display(display_buffer, &area_display);  // Transfere para hardware
+    if (completo) {
+        ssd1306_clear(display_buffer);     // Limpa framebuffer antes da renderização
+    }
+    for (int i = 0; i < DISPLAY_LINHAS; i++) {
+        if (!completo && strcmp(linhas[i], linhas_exibidas[i]) == 0) {
+            continue;
+        }
+        uint8_t *pagina = &display_buffer[i * ssd1306_width];
+        memset(pagina, 0, ssd1306_width);
+        ssd1306_draw_string(display_buffer, 0, i * ssd1306_page_height, linhas[i]);
+        strcpy(linhas_exibidas[i], linhas[i]);
+        
+        if (!completo) {
+            struct render_area area_linha = {
+                .start_column = 0,
+                .end_column = ssd1306_width - 1,
+                .start_page = i,
+                .end_page = i
+            };
+            calculate_render_area_buffer_length(&area_linha);
+            render_on_display(pagina, &area_linha);
+            metricas_display.linhas++;
+        }
+    }
+    if (completo) {
+        render_on_display(display_buffer, &area_display);  // Transfere para hardware
+        metricas_display.linhas += ssd1306_n_pages;
+    }
+    metricas_display.redesenhos++;
 }
 
 // =============================================================================
 // TAREFAS CONCORRENTES DO SISTEMA FREERTOS
 // =============================================================================
 
-// Tarefa de entrada: monitoramento contínuo do joystick analógico
-// Prioridade 5 (máxima): garante resposta imediata aos comandos do usuário
-void tarefa_joystick(void *pvParameters) {
-    joystick_dir_t dir_anterior = JOY_CENTER;  // Estado anterior para detecção de mudança
-    estado_caldeira_t novo_estado;             // Comando a ser enviado via fila
+// Tarefa de Controle: laço periódico do processo da caldeira
+// Prioridade 6 (máxima): a cada 10 ms decide atuadores e alarmes pelas medidas,
+// integra o modelo físico e publica a telemetria; mudanças de estado são
+// despachadas às tarefas de estado com o instante da detecção
+// Também amostra o joystick a cada período para o filtro, que só acorda a
+// tarefa dele num evento de direção; o display acorda pelas versões do canal
+// de telemetria
+void tarefa_controle(void *pvParameters) {
+    modelo_caldeira_t modelo;
+    controle_caldeira_t controle;
+    estado_caldeira_t estado_anterior = CALDEIRA_OK;   // main() já despachou o estado inicial
+    uint32_t inicio_anterior_us = 0;
+    metricas_controle_t *m = &metricas_controle;
+    
+    modelo_iniciar(&modelo);
+    controle_iniciar(&controle);
+    joystick_filtro_iniciar(&filtro_joystick, joystick_evento, NULL);
+    
+    TickType_t ultimo_despertar = xTaskGetTickCount();
+    fase_controle = ultimo_despertar;
     
     while (true) {
-        joystick_dir_t dir_atual = ler_joystick();  // Leitura ADC dos eixos X/Y
+        // Período fixo: acorda relativo ao despertar anterior, sem acumular deriva
+        if (xTaskDelayUntil(&ultimo_despertar, pdMS_TO_TICKS(CONTROLE_PERIODO_MS)) == pdFALSE) {
+            m->atrasos++;
+        }
+        uint32_t inicio_us = time_us_32();
+        supervisor_liberar(sup_controle, inicio_us);
+        
+        // Lógica de controle com histerese sobre as medidas atuais
+        estado_caldeira_t estado = controle_passo(&controle, &modelo);
+        
+        // Integração do processo com os atuadores decididos e as perturbações
+        modelo_passo(&modelo, &controle.atuadores, perturbacoes_ativas,
+                     CONTROLE_PERIODO_MS / 1000.0f);
+        
+        dados_caldeira_t dados = {
+            .estado = estado,
+            .pressao = modelo.pressao,
+            .temperatura = modelo.temperatura,
+            .nivel_agua = modelo.nivel_agua,
+            .aquecedor = controle.atuadores.aquecedor,
+            .bomba = controle.atuadores.bomba,
+            .alivio = controle.atuadores.alivio
+        };
+        publicar_estado(&dados);
+        
+        if (estado != estado_anterior) {
+            despachar_estado(estado, inicio_us);
+            estado_anterior = estado;
+        }
+        
+        // Joystick: o filtro gera o evento de direção (joystick_evento)
+        ler_joystick(ultimo_despertar * portTICK_PERIOD_MS);
+        
+        // Temporização da iteração (jitter a partir da segunda)
+        uint32_t custo_us = time_us_32() - inicio_us;
+        if (m->iteracoes > 0) {
+            int32_t desvio = (int32_t)(inicio_us - inicio_anterior_us) - CONTROLE_PERIODO_MS * 1000;
+            uint32_t jitter_us = (uint32_t)(desvio < 0 ? -desvio : desvio);
+            if (jitter_us > m->jitter_max_us) {
+                m->jitter_max_us = jitter_us;
+            }
+            m->jitter_soma_us += jitter_us;
+        }
+        if (custo_us > m->custo_max_us) {
+            m->custo_max_us = custo_us;
+        }
+        m->custo_soma_us += custo_us;
+        m->iteracoes++;
+        inicio_anterior_us = inicio_us;
+        supervisor_concluir(sup_controle);     // Batimento do controle
+    }
+}
+
+// Tarefa de entrada: perturbações comandadas pelo joystick analógico
+// Prioridade 5: cada direção injeta uma perturbação no processo; o estado da
+// caldeira resulta da física e do controle, não do comando direto
+// Acorda só quando o controle notifica uma nova direção (sem polling)
+void tarefa_joystick(void *pvParameters) {
+    while (true) {
+        uint32_t valor;
+        xTaskNotifyWait(0, UINT32_MAX, &valor, portMAX_DELAY);
+        joystick_dir_t dir_atual = (joystick_dir_t)valor;
         
-        // Detecta transição de estado (evita comandos repetitivos)
-        if (dir_atual != dir_anterior && dir_atual != JOY_CENTER) {
-            // Mapeamento de direções para estados críticos da caldeira
+        // Centro só encerra o gesto; cada direção nova é um comando
+        if (dir_atual != JOY_CENTER) {
+            TRACE_EVT(TRACE_APP_JOYSTICK, dir_atual);
+            
+            // Mapeamento de direções para perturbações do processo
             switch (dir_atual) {
                 case JOY_RIGHT:
-                    novo_estado = CALDEIRA_OK;
-                    printf("Joystick: Estado OK\n");
+                    perturbacoes_ativas = PERTURBACAO_NENHUMA;
+                    printf("Joystick: perturbacoes removidas\n");
                     break;
                 case JOY_LEFT:
-                    novo_estado = CALDEIRA_NIVEL_BAIXO;
-                    printf("Joystick: Nível baixo\n");
+                    perturbacoes_ativas = PERTURBACAO_VAZAMENTO;
+                    printf("Joystick: vazamento de agua\n");
                     break;
                 case JOY_DOWN:
-                    novo_estado = CALDEIRA_TEMP_ALTA;
-                    printf("Joystick: Temperatura alta\n");
+                    perturbacoes_ativas = PERTURBACAO_QUEIMADOR;
+                    printf("Joystick: queimador travado\n");
                     break;
                 case JOY_UP:
-                    novo_estado = CALDEIRA_PRESSAO_ALTA;
-                    printf("Joystick: Pressão alta\n");
+                    perturbacoes_ativas = PERTURBACAO_QUEIMADOR | PERTURBACAO_SAIDA_BLOQUEADA;
+                    printf("Joystick: saida de vapor bloqueada\n");
                     break;
                 default:
-                    novo_estado = CALDEIRA_OK;
                     break;
             }
-            
-            // Envia comando via fila thread-safe para tarefas de estado
-            xQueueSend(xEstadoQueue, &novo_estado, 0);
         }
-        
-        dir_anterior = dir_atual;                   // Atualiza estado anterior
-        vTaskDelay(pdMS_TO_TICKS(100));             // Período de amostragem: 100ms
+        supervisor_concluir(sup_joystick);
     }
 }
 
 // Tarefa de Estado Operacional Normal da Caldeira
 // Prioridade 1 (baixa): operação padrão sem urgência crítica
 void tarefa_caldeira_ok(void *pvParameters) {
+    bool primeira = true;                           // Estado inicial despachado pela main()
+    
     while (true) {
-        estado_caldeira_t estado_recebido;          // Comando recebido da fila
+        uint32_t instante_us;                       // Instante da detecção no controle
         
-        // Aguarda comando específico para este estado (bloqueante)
-        if (xQueueReceive(xEstadoQueue, &estado_recebido, portMAX_DELAY) == pdTRUE) {
-            if (estado_recebido == CALDEIRA_OK) {
-                printf("=== CALDEIRA OK ===\n");
-                
-                // Configuração de telemetria para operação normal
-                estado_atual.estado = CALDEIRA_OK;
-                estado_atual.pressao = 300.0;          // Pressão controlada: 300 kPa
-                estado_atual.temperatura = 90.0;       // Temperatura segura: 90°C
-                estado_atual.nivel_agua = 54.0;        // Nível adequado: 54%
-                estado_atual.aquecedor = true;         // Aquecimento ativo
-                estado_atual.bomba = false;            // Bomba desnecessária
-                estado_atual.alivio = false;           // Válvula fechada
-                
-                // Sinalização visual: LED verde (operação normal)
-                exibir_cor_matriz(0, 255, 0);
-                
-                // Log detalhado da telemetria atual
-                printf("Pressao: %.0f kPa\n", estado_atual.pressao);
-                printf("Temperatura: %.0f C\n", estado_atual.temperatura);
-                printf("Nivel: %.0f%%\n", estado_atual.nivel_agua);
-                printf("Aquecedor: %s\n", estado_atual.aquecedor ? "Ligado" : "Desligado");
-                printf("Bomba: %s\n", estado_atual.bomba ? "Ligado" : "Desligado");
-                printf("Alivio: %s\n", estado_atual.alivio ? "Ligado" : "Desligado");
-            } else {
-                // Rejeita comando: retorna à fila para tarefa apropriada
-                xQueueSend(xEstadoQueue, &estado_recebido, 0);
+        // Aguarda comando destinado a este estado (bloqueante, sem polling)
+        if (xTaskNotifyWait(0, UINT32_MAX, &instante_us, portMAX_DELAY) == pdTRUE) {
+            PERFIL_REGISTRAR_DESPERTAR(CALDEIRA_OK, "Caldeira_OK_Task");
+            
+            // Sinalização visual: verde respirando (operação normal)
+            selecionar_efeito_matriz(EFEITO_OK);
+            registrar_latencia(CALDEIRA_OK, instante_us);
+            
+            // Log detalhado da telemetria atual
+            dados_caldeira_t dados;
+            ler_estado(&dados);
+            printf("=== CALDEIRA OK ===\n");
+            imprimir_telemetria(&dados);
+            
+            // Ao voltar de um alarme: resumo de latências e do laço de controle
+            if (!primeira) {
+                imprimir_metricas();
             }
+            primeira = false;
         }
-        
-        vTaskDelay(pdMS_TO_TICKS(500));             // Período de execução: 500ms
     }
 }
 
 // Tarefa de Estado Crítico: Nível de Água Insuficiente
-// Prioridade 2 (baixa): ativa bomba de alimentação para correção
+// Prioridade 2 (baixa): o controle mantém a bomba ligada e o aquecedor desligado
 void tarefa_caldeira_nivel(void *pvParameters) {
     while (true) {
-        estado_caldeira_t estado_recebido;
+        uint32_t instante_us;
         
-        if (xQueueReceive(xEstadoQueue, &estado_recebido, portMAX_DELAY) == pdTRUE) {
-            if (estado_recebido == CALDEIRA_NIVEL_BAIXO) {
-                printf("=== NIVEL DE AGUA BAIXO ===\n");
-                
-                // Atualiza dados da caldeira
-                estado_atual.estado = CALDEIRA_NIVEL_BAIXO;
-                estado_atual.pressao = 310.0;
-                estado_atual.temperatura = 95.0;
-                estado_atual.nivel_agua = 19.0;
-                estado_atual.aquecedor = false;
-                estado_atual.bomba = true;
-                estado_atual.alivio = false;
-                
-                // Sinalização visual: LED amarelo (atenção requerida)
-                exibir_cor_matriz(255, 255, 0);
-                
-                printf("Pressao: %.0f kPa\n", estado_atual.pressao);
-                printf("Temperatura: %.0f C\n", estado_atual.temperatura);
-                printf("Nivel: %.0f%%\n", estado_atual.nivel_agua);
-                printf("Aquecedor: %s\n", estado_atual.aquecedor ? "Ligado" : "Desligado");
-                printf("Bomba: %s\n", estado_atual.bomba ? "Ligado" : "Desligado");
-                printf("Alivio: %s\n", estado_atual.alivio ? "Ligado" : "Desligado");
-            } else {
-                xQueueSend(xEstadoQueue, &estado_recebido, 0);
-            }
+        if (xTaskNotifyWait(0, UINT32_MAX, &instante_us, portMAX_DELAY) == pdTRUE) {
+            PERFIL_REGISTRAR_DESPERTAR(CALDEIRA_NIVEL_BAIXO, "Caldeira_Nivel_Task");
+            
+            // Sinalização visual: barra amarela com o nível de água
+            selecionar_efeito_matriz(EFEITO_NIVEL_BAIXO);
+            registrar_latencia(CALDEIRA_NIVEL_BAIXO, instante_us);
+            
+            dados_caldeira_t dados;
+            ler_estado(&dados);
+            printf("=== NIVEL DE AGUA BAIXO ===\n");
+            imprimir_telemetria(&dados);
         }
-        
-        vTaskDelay(pdMS_TO_TICKS(400));
     }
 }
 
 // Tarefa de Estado Crítico: Superaquecimento do Sistema
-// Prioridade 3 (média): desliga aquecimento para resfriamento controlado
+// Prioridade 3 (média): o controle corta o aquecimento e injeta água fria
 void tarefa_caldeira_temperatura(void *pvParameters) {
     while (true) {
-        estado_caldeira_t estado_recebido;
+        uint32_t instante_us;
         
-        if (xQueueReceive(xEstadoQueue, &estado_recebido, portMAX_DELAY) == pdTRUE) {
-            if (estado_recebido == CALDEIRA_TEMP_ALTA) {
-                printf("=== TEMPERATURA ALTA ===\n");
-                
-                // Atualiza dados da caldeira
-                estado_atual.estado = CALDEIRA_TEMP_ALTA;
-                estado_atual.pressao = 330.0;
-                estado_atual.temperatura = 150.0;
-                estado_atual.nivel_agua = 5.0;
-                estado_atual.aquecedor = false;
-                estado_atual.bomba = false;
-                estado_atual.alivio = false;
-                
-                // Sinalização visual: LED laranja (superaquecimento)
-                exibir_cor_matriz(255, 165, 0);
-                
-                printf("Pressao: %.0f kPa\n", estado_atual.pressao);
-                printf("Temperatura: %.0f C\n", estado_atual.temperatura);
-                printf("Nivel: %.0f%%\n", estado_atual.nivel_agua);
-                printf("Aquecedor: %s\n", estado_atual.aquecedor ? "Ligado" : "Desligado");
-                printf("Bomba: %s\n", estado_atual.bomba ? "Ligado" : "Desligado");
-                printf("Alivio: %s\n", estado_atual.alivio ? "Ligado" : "Desligado");
-            } else {
-                xQueueSend(xEstadoQueue, &estado_recebido, 0);
-            }
+        if (xTaskNotifyWait(0, UINT32_MAX, &instante_us, portMAX_DELAY) == pdTRUE) {
+            PERFIL_REGISTRAR_DESPERTAR(CALDEIRA_TEMP_ALTA, "Caldeira_Temp_Task");
+            
+            // Sinalização visual: laranja percorrendo a borda (superaquecimento)
+            selecionar_efeito_matriz(EFEITO_TEMP_ALTA);
+            registrar_latencia(CALDEIRA_TEMP_ALTA, instante_us);
+            
+            dados_caldeira_t dados;
+            ler_estado(&dados);
+            printf("=== TEMPERATURA ALTA ===\n");
+            imprimir_telemetria(&dados);
         }
-        
-        vTaskDelay(pdMS_TO_TICKS(300));
     }
 }
 
 // Tarefa de Estado de Emergência: Pressão Crítica Excessiva
-// Prioridade 4 (máxima): protocolo de segurança com preempção natural
+// Prioridade 4 (máxima entre os estados): o controle abre a válvula de alívio
+// até a pressão cair abaixo do limiar de histerese; a volta ao estado normal
+// é detectada pelo laço de controle, não por temporização
 void tarefa_caldeira_pressao(void *pvParameters) {
     while (true) {
-        estado_caldeira_t estado_recebido;          // Comando crítico recebido
+        uint32_t instante_us;                       // Instante da detecção do comando crítico
         
-        if (xQueueReceive(xEstadoQueue, &estado_recebido, portMAX_DELAY) == pdTRUE) {
-            if (estado_recebido == CALDEIRA_PRESSAO_ALTA) {
-                printf("=== PRESSAO ALTA - EMERGENCIA ===\n");
-                
-                // Configuração crítica: ativação de todos os sistemas de segurança
-                estado_atual.estado = CALDEIRA_PRESSAO_ALTA;
-                estado_atual.pressao = 500.0;          // Pressão perigosa: 500 kPa
-                estado_atual.temperatura = 120.0;      // Temperatura elevada: 120°C
-                estado_atual.nivel_agua = 54.0;        // Nível mantido: 54%
-                estado_atual.aquecedor = true;         // Aquecimento mantido
-                estado_atual.bomba = true;             // Bomba ativa (resfriamento)
-                estado_atual.alivio = true;            // Válvula aberta (alívio)
-                
-                // Sinalização visual crítica: LED vermelho (máxima urgência)
-                exibir_cor_matriz(255, 0, 0);
-                
-                printf("!!! SITUACAO CRITICA !!!\n");
-                printf("Pressao: %.0f kPa\n", estado_atual.pressao);
-                printf("Temperatura: %.0f C\n", estado_atual.temperatura);
-                printf("Nivel: %.0f%%\n", estado_atual.nivel_agua);
-                printf("Aquecedor: %s\n", estado_atual.aquecedor ? "Ligado" : "Desligado");
-                printf("Bomba: %s\n", estado_atual.bomba ? "Ligado" : "Desligado");
-                printf("Alivio: %s\n", estado_atual.alivio ? "Ligado" : "Desligado");
-                
-                // Protocolo de emergência: 5 segundos com preempção natural do RTOS
-                // Durante vTaskDelay(), outras tarefas podem executar brevemente
-                // mas esta tarefa retoma controle por sua prioridade máxima
-                for (int i = 5; i > 0; i--) {
-                    printf(">>> EMERGENCIA: %d segundos restantes <<<\n", i);
-                    vTaskDelay(pdMS_TO_TICKS(1000));    // Permite preempção durante delay
-                    
-                    // Reafirma controle crítico após possível preempção
-                    exibir_cor_matriz(255, 0, 0);      // Reforça sinalização vermelha
-                }
-                
-                printf("=== EMERGENCIA FINALIZADA AUTOMATICAMENTE (5s) ===\n");
-                
-                // Retorno automático para operação segura
-                estado_caldeira_t estado_ok = CALDEIRA_OK;
-                xQueueSend(xEstadoQueue, &estado_ok, 0);
-                
-            } else {
-                // Rejeita comando não-crítico: retorna à fila
-                xQueueSend(xEstadoQueue, &estado_recebido, 0);
-            }
+        if (xTaskNotifyWait(0, UINT32_MAX, &instante_us, portMAX_DELAY) == pdTRUE) {
+            PERFIL_REGISTRAR_DESPERTAR(CALDEIRA_PRESSAO_ALTA, "Caldeira_Pressao_Task");
+            
+            // Sinalização visual crítica: vermelho piscando (máxima urgência)
+            selecionar_efeito_matriz(EFEITO_PRESSAO_ALTA);
+            uint32_t latencia_us = registrar_latencia(CALDEIRA_PRESSAO_ALTA, instante_us);
+            
+            dados_caldeira_t dados;
+            ler_estado(&dados);
+            printf("=== PRESSAO ALTA - EMERGENCIA ===\n");
+            printf("!!! SITUACAO CRITICA: VALVULA DE ALIVIO ABERTA !!!\n");
+            imprimir_telemetria(&dados);
+            
+            // Relatório de latência detecção -> atuação (impresso fora do caminho crítico)
+            latencia_t *l = &latencia_estado[CALDEIRA_PRESSAO_ALTA];
+            printf("Latencia emergencia (%s): atual %lu us | min %lu us | max %lu us | media %lu us (%lu amostras)\n",
+                   CALDEIRA_SMP ? "SMP" : "1 nucleo",
+                   (unsigned long)latencia_us, (unsigned long)l->min_us, (unsigned long)l->max_us,
+                   (unsigned long)(l->soma_us / l->amostras), (unsigned long)l->amostras);
+        }
+    }
+}
+
+// Próximo instante de quadro depois de 'instante', na grade do controle
+// (fase_controle + múltiplos de MATRIZ_QUADRO_MS): com o mesmo período, a
+// matriz e o controle acordam no mesmo tick
+static TickType_t grade_quadro(TickType_t instante) {
+    const TickType_t periodo = pdMS_TO_TICKS(MATRIZ_QUADRO_MS);
+    return fase_controle + ((instante - fase_controle) / periodo + 1) * periodo;
+}
+
+// Tarefa de Saída da Matriz LED: único escritor dos quadros da matriz
+// Escalonador de quadros a taxa fixa: recebe o identificador do efeito pela
+// notificação e o desenha na hora; enquanto o efeito for animado (ou o
+// dithering tiver fração), desenha um quadro em cada instante da grade, sem
+// acumular deriva; efeito estático é desenhado uma vez e a tarefa dorme até
+// a próxima seleção
+// O tempo do efeito é o instante programado do quadro, não o do despertar,
+// então o atraso de um quadro não distorce a animação
+void tarefa_matriz_led(void *pvParameters) {
+    efeito_id_t efeito = EFEITO_APAGADO;
+    bool animado = false;
+    TickType_t inicio = 0;                         // Seleção do efeito atual
+    TickType_t proximo = 0;                        // Instante do próximo quadro
+    metricas_matriz_t *m = &metricas_matriz;
+    
+    while (true) {
+        TickType_t espera = portMAX_DELAY;
+        TickType_t quadro;
+        uint32_t valor;
+        
+        if (animado) {
+            TickType_t agora = xTaskGetTickCount();
+            espera = (int32_t)(proximo - agora) > 0 ? proximo - agora : 0;
+        }
+        bool selecionado = xTaskNotifyWait(0, UINT32_MAX, &valor, espera) == pdTRUE;
+        TickType_t agora = xTaskGetTickCount();
+        if (selecionado) {
+            efeito = (efeito_id_t)valor;
+            inicio = agora;
+            quadro = agora;
+        } else if ((int32_t)(agora - proximo) >= (int32_t)pdMS_TO_TICKS(MATRIZ_QUADRO_MS)) {
+            m->atrasados++;                        // Perdeu ao menos um quadro inteiro
+            quadro = agora;
+        } else {
+            quadro = proximo;
         }
         
-        vTaskDelay(pdMS_TO_TICKS(200));             // Período mínimo para emergência
+        dados_caldeira_t dados;
+        ler_estado(&dados);
+        animado = exibir_efeito_matriz(efeito, (quadro - inicio) * portTICK_PERIOD_MS,
+                                       (uint32_t)arredondar(dados.nivel_agua));
+        m->quadros++;
+        proximo = grade_quadro(quadro);
+        if (selecionado) {
+            supervisor_concluir(sup_matriz);       // Primeiro quadro do efeito publicado
+        }
     }
 }
 
-// Tarefa de Interface Visual: Atualização Contínua do Display
+// Tarefa de Interface Visual: Atualização do Display por Evento
 // Prioridade 1 (baixa): não interfere no controle crítico da caldeira
+// Assina o canal de telemetria e envia só as linhas que mudaram; mudança de
+// estado ou atuador aparece na hora, mudança só de valor espera o intervalo
+// mínimo desde o último redesenho (agrupando as que chegarem nesse meio tempo)
 void tarefa_display(void *pvParameters) {
+    dados_caldeira_t copia;
+    
+#if CALDEIRA_CARGA_DISPLAY
     while (true) {
-        atualizar_display(&estado_atual);          // Renderiza telemetria atual
-        vTaskDelay(pdMS_TO_TICKS(1000));           // Período de atualização: 1s
+        ler_estado(&copia);
+        atualizar_display(&copia, true);           // Carga máxima: quadro inteiro sem pausa
+        supervisor_concluir(sup_display);
+        taskYIELD();
     }
+#else
+    uint32_t versao_exibida = ler_estado(&copia);
+    atualizar_display(&copia, true);               // Tela inteira na partida
+    TickType_t ultimo_redesenho = xTaskGetTickCount();
+    
+    while (true) {
+        uint32_t mudancas;
+        xTaskNotifyWait(0, UINT32_MAX, &mudancas, portMAX_DELAY);
+        
+        // Só valores: segura até completar o intervalo, salvo se chegar um estado novo
+        const TickType_t intervalo = pdMS_TO_TICKS(DISPLAY_INTERVALO_MIN_MS);
+        while (!(mudancas & TELEMETRIA_MUDOU_ESTADO)) {
+            TickType_t decorrido = xTaskGetTickCount() - ultimo_redesenho;
+            uint32_t novas;
+            if (decorrido >= intervalo) {
+                break;                             // Intervalo já cumprido
+            }
+            if (xTaskNotifyWait(0, UINT32_MAX, &novas, intervalo - decorrido) == pdTRUE) {
+                mudancas |= novas;
+            }
+        }
+        
+        uint32_t versao = ler_estado(&copia);
+        if (versao == versao_exibida) {
+            supervisor_concluir(sup_display);      // Nada novo a exibir
+            continue;
+        }
+        atualizar_display(&copia, false);
+        supervisor_concluir(sup_display);
+        versao_exibida = versao;
+        ultimo_redesenho = xTaskGetTickCount();
+        
+        // Atraso da publicação da versão até a tela atualizada
+        uint32_t atraso_us = time_us_32() - instante_versao_us;
+        metricas_display_t *d = &metricas_display;
+        if (atraso_us > d->atraso_max_us) {
+            d->atraso_max_us = atraso_us;
+        }
+        d->atraso_soma_us += atraso_us;
+        d->amostras++;
+    }
+#endif
 }
 
 // =============================================================================
@@ -559,17 +1044,8 @@ int main() {
     printf("\n=== SISTEMA DE CONTROLE DE CALDEIRA ===\n");
     printf("Inicializando componentes...\n");
     
-    // Configuração do subsistema ADC para leitura do joystick analógico
-    adc_init();                                     // Inicializa controlador ADC
-    adc_gpio_init(VRX_PIN);                        // Configura GPIO 26 como entrada ADC
-    adc_gpio_init(VRY_PIN);                        // Configura GPIO 27 como entrada ADC
-    
-    // Configuração do subsistema I2C para comunicação com display OLED
-    i2c_init(i2c1, ssd1306_i2c_clock * 1000);     // Inicializa I2C1 com clock configurado
-    gpio_set_function(SDA_PIN, GPIO_FUNC_I2C);     // Configura GPIO 14 como SDA
-    gpio_set_function(SCL_PIN, GPIO_FUNC_I2C);     // Configura GPIO 15 como SCL
-    gpio_pull_up(SDA_PIN);                         // Resistor pull-up interno SDA
-    gpio_pull_up(SCL_PIN);                         // Resistor pull-up interno SCL
+    // ADC do joystick e I2C do display (caldeira_hw_pico.c)
+    hw_iniciar();
     
     // Inicialização do display OLED SSD1306 e configuração de framebuffer
     ssd1306_init();
@@ -582,63 +1058,92 @@ int main() {
     
     printf("Componentes inicializados com sucesso!\n");
     
-    // Criação da fila de comunicação inter-tarefas thread-safe
-    xEstadoQueue = xQueueCreate(10, sizeof(estado_caldeira_t));
-    if (xEstadoQueue == NULL) {
-        printf("Erro: Falha na criação da fila\n");
-        while(1);  // Falha crítica: sistema não pode operar
-    }
-    
     // Criação das tarefas concorrentes com prioridades hierárquicas
     // Prioridades baseadas na criticidade dos estados da caldeira
+    // Pilhas e TCBs estáticos: a criação não pode falhar por falta de heap
     
-    // Tarefa de entrada: detecção de comandos via joystick
-    if (xTaskCreate(tarefa_joystick, "Joystick_Task", 512, NULL, 5, &xJoystickTaskHandle) != pdPASS) {
-        printf("Erro: Falha na criação da tarefa do joystick\n");
-        while(1);
-    }
+    // Laço de controle: modelo físico e atuadores a 100 Hz
+    xControleTaskHandle = xTaskCreateStatic(tarefa_controle, "Controle_Task",
+        PILHA_CONTROLE, NULL, 6, pilha_controle, &tcb_tarefas[0]);
+    
+    // Tarefa de entrada: injeção de perturbações via joystick
+    xJoystickTaskHandle = xTaskCreateStatic(tarefa_joystick, "Joystick_Task",
+        PILHA_JOYSTICK, NULL, 5, pilha_joystick, &tcb_tarefas[1]);
     
     // Tarefa de estado normal: operação segura padrão
-    if (xTaskCreate(tarefa_caldeira_ok, "Caldeira_OK_Task", 512, NULL, 1, &xCaldeiraOKTaskHandle) != pdPASS) {
-        printf("Erro: Falha na criação da tarefa Estado OK\n");
-        while(1);
-    }
+    xCaldeiraOKTaskHandle = xTaskCreateStatic(tarefa_caldeira_ok, "Caldeira_OK_Task",
+        PILHA_ESTADO_OK, NULL, 1, pilha_caldeira_ok, &tcb_tarefas[2]);
     
     // Tarefa de estado crítico: nível de água insuficiente
-    if (xTaskCreate(tarefa_caldeira_nivel, "Caldeira_Nivel_Task", 512, NULL, 2, &xCaldeiraNivelTaskHandle) != pdPASS) {
-        printf("Erro: Falha na criação da tarefa Nível Baixo\n");
-        while(1);
-    }
+    xCaldeiraNivelTaskHandle = xTaskCreateStatic(tarefa_caldeira_nivel, "Caldeira_Nivel_Task",
+        PILHA_ESTADO, NULL, 2, pilha_caldeira_nivel, &tcb_tarefas[3]);
     
     // Tarefa de estado crítico: superaquecimento do sistema
-    if (xTaskCreate(tarefa_caldeira_temperatura, "Caldeira_Temp_Task", 512, NULL, 3, &xCaldeiraTempTaskHandle) != pdPASS) {
-        printf("Erro: Falha na criação da tarefa Temperatura Alta\n");
-        while(1);
-    }
+    xCaldeiraTempTaskHandle = xTaskCreateStatic(tarefa_caldeira_temperatura, "Caldeira_Temp_Task",
+        PILHA_ESTADO, NULL, 3, pilha_caldeira_temp, &tcb_tarefas[4]);
     
     // Tarefa de emergência: pressão crítica excessiva
-    if (xTaskCreate(tarefa_caldeira_pressao, "Caldeira_Pressao_Task", 512, NULL, 4, &xCaldeiraPressaoTaskHandle) != pdPASS) {
-        printf("Erro: Falha na criação da tarefa Pressão Alta\n");
-        while(1);
-    }
+    xCaldeiraPressaoTaskHandle = xTaskCreateStatic(tarefa_caldeira_pressao, "Caldeira_Pressao_Task",
+        PILHA_ESTADO, NULL, 4, pilha_caldeira_pressao, &tcb_tarefas[5]);
     
     // Tarefa de interface: atualização visual contínua
-    if (xTaskCreate(tarefa_display, "Display_Task", 512, NULL, 1, &xDisplayTaskHandle) != pdPASS) {
-        printf("Erro: Falha na criação da tarefa do display\n");
-        while(1);
-    }
+    xDisplayTaskHandle = xTaskCreateStatic(tarefa_display, "Display_Task",
+        PILHA_DISPLAY, NULL, 1, pilha_display, &tcb_tarefas[6]);
+    
+    // Tarefa de saída: efeitos da matriz LED a taxa fixa, quadros para o DMA
+    xMatrizTaskHandle = xTaskCreateStatic(tarefa_matriz_led, "Matriz_LED_Task",
+        PILHA_MATRIZ, NULL, 4, pilha_matriz, &tcb_tarefas[7]);
+    
+    // Supervisor: acima do controle, para detectar inclusive o controle travado
+    xSupervisorTaskHandle = xTaskCreateStatic(tarefa_supervisor, "Supervisor_Task",
+        PILHA_SUPERVISOR, NULL, 7, pilha_supervisor, &tcb_tarefas[8]);
+    
+    // Prazos e batimentos monitorados; críticas: controle, emergência e matriz LED
+    sup_controle = supervisor_registrar("Controle_Task", PRAZO_CONTROLE_US, BATIMENTO_CONTROLE_US, true);
+    sup_joystick = supervisor_registrar("Joystick_Task", PRAZO_JOYSTICK_US, 0, false);
+    sup_estado[CALDEIRA_OK] = supervisor_registrar("Caldeira_OK_Task", PRAZO_ESTADO_US, 0, false);
+    sup_estado[CALDEIRA_NIVEL_BAIXO] = supervisor_registrar("Caldeira_Nivel_Task", PRAZO_ESTADO_US, 0, false);
+    sup_estado[CALDEIRA_TEMP_ALTA] = supervisor_registrar("Caldeira_Temp_Task", PRAZO_ESTADO_US, 0, false);
+    sup_estado[CALDEIRA_PRESSAO_ALTA] = supervisor_registrar("Caldeira_Pressao_Task", PRAZO_EMERGENCIA_US, 0, true);
+    sup_display = supervisor_registrar("Display_Task", PRAZO_DISPLAY_US, 0, false);
+    sup_matriz = supervisor_registrar("Matriz_LED_Task", PRAZO_MATRIZ_US, 0, true);
+    
+#if CALDEIRA_SMP
+    // Controle e emergência no núcleo 0; E/S lenta (I2C do display, PIO da matriz) no núcleo 1
+    vTaskCoreAffinitySet(xControleTaskHandle, NUCLEO_CONTROLE);
+    vTaskCoreAffinitySet(xJoystickTaskHandle, NUCLEO_CONTROLE);
+    vTaskCoreAffinitySet(xCaldeiraOKTaskHandle, NUCLEO_CONTROLE);
+    vTaskCoreAffinitySet(xCaldeiraNivelTaskHandle, NUCLEO_CONTROLE);
+    vTaskCoreAffinitySet(xCaldeiraTempTaskHandle, NUCLEO_CONTROLE);
+    vTaskCoreAffinitySet(xCaldeiraPressaoTaskHandle, NUCLEO_CONTROLE);
+    vTaskCoreAffinitySet(xDisplayTaskHandle, NUCLEO_IO);
+    vTaskCoreAffinitySet(xMatrizTaskHandle, NUCLEO_IO);
+    printf("Modo SMP: controle no nucleo 0, display/matriz no nucleo 1\n");
+#endif
+    
+    // Relatório periódico de perfil (somente com CALDEIRA_PROFILING)
+    PERFIL_INICIAR();
+    
+    // Drenagem do trace binário (somente com CALDEIRA_TRACE)
+    TRACE_INICIAR();
     
     printf("Todas as tarefas criadas com sucesso!\n");
+    imprimir_memoria();
     printf("\n=== CONTROLES ===\n");
-    printf("Joystick Direita: Estado OK (Verde)\n");
-    printf("Joystick Esquerda: Nível Baixo (Amarelo)\n");
-    printf("Joystick Baixo: Temperatura Alta (Laranja)\n");
-    printf("Joystick Cima: Pressão Alta (Vermelho)\n");
+    printf("Joystick Direita: remove perturbacoes (volta ao OK / Verde)\n");
+    printf("Joystick Esquerda: vazamento -> Nivel Baixo (Amarelo)\n");
+    printf("Joystick Baixo: queimador travado -> Temperatura Alta (Laranja)\n");
+    printf("Joystick Cima: saida bloqueada -> Pressao Alta (Vermelho)\n");
     printf("==================\n\n");
     
     // Definição do estado inicial de operação segura
-    estado_caldeira_t estado_inicial = CALDEIRA_OK;
-    xQueueSend(xEstadoQueue, &estado_inicial, 0);   // Comando inicial para fila
+    despachar_estado(CALDEIRA_OK, time_us_32());    // Notificação fica pendente até o escalonador iniciar
+    
+    // Display assina o canal de telemetria
+    assinar_telemetria(xDisplayTaskHandle);
+    
+    // Início da medição de despertares (e alarme do tickless, se habilitado)
+    consumo_iniciar();
     
     // Transferência de controle para escalonador FreeRTOS
     // A partir deste ponto, o sistema opera através das tarefas concorrentes
@@ -0,0 +1,42 @@
+// Simulador do sistema de caldeira no host
+// Executa o caldeira_main.c sem alterações sobre a porta POSIX do FreeRTOS,
+// com o joystick conduzido por um roteiro, e imprime latência, coalescência
+// de comandos e prazos perdidos ao final
+//
+//   caldeira_host cenarios/normal.txt [--estrito]
+//
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include <stdio.h>
+#include <string.h>
+#include "caldeira_host.h"
+
+// main() do firmware, renomeada na compilação do host (-Dmain=caldeira_main)
+extern int caldeira_main(void);
+
+int main(int argc, char **argv) {
+    const char *caminho = NULL;
+    bool estrito = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--estrito") == 0) {
+            estrito = true;
+        } else if (caminho == NULL) {
+            caminho = argv[i];
+        } else {
+            caminho = NULL;
+            break;
+        }
+    }
+
+    if (caminho == NULL) {
+        fprintf(stderr, "uso: %s roteiro.txt [--estrito]\n", argv[0]);
+        return 2;
+    }
+    if (!roteiro_carregar(caminho)) {
+        return 2;
+    }
+    roteiro_definir_estrito(estrito);
+
+    return caldeira_main();
+}
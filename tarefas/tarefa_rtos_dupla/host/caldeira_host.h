@@ -0,0 +1,25 @@
+// Simulador do sistema de caldeira no host (porta POSIX do FreeRTOS)
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef CALDEIRA_HOST_H
+#define CALDEIRA_HOST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Máximo de linhas de um roteiro de entrada
+#define ROTEIRO_MAX_PASSOS      1024
+
+// Tempo após o último passo até encerrar (cobre os 5 s da emergência)
+#define ROTEIRO_CAUDA_MS        6000
+
+// Carrega o roteiro "tempo_ms direcao" (C, R, L, D, U ou FIM); false em erro
+// "tempo_ms X duracao_ms" injeta uma sobrecarga: o laço de controle, que
+// amostra o joystick, fica ocupado por duracao_ms (teste do supervisor)
+bool roteiro_carregar(const char *caminho);
+
+// Ao fim do roteiro: imprime as métricas e encerra o processo
+// Com 'estrito', o código de saída é 1 se algum prazo de atuação foi perdido
+void roteiro_definir_estrito(bool estrito);
+
+#endif // CALDEIRA_HOST_H
@@ -0,0 +1,222 @@
+// Acesso ao hardware do sistema de caldeira no host
+// O joystick reproduz um roteiro de entrada com marcação de tempo; a matriz
+// LED modela a linha do DMA (transmissão + reset sem CPU, um quadro pendente
+// substituível); o display usa o driver
+// SSD1306 real com o I2C de stubs/hardware/i2c.h; o watchdog é uma thread
+// fora do FreeRTOS que encerra o processo, como o reset da placa
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include "pico/stdlib.h"
+#include "caldeira_hw.h"
+#include "caldeira_host.h"
+
+// Métricas impressas pelo firmware (caldeira_main.c)
+extern uint32_t imprimir_metricas(void);
+
+// Passo do roteiro: a partir de 'tempo_ms' o joystick fica na direção indicada
+// Direção 'X': sobrecarga, a próxima amostragem ocupa a CPU por 'duracao_ms'
+typedef struct {
+    uint32_t tempo_ms;
+    char direcao;
+    uint32_t duracao_ms;
+} passo_t;
+
+static passo_t roteiro[ROTEIRO_MAX_PASSOS];
+static int total_passos;
+static int passo_atual;
+static char direcao_atual = 'C';
+static uint32_t fim_ms;
+static bool modo_estrito;
+
+static uint64_t inicio_us;
+
+// Matriz LED: dois quadros como no driver DMA e a linha modelada no tempo
+static uint32_t *matriz_quadros[2];
+static unsigned int matriz_pixels;
+static unsigned int matriz_escrita;
+static uint64_t matriz_inicio_us;     // Início do quadro mais recente na linha
+static uint64_t matriz_livre_us;      // Fim da transmissão + reset desse quadro
+static uint32_t matriz_transmitidos;
+static uint32_t matriz_substituidos;
+uint64_t host_i2c_bytes;
+
+// Watchdog simulado: instante da última alimentação, lido pela thread do watchdog
+static uint32_t watchdog_timeout_ms;
+static uint64_t watchdog_alimentado_us;
+
+bool roteiro_carregar(const char *caminho) {
+    FILE *f = fopen(caminho, "r");
+    char linha[128];
+    bool fim_explicito = false;
+
+    if (f == NULL) {
+        perror(caminho);
+        return false;
+    }
+
+    while (fgets(linha, sizeof(linha), f) != NULL) {
+        unsigned long tempo, duracao = 0;
+        char comando[8];
+
+        if (linha[0] == '#' || sscanf(linha, "%lu %7s %lu", &tempo, comando, &duracao) < 2) {
+            continue;
+        }
+        if (strcmp(comando, "FIM") == 0) {
+            fim_ms = (uint32_t)tempo;
+            fim_explicito = true;
+            continue;
+        }
+        if (strchr("CRLDUX", comando[0]) == NULL || comando[1] != '\0') {
+            fprintf(stderr, "%s: direcao invalida '%s'\n", caminho, comando);
+            fclose(f);
+            return false;
+        }
+        if (total_passos == ROTEIRO_MAX_PASSOS) {
+            fprintf(stderr, "%s: mais de %d passos\n", caminho, ROTEIRO_MAX_PASSOS);
+            fclose(f);
+            return false;
+        }
+        roteiro[total_passos].tempo_ms = (uint32_t)tempo;
+        roteiro[total_passos].direcao = comando[0];
+        roteiro[total_passos].duracao_ms = (uint32_t)duracao;
+        total_passos++;
+    }
+    fclose(f);
+
+    if (!fim_explicito) {
+        fim_ms = (total_passos ? roteiro[total_passos - 1].tempo_ms : 0) + ROTEIRO_CAUDA_MS;
+    }
+    return true;
+}
+
+void roteiro_definir_estrito(bool estrito) {
+    modo_estrito = estrito;
+}
+
+static void roteiro_encerrar(void) {
+    uint32_t prazos_perdidos = imprimir_metricas();
+
+    printf("Host: %lu quadros na matriz, %llu bytes I2C para o display\n",
+           (unsigned long)matriz_transmitidos, (unsigned long long)host_i2c_bytes);
+    fflush(stdout);
+    exit(modo_estrito && prazos_perdidos > 0 ? 1 : 0);
+}
+
+void hw_iniciar(void) {
+}
+
+// Tempo decorrido no roteiro
+static uint32_t roteiro_ms(void) {
+    return (uint32_t)((time_us_64() - inicio_us) / 1000u);
+}
+
+void hw_ler_joystick(uint16_t *x, uint16_t *y) {
+    // O relógio do roteiro começa na primeira amostragem do joystick
+    if (inicio_us == 0) {
+        inicio_us = time_us_64();
+    }
+    uint32_t agora_ms = roteiro_ms();
+
+    if (agora_ms >= fim_ms) {
+        roteiro_encerrar();
+    }
+    while (passo_atual < total_passos && roteiro[passo_atual].tempo_ms <= agora_ms) {
+        passo_t *p = &roteiro[passo_atual++];
+        if (p->direcao == 'X') {
+            // Sobrecarga na tarefa que amostra o joystick (o laço de controle)
+            printf("Host: sobrecarga de %lu ms injetada aos %lu ms\n",
+                   (unsigned long)p->duracao_ms, (unsigned long)agora_ms);
+            sleep_ms(p->duracao_ms);
+        } else {
+            direcao_atual = p->direcao;
+        }
+    }
+
+    *x = 2048;
+    *y = 2048;
+    switch (direcao_atual) {
+        case 'R': *x = 4095; break;
+        case 'L': *x = 0;    break;
+        case 'U': *y = 4095; break;
+        case 'D': *y = 0;    break;
+        default:             break;
+    }
+}
+
+void hw_matriz_iniciar(unsigned int pin, uint32_t *quadros, unsigned int quantidade) {
+    (void)pin;
+    matriz_quadros[0] = quadros;
+    matriz_quadros[1] = quadros + quantidade;
+    matriz_pixels = quantidade;
+}
+
+uint32_t *hw_matriz_quadro(void) {
+    return matriz_quadros[matriz_escrita];
+}
+
+// Publicar não ocupa a CPU: o quadro sai quando a linha ficar livre (24 bits a
+// 800 kHz por pixel, FIFO de 9 palavras e reset de 300 us, como neopixel_dma.c);
+// um quadro ainda à espera da linha é substituído pelo novo
+void hw_matriz_publicar(void) {
+    uint64_t agora_us = time_us_64();
+    uint64_t duracao_us = (uint64_t)(matriz_pixels + 9u) * 30u + 300u;
+
+    if (matriz_inicio_us > agora_us) {
+        matriz_substituidos++;
+        return;
+    }
+    matriz_inicio_us = agora_us > matriz_livre_us ? agora_us : matriz_livre_us;
+    matriz_livre_us = matriz_inicio_us + duracao_us;
+    matriz_escrita ^= 1u;
+    matriz_transmitidos++;
+}
+
+void hw_matriz_estatisticas(uint32_t *transmitidos, uint32_t *substituidos) {
+    *transmitidos = matriz_transmitidos;
+    *substituidos = matriz_substituidos;
+}
+
+// Thread do watchdog: fora do escalonador, como o periférico da placa; sem
+// alimentação dentro do timeout o processo termina, no lugar do reset
+static void *watchdog_simulado(void *arg) {
+    sigset_t sinais;
+
+    (void)arg;
+    sigfillset(&sinais);
+    pthread_sigmask(SIG_BLOCK, &sinais, NULL);   // O tick da porta POSIX é das tarefas
+
+    while (true) {
+        usleep(10000);
+        uint64_t alimentado_us = __atomic_load_n(&watchdog_alimentado_us, __ATOMIC_RELAXED);
+        uint64_t sem_alimentar_us = time_us_64() - alimentado_us;
+        if (sem_alimentar_us > (uint64_t)watchdog_timeout_ms * 1000u) {
+            printf("Watchdog: reset aos %lu ms do roteiro, %lu ms sem alimentacao\n",
+                   (unsigned long)roteiro_ms(), (unsigned long)(sem_alimentar_us / 1000u));
+            fflush(stdout);
+            _exit(3);
+        }
+    }
+    return NULL;
+}
+
+void hw_watchdog_iniciar(uint32_t timeout_ms) {
+    pthread_t thread;
+
+    watchdog_timeout_ms = timeout_ms;
+    hw_watchdog_alimentar();
+    pthread_create(&thread, NULL, watchdog_simulado, NULL);
+}
+
+void hw_watchdog_alimentar(void) {
+    __atomic_store_n(&watchdog_alimentado_us, time_us_64(), __ATOMIC_RELAXED);
+}
+
+bool hw_watchdog_causou_reset(void) {
+    return false;
+}
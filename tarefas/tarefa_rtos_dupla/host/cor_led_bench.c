@@ -0,0 +1,113 @@
+// Benchmark do empacotamento de quadros da matriz LED no host
+// Compara o caminho antigo (brilho em float por canal + empacotamento) com a
+// tabela de gama + brilho, com e sem dithering temporal, para 25 e 256 pixels,
+// e mostra a resolução recuperada pelo dithering a 1% de brilho
+// No host o float é de hardware; no RP2040 cada multiplicação em float é
+// uma chamada de biblioteca, então a diferença lá é maior que a medida aqui
+//
+//   cor_led_bench [quadros]
+//
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cor_led.h"
+#include "caldeira_hw.h"
+
+#define MAX_PIXELS      256
+#define BRILHO_PERMIL   10      // Brilho da caldeira (1%)
+
+static pixel_t pixels[MAX_PIXELS];
+static uint32_t quadro[MAX_PIXELS];
+static uint8_t residuos[3 * MAX_PIXELS];
+static volatile uint32_t sumidouro;   // Impede o compilador de descartar os quadros
+
+static uint64_t agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Caminho anterior: apply_brightness() com 0.01f em cada canal
+static void empacotar_float(const pixel_t *p, uint32_t *q, unsigned int n, float brilho) {
+    for (unsigned int i = 0; i < n; i++) {
+        uint8_t r = (uint8_t)(p[i].R * brilho);
+        uint8_t g = (uint8_t)(p[i].G * brilho);
+        uint8_t b = (uint8_t)(p[i].B * brilho);
+        q[i] = HW_MATRIZ_GRB(r, g, b);
+    }
+}
+
+static void medir(const char *nome, unsigned int n, unsigned int quadros, int caminho) {
+    cor_led_t c;
+    uint64_t inicio;
+
+    cor_led_iniciar(&c, BRILHO_PERMIL, caminho == 2 ? residuos : NULL, n);
+    inicio = agora_ns();
+    for (unsigned int k = 0; k < quadros; k++) {
+        if (caminho == 0) {
+            empacotar_float(pixels, quadro, n, BRILHO_PERMIL / 1000.0f);
+        } else {
+            cor_led_empacotar(&c, pixels, quadro, n);
+        }
+        sumidouro += quadro[k % n];
+    }
+    uint64_t total_ns = agora_ns() - inicio;
+
+    printf("%-22s %5u %10llu %10llu\n", nome, n,
+           (unsigned long long)(total_ns / quadros),
+           (unsigned long long)(total_ns / quadros * 1000u / n));
+}
+
+// Nível médio de saída em 256 quadros para um valor de entrada
+static void resolucao(uint8_t valor) {
+    cor_led_t c;
+    uint8_t residuo[3] = {0};
+    pixel_t p = { .G = valor, .R = 0, .B = 0 };
+    uint32_t q, soma = 0;
+
+    cor_led_iniciar(&c, BRILHO_PERMIL, residuo, 1);
+    for (int k = 0; k < 256; k++) {
+        cor_led_empacotar(&c, &p, &q, 1);
+        soma += q >> 24;
+    }
+    printf("entrada %3u: float %u | tabela %u | dithering %u.%02u (alvo %u.%02u)\n", valor,
+           (unsigned)(uint8_t)(valor * (BRILHO_PERMIL / 1000.0f)),
+           (unsigned)((c.tabela[valor] + 128) >> 8),
+           (unsigned)(soma / 256), (unsigned)(soma % 256 * 100 / 256),
+           (unsigned)(c.tabela[valor] >> 8), (unsigned)((c.tabela[valor] & 0xFF) * 100 / 256));
+}
+
+int main(int argc, char **argv) {
+    unsigned int quadros = argc > 1 ? (unsigned int)strtoul(argv[1], NULL, 10) : 200000;
+    const unsigned int tamanhos[] = {25, MAX_PIXELS};
+
+    if (quadros == 0) {
+        fprintf(stderr, "uso: %s [quadros]\n", argv[0]);
+        return 2;
+    }
+
+    // Cores variadas, sem padrão que o compilador possa aproveitar
+    srand(1);
+    for (int i = 0; i < MAX_PIXELS; i++) {
+        pixels[i].R = (uint8_t)rand();
+        pixels[i].G = (uint8_t)rand();
+        pixels[i].B = (uint8_t)rand();
+    }
+
+    printf("%-22s %5s %10s %10s\n", "Caminho", "LEDs", "ns/quadro", "ps/LED");
+    for (int t = 0; t < 2; t++) {
+        medir("float (anterior)", tamanhos[t], quadros, 0);
+        medir("tabela", tamanhos[t], quadros, 1);
+        medir("tabela + dithering", tamanhos[t], quadros, 2);
+    }
+
+    printf("\nResolucao a %d.%d%% de brilho (nivel medio em 256 quadros)\n",
+           BRILHO_PERMIL / 10, BRILHO_PERMIL % 10);
+    resolucao(255);
+    resolucao(165);
+    resolucao(128);
+    resolucao(64);
+    return 0;
+}
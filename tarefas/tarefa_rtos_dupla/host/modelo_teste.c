@@ -0,0 +1,75 @@
+// Verificação do modelo físico e do controle da caldeira no host
+// Integra modelo + controle a 100 Hz sem RTOS e confere, para cada
+// perturbação do joystick, o alarme esperado e a volta à operação normal
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include <stdio.h>
+#include "modelo_caldeira.h"
+
+#define DT_S    0.01f
+
+typedef struct {
+    const char *nome;
+    uint32_t perturbacoes;
+    estado_caldeira_t esperado;
+    float prazo_alarme_s;       // Alarme deve surgir até este tempo
+    float duracao_s;            // Perturbação removida após este tempo
+    float prazo_retorno_s;      // OK deve voltar até este tempo após a remoção
+} cenario_t;
+
+static const cenario_t cenarios[] = {
+    { "nominal",         PERTURBACAO_NENHUMA,   CALDEIRA_OK,           0.0f, 120.0f, 0.0f },
+    { "vazamento",       PERTURBACAO_VAZAMENTO, CALDEIRA_NIVEL_BAIXO, 10.0f,  10.0f, 20.0f },
+    { "queimador",       PERTURBACAO_QUEIMADOR, CALDEIRA_TEMP_ALTA,    5.0f,  10.0f, 20.0f },
+    { "saida bloqueada", PERTURBACAO_QUEIMADOR | PERTURBACAO_SAIDA_BLOQUEADA,
+                                                CALDEIRA_PRESSAO_ALTA, 8.0f,  10.0f, 20.0f },
+};
+
+static int executar(const cenario_t *c) {
+    modelo_caldeira_t m;
+    controle_caldeira_t ctl;
+    float alarme_s = -1.0f;
+    float retorno_s = -1.0f;
+    estado_caldeira_t pior = CALDEIRA_OK;
+
+    modelo_iniciar(&m);
+    controle_iniciar(&ctl);
+
+    float fim_s = c->duracao_s + c->prazo_retorno_s;
+    for (int i = 0; i * DT_S < fim_s; i++) {
+        float t = i * DT_S;
+        uint32_t perturbacoes = t < c->duracao_s ? c->perturbacoes : PERTURBACAO_NENHUMA;
+        estado_caldeira_t estado = controle_passo(&ctl, &m);
+        modelo_passo(&m, &ctl.atuadores, perturbacoes, DT_S);
+
+        if (estado > pior) {
+            pior = estado;
+        }
+        if (estado == c->esperado && alarme_s < 0.0f) {
+            alarme_s = t;
+        }
+        if (t >= c->duracao_s && estado == CALDEIRA_OK && retorno_s < 0.0f) {
+            retorno_s = t - c->duracao_s;
+        }
+    }
+
+    int falhou = 0;
+    if (c->esperado == CALDEIRA_OK) {
+        falhou = pior != CALDEIRA_OK;
+    } else {
+        falhou = alarme_s < 0.0f || alarme_s > c->prazo_alarme_s || retorno_s < 0.0f || pior != c->esperado;
+    }
+
+    printf("%-16s alarme %6.2f s | retorno %6.2f s | T %6.1f C P %6.1f kPa N %5.1f %% | %s\n",
+           c->nome, alarme_s, retorno_s, m.temperatura, m.pressao, m.nivel_agua,
+           falhou ? "FALHOU" : "ok");
+    return falhou;
+}
+
+int main(void) {
+    int falhas = 0;
+    for (unsigned i = 0; i < sizeof(cenarios) / sizeof(cenarios[0]); i++) {
+        falhas += executar(&cenarios[i]);
+    }
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,32 @@
+// Substituto de hardware/i2c.h para a build nativa
+// As escritas não vão a lugar nenhum, mas ocupam a CPU pelo tempo que o
+// i2c_write_blocking levaria a 400 kHz (9 bits por byte), para que a tarefa
+// do display pese no escalonamento como na placa
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef HOST_STUB_HARDWARE_I2C_H
+#define HOST_STUB_HARDWARE_I2C_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+typedef struct i2c_inst i2c_inst_t;
+
+#define i2c1                    ((i2c_inst_t *)0)
+
+// Bytes enviados ao display desde o início (definido em caldeira_hw_host.c)
+extern uint64_t host_i2c_bytes;
+
+static inline int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)i2c;
+    (void)addr;
+    (void)src;
+    (void)nostop;
+    host_i2c_bytes += len;
+    sleep_us(((uint64_t)len * 9u * 1000000u) / 400000u);
+    return (int)len;
+}
+
+#endif // HOST_STUB_HARDWARE_I2C_H
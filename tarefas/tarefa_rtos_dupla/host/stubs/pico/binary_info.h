@@ -0,0 +1,7 @@
+// Substituto vazio de pico/binary_info.h para a build nativa
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef HOST_STUB_PICO_BINARY_INFO_H
+#define HOST_STUB_PICO_BINARY_INFO_H
+
+#endif // HOST_STUB_PICO_BINARY_INFO_H
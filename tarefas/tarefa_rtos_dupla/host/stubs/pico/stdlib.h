@@ -0,0 +1,44 @@
+// Substituto mínimo de pico/stdlib.h para a build nativa (porta POSIX do FreeRTOS)
+// O timer de 1 MHz do RP2040 vira CLOCK_MONOTONIC; as esperas curtas são
+// ativas, como no hardware, para não bloquear a thread da tarefa no kernel
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef HOST_STUB_PICO_STDLIB_H
+#define HOST_STUB_PICO_STDLIB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include <assert.h>
+
+typedef unsigned int uint;
+
+#define _u(x)           x ## u
+#define count_of(a)     (sizeof(a) / sizeof((a)[0]))
+
+static inline uint64_t time_us_64(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+static inline void sleep_us(uint64_t us) {
+    uint64_t fim = time_us_64() + us;
+    while (time_us_64() < fim) {
+    }
+}
+
+static inline void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000u);
+}
+
+static inline bool stdio_init_all(void) {
+    return true;
+}
+
+#endif // HOST_STUB_PICO_STDLIB_H
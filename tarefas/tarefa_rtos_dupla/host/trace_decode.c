@@ -0,0 +1,225 @@
+// Decodificador do trace binário do sistema de caldeira
+// Lê a captura da USB (blocos trace_bloco_t misturados ao texto de printf),
+// descarta o que não confere com a soma FNV-1a e gera JSON no formato
+// Chrome trace, aberto em chrome://tracing ou https://ui.perfetto.dev
+//
+//   cat /dev/ttyACM0 > captura.bin        (Ctrl+C para encerrar)
+//   trace_decode captura.bin > caldeira.json
+//
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include "trace_formato.h"
+
+#define MAX_NUCLEOS     2
+#define MAX_TAREFAS     256
+
+// Nomes de tarefa recebidos nos blocos TRACE_BLOCO_NOMES
+static char nomes[MAX_TAREFAS][TRACE_NOME_MAX];
+
+// Linha do tempo de um núcleo
+typedef struct {
+    bool     iniciado;
+    uint32_t ultimo_us;     // Último instante de 32 bits (para detectar a volta)
+    uint64_t voltas;        // Voltas completas do contador de 32 bits
+    bool     tarefa_ativa;
+    uint32_t tarefa;        // Número da tarefa em execução
+    uint64_t inicio_us;     // Quando ela entrou
+    uint64_t eventos;
+    uint32_t perdidos;
+} nucleo_t;
+
+static nucleo_t nucleos[MAX_NUCLEOS];
+static bool primeiro_evento = true;
+static uint64_t blocos_validos, blocos_invalidos;
+
+static const char *nome_tarefa(uint32_t numero, char *aux, size_t tamanho) {
+    if (numero < MAX_TAREFAS && nomes[numero][0] != '\0') {
+        return nomes[numero];
+    }
+    snprintf(aux, tamanho, "tarefa %" PRIu32, numero);
+    return aux;
+}
+
+static const char *nome_evento(uint8_t evento) {
+    switch (evento) {
+        case TRACE_NOTIFICA:        return "notifica";
+        case TRACE_NOTIFICA_ISR:    return "notifica (ISR)";
+        case TRACE_FILA_ENVIO:      return "fila envio";
+        case TRACE_FILA_RECEBE:     return "fila recebe";
+        case TRACE_APP_JOYSTICK:    return "joystick";
+        case TRACE_APP_DESPACHO:    return "despacho";
+        case TRACE_APP_ATUACAO:     return "atuacao";
+        case TRACE_APP_TELEMETRIA:  return "telemetria";
+        default:                    return "evento";
+    }
+}
+
+static void separador(void) {
+    printf(primeiro_evento ? "\n" : ",\n");
+    primeiro_evento = false;
+}
+
+// Fecha a fatia da tarefa em execução no núcleo (evento "X" de duração)
+static void fechar_fatia(uint8_t n, uint64_t fim_us) {
+    nucleo_t *c = &nucleos[n];
+    char aux[32];
+
+    if (!c->tarefa_ativa) {
+        return;
+    }
+    separador();
+    printf("{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%" PRIu64 ",\"dur\":%" PRIu64 "}",
+           nome_tarefa(c->tarefa, aux, sizeof(aux)), n, c->inicio_us, fim_us - c->inicio_us);
+}
+
+static void processar_evento(uint8_t n, const trace_registro_t *r) {
+    nucleo_t *c = &nucleos[n];
+    char aux[32];
+
+    // Estende o contador de 32 bits do RP2040 (volta a cada ~71 min)
+    if (c->iniciado && r->instante_us < c->ultimo_us) {
+        c->voltas++;
+    }
+    c->iniciado = true;
+    c->ultimo_us = r->instante_us;
+    c->eventos++;
+    uint64_t t = (c->voltas << 32) | r->instante_us;
+
+    if (r->evento == TRACE_TAREFA_ENTRA) {
+        fechar_fatia(n, t);
+        c->tarefa_ativa = true;
+        c->tarefa = r->arg;
+        c->inicio_us = t;
+        return;
+    }
+
+    separador();
+    if (r->evento == TRACE_NOTIFICA || r->evento == TRACE_NOTIFICA_ISR) {
+        printf("{\"name\":\"%s %s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%" PRIu64 "}",
+               nome_evento(r->evento), nome_tarefa(r->arg, aux, sizeof(aux)), n, t);
+    } else {
+        printf("{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%" PRIu64
+               ",\"args\":{\"arg\":%" PRIu32 "}}",
+               nome_evento(r->evento), n, t, r->arg);
+    }
+}
+
+// Bloco de eventos com 'reservado' diferente de 0 não é do formato
+static bool reservados_zerados(const uint8_t *p, uint16_t quantidade) {
+    for (uint16_t k = 0; k < quantidade; k++) {
+        trace_registro_t r;
+        memcpy(&r, p + k * sizeof(r), sizeof(r));
+        if (r.reservado[0] | r.reservado[1] | r.reservado[2]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Percorre a captura procurando blocos válidos
+// Passe 0 só coleta nomes (podem chegar depois dos primeiros eventos);
+// passe 1 emite os eventos
+static void percorrer(const uint8_t *dados, size_t tamanho, int passe) {
+    size_t i = 0;
+
+    while (i + sizeof(trace_bloco_t) <= tamanho) {
+        trace_bloco_t bloco;
+        memcpy(&bloco, dados + i, sizeof(bloco));
+
+        if (bloco.magico != TRACE_MAGICO) {
+            i++;
+            continue;
+        }
+
+        size_t registro = (bloco.tipo == TRACE_BLOCO_EVENTOS) ? sizeof(trace_registro_t)
+                        : (bloco.tipo == TRACE_BLOCO_NOMES)   ? sizeof(trace_nome_t) : 0;
+        size_t conteudo = registro * bloco.quantidade;
+        const uint8_t *p = dados + i + sizeof(bloco);
+
+        if (registro == 0 || bloco.quantidade > TRACE_MAX_POR_BLOCO || bloco.nucleo >= MAX_NUCLEOS ||
+            i + sizeof(bloco) + conteudo > tamanho || trace_soma(p, conteudo) != bloco.soma ||
+            (bloco.tipo == TRACE_BLOCO_EVENTOS && !reservados_zerados(p, bloco.quantidade))) {
+            if (passe == 1) {
+                blocos_invalidos++;
+            }
+            i++;
+            continue;
+        }
+
+        for (uint16_t k = 0; k < bloco.quantidade; k++) {
+            if (bloco.tipo == TRACE_BLOCO_NOMES && passe == 0) {
+                trace_nome_t nome;
+                memcpy(&nome, p + k * registro, sizeof(nome));
+                if (nome.numero < MAX_TAREFAS) {
+                    memcpy(nomes[nome.numero], nome.nome, TRACE_NOME_MAX);
+                    nomes[nome.numero][TRACE_NOME_MAX - 1] = '\0';
+                }
+            } else if (bloco.tipo == TRACE_BLOCO_EVENTOS && passe == 1) {
+                trace_registro_t r;
+                memcpy(&r, p + k * registro, sizeof(r));
+                processar_evento(bloco.nucleo, &r);
+            }
+        }
+
+        if (passe == 1) {
+            blocos_validos++;
+            if (bloco.tipo == TRACE_BLOCO_EVENTOS) {
+                nucleos[bloco.nucleo].perdidos = bloco.perdidos;
+            }
+        }
+        i += sizeof(bloco) + conteudo;
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "uso: %s captura.bin > trace.json\n", argv[0]);
+        return 1;
+    }
+
+    FILE *f = fopen(argv[1], "rb");
+    if (f == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    long tamanho = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    uint8_t *dados = malloc(tamanho > 0 ? (size_t)tamanho : 1);
+    if (dados == NULL || fread(dados, 1, (size_t)tamanho, f) != (size_t)tamanho) {
+        fprintf(stderr, "erro lendo %s\n", argv[1]);
+        fclose(f);
+        return 1;
+    }
+    fclose(f);
+
+    printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (unsigned n = 0; n < MAX_NUCLEOS; n++) {
+        separador();
+        printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Nucleo %u\"}}", n, n);
+    }
+
+    percorrer(dados, (size_t)tamanho, 0);
+    percorrer(dados, (size_t)tamanho, 1);
+
+    for (uint8_t n = 0; n < MAX_NUCLEOS; n++) {
+        fechar_fatia(n, ((uint64_t)nucleos[n].voltas << 32) | nucleos[n].ultimo_us);
+    }
+    printf("\n]}\n");
+
+    fprintf(stderr, "Blocos validos: %" PRIu64 " | descartados: %" PRIu64 "\n", blocos_validos, blocos_invalidos);
+    for (unsigned n = 0; n < MAX_NUCLEOS; n++) {
+        fprintf(stderr, "Nucleo %u: %" PRIu64 " eventos, %" PRIu32 " perdidos no anel\n",
+                n, nucleos[n].eventos, nucleos[n].perdidos);
+    }
+
+    free(dados);
+    return 0;
+}
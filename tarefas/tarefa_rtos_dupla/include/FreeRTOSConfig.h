@@ -42,9 +42,23 @@
 
 /* Scheduler Related */
 #define configUSE_PREEMPTION                    1
+/* Com -DCALDEIRA_TICKLESS=ON a idle suprime os ticks e dorme até o próximo
+ * desbloqueio (vPortSuppressTicksAndSleep em consumo_rtos.c, alarme do timer);
+ * só no build de um núcleo */
+#if CALDEIRA_TICKLESS && !CALDEIRA_SMP
+#define configUSE_TICKLESS_IDLE                 1
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
+#else
 #define configUSE_TICKLESS_IDLE                 0
+#endif
 #define configUSE_IDLE_HOOK                     0
-#define configUSE_TICK_HOOK                     0
+/* Perfil de consumo (consumo_rtos.c): tick hook e traceTASK_SWITCHED_OUT só
+ * com -DCALDEIRA_TICKLESS=ON ou -DCALDEIRA_PROFILING=ON (o simulador do host
+ * liga sempre); no build padrão tick e troca de contexto não pagam a contagem */
+#ifndef CALDEIRA_CONSUMO
+#define CALDEIRA_CONSUMO                        ( CALDEIRA_TICKLESS || CALDEIRA_PROFILING )
+#endif
+#define configUSE_TICK_HOOK                     CALDEIRA_CONSUMO     /* Conta ticks atendidos */
 #define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES                    32
 #define configMINIMAL_STACK_SIZE                ( configSTACK_DEPTH_TYPE ) 256
@@ -70,18 +84,46 @@
 #define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
 
 /* Memory allocation related definitions. */
-#define configSUPPORT_STATIC_ALLOCATION         0
+/* Tarefas e filas são estáticas (tamanhos em memoria_caldeira.h) e o kernel
+ * fornece a memória das tarefas idle e timer; o heap sobra só para uso
+ * eventual durante a inicialização */
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configKERNEL_PROVIDED_STATIC_MEMORY     1
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
-#define configTOTAL_HEAP_SIZE                   (128*1024)
+#define configTOTAL_HEAP_SIZE                   (1*1024)
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
+/* Com -DCALDEIRA_HEAP_ESTRITO=ON qualquer pvPortMalloc depois de
+ * vTaskStartScheduler aborta em caldeira_heap_apos_inicio() (dentro de
+ * pvPortMalloc o escalonador está suspenso, então o estado só é NOT_STARTED
+ * no boot); não depende de NDEBUG, vale também no build Release */
+#if CALDEIRA_HEAP_ESTRITO
+#ifndef __ASSEMBLER__
+extern void caldeira_heap_apos_inicio( unsigned int uiSize );
+#endif
+#define traceMALLOC( pvAddress, uiSize ) \
+    do { if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED ) caldeira_heap_apos_inicio( ( unsigned int ) ( uiSize ) ); } while( 0 )
+#endif
+
 /* Hook function related definitions. */
-#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configCHECK_FOR_STACK_OVERFLOW          2
 #define configUSE_MALLOC_FAILED_HOOK            0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
+/* Com -DCALDEIRA_PROFILING=ON o contador de run-time é o timer de 1 MHz do
+ * RP2040 (já em execução desde o boot, nada a configurar) */
+#if CALDEIRA_PROFILING
+#define configGENERATE_RUN_TIME_STATS           1
+#define configRUN_TIME_COUNTER_TYPE             uint64_t
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#ifndef __ASSEMBLER__
+extern uint64_t time_us_64(void);
+#endif
+#define portGET_RUN_TIME_COUNTER_VALUE()        time_us_64()
+#else
 #define configGENERATE_RUN_TIME_STATS           0
+#endif
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
@@ -93,7 +135,7 @@
 #define configUSE_TIMERS                        1
 #define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
 #define configTIMER_QUEUE_LENGTH                10
-#define configTIMER_TASK_STACK_DEPTH            1024
+#define configTIMER_TASK_STACK_DEPTH            256     /* Só executa funções pendentes do port (event group) */
 
 /* Interrupt nesting behaviour configuration. */
 /*
@@ -102,13 +144,16 @@
 #define configMAX_API_CALL_INTERRUPT_PRIORITY   [dependent on processor and application]
 */
 
-// #if FREE_RTOS_KERNEL_SMP // set by the RP2040 SMP port of FreeRTOS
-// /* SMP port only */
-// #define configNUMBER_OF_CORES                   2
-// #define configTICK_CORE                         0
-// #define configRUN_MULTIPLE_PRIORITIES           1
-// #define configUSE_CORE_AFFINITY                 1
-// #endif
+/* SMP: habilitado com -DCALDEIRA_SMP=ON, que define CALDEIRA_SMP=1 */
+#if CALDEIRA_SMP
+#define configNUMBER_OF_CORES                   2
+#define configTICK_CORE                         0
+#define configRUN_MULTIPLE_PRIORITIES           1
+#define configUSE_CORE_AFFINITY                 1
+#define configUSE_PASSIVE_IDLE_HOOK             0
+#else
+#define configNUMBER_OF_CORES                   1
+#endif
 
 /* RP2040 specific */
 #define configSUPPORT_PICO_SYNC_INTEROP         1
@@ -138,5 +183,20 @@ to exclude the API function. */
 #define INCLUDE_xQueueGetMutexHolder            1
 
 /* A header file that defines trace macro can be included here. */
+/* Perfil de consumo: cada saída da idle é um despertar da CPU (consumo_rtos.c);
+ * as tarefas da aplicação têm prioridade >= 1, só a idle roda na prioridade 0 */
+#if CALDEIRA_CONSUMO
+#ifndef __ASSEMBLER__
+extern void consumo_troca_saida( int ocioso );
+#endif
+#define traceTASK_SWITCHED_OUT() \
+    consumo_troca_saida( pxCurrentTCB->uxPriority == tskIDLE_PRIORITY )
+#endif
+
+/* Com -DCALDEIRA_TRACE=ON as macros trace* gravam no anel de trace_rtos.c
+ * (usa uxTCBNumber/uxQueueNumber, que dependem de configUSE_TRACE_FACILITY) */
+#if CALDEIRA_TRACE && !defined(__ASSEMBLER__)
+#include "trace_rtos.h"
+#endif
 
 #endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
@@ -0,0 +1,61 @@
+// Acesso ao hardware do sistema de caldeira
+// caldeira_hw_pico.c implementa sobre ADC, I2C e PIO do RP2040;
+// host/caldeira_hw_host.c substitui por um roteiro de entrada e tempos de
+// barramento simulados, para rodar o mesmo conjunto de tarefas no Linux
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef CALDEIRA_HW_H
+#define CALDEIRA_HW_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Configuração dos pinos do joystick analógico
+#define VRX_PIN         26      // Eixo X do joystick conectado ao ADC0
+#define VRY_PIN         27      // Eixo Y do joystick conectado ao ADC1
+
+// Configuração do display OLED SSD1306 via I2C
+#define SDA_PIN         14      // Linha de dados I2C
+#define SCL_PIN         15      // Linha de clock I2C
+
+// Configuração da matriz de LEDs NeoPixel WS2812B
+#define LED_PIN         7       // Pino de controle PIO para matriz LED
+
+// Canais ADC para leitura do joystick
+#define ADC_CH_X        0       // Canal ADC para eixo X
+#define ADC_CH_Y        1       // Canal ADC para eixo Y
+
+// Inicializa ADC do joystick (amostragem contínua) e barramento I2C do display
+void hw_iniciar(void);
+
+// Lê os dois eixos do joystick (ADC de 12 bits, 0-4095); na placa é a média
+// das amostras mais recentes, sem bloquear
+void hw_ler_joystick(uint16_t *x, uint16_t *y);
+
+// Pixel da matriz no formato transmitido: G, R, B nos 24 bits mais altos
+#define HW_MATRIZ_GRB(r, g, b)  (((uint32_t)(g) << 24) | ((uint32_t)(r) << 16) | ((uint32_t)(b) << 8))
+
+// Prepara a matriz WS2812B no pino indicado; 'quadros' reserva dois quadros
+// de 'quantidade' pixels (um em escrita, outro em transmissão)
+void hw_matriz_iniciar(unsigned int pin, uint32_t *quadros, unsigned int quantidade);
+
+// Quadro de escrita, com um HW_MATRIZ_GRB por pixel
+uint32_t *hw_matriz_quadro(void);
+
+// Publica o quadro escrito; a transmissão e o reset correm sem a CPU e a
+// chamada nunca espera por eles
+void hw_matriz_publicar(void);
+
+// Quadros transmitidos e substituídos antes de começarem a sair
+void hw_matriz_estatisticas(uint32_t *transmitidos, uint32_t *substituidos);
+
+// Habilita o watchdog de hardware: sem alimentação por 'timeout_ms' a placa reinicia
+void hw_watchdog_iniciar(uint32_t timeout_ms);
+
+// Alimenta o watchdog (reinicia a contagem do timeout)
+void hw_watchdog_alimentar(void);
+
+// Indica se o último reinício foi causado pelo watchdog
+bool hw_watchdog_causou_reset(void);
+
+#endif // CALDEIRA_HW_H
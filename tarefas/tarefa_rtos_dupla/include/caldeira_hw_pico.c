@@ -0,0 +1,93 @@
+// Acesso ao hardware do sistema de caldeira no RP2040
+// ADC contínuo por DMA para o joystick (adc_amostrador.c), I2C1 para o
+// SSD1306, PIO + DMA para a matriz WS2812B (neopixel_dma.c) e watchdog
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include "caldeira_hw.h"
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/adc.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+#include "hardware/watchdog.h"
+#include "ssd1306.h"
+#include "neopixel_dma.h"
+#include "adc_amostrador.h"
+
+// Programa PIO para controle de matriz LED WS2812B
+#include "ws2818b.pio.h"
+
+// Recursos de hardware PIO para controle WS2812B
+// PIO permite comunicação de alta velocidade com protocolo proprietário
+static PIO np_pio;                    // Instância PIO (0 ou 1)
+static uint sm;                       // Máquina de estado PIO
+
+// Conversões por segundo somando os dois eixos: 16 kHz por eixo, a média de
+// 16 amostras cobre 1 ms
+#define ADC_TAXA_HZ             32000
+
+void hw_iniciar(void) {
+    // Configuração do subsistema ADC para leitura do joystick analógico
+    adc_init();                                     // Inicializa controlador ADC
+    adc_gpio_init(VRX_PIN);                        // Configura GPIO 26 como entrada ADC
+    adc_gpio_init(VRY_PIN);                        // Configura GPIO 27 como entrada ADC
+    adc_amostrador_iniciar((1u << ADC_CH_X) | (1u << ADC_CH_Y), ADC_TAXA_HZ);
+    
+    // Configuração do subsistema I2C para comunicação com display OLED
+    i2c_init(i2c1, ssd1306_i2c_clock * 1000);     // Inicializa I2C1 com clock configurado
+    gpio_set_function(SDA_PIN, GPIO_FUNC_I2C);     // Configura GPIO 14 como SDA
+    gpio_set_function(SCL_PIN, GPIO_FUNC_I2C);     // Configura GPIO 15 como SCL
+    gpio_pull_up(SDA_PIN);                         // Resistor pull-up interno SDA
+    gpio_pull_up(SCL_PIN);                         // Resistor pull-up interno SCL
+}
+
+void hw_ler_joystick(uint16_t *x, uint16_t *y) {
+    // Médias mais recentes do anel do DMA: sem seleção de canal nem espera
+    *x = adc_amostrador_ler(ADC_CH_X);
+    *y = adc_amostrador_ler(ADC_CH_Y);
+}
+
+void hw_matriz_iniciar(unsigned int pin, uint32_t *quadros, unsigned int quantidade) {
+    // Carrega programa PIO para protocolo WS2812B no bloco PIO0
+    uint offset = pio_add_program(pio0, &ws2818b_program);
+    np_pio = pio0;
+    
+    // Tenta alocar máquina de estado no PIO0, fallback para PIO1
+    sm = pio_claim_unused_sm(np_pio, false);
+    if (sm < 0) {
+        np_pio = pio1;
+        sm = pio_claim_unused_sm(np_pio, true);  // Força alocação em PIO1
+    }
+    
+    // Inicializa programa PIO com frequência de 800 kHz (padrão WS2812B)
+    ws2818b_program_init(np_pio, sm, offset, pin, 800000.f);
+    
+    // Quadros alimentados por DMA no FIFO TX da máquina de estado
+    neopixel_dma_iniciar(np_pio, sm, quadros, quantidade);
+}
+
+uint32_t *hw_matriz_quadro(void) {
+    return neopixel_dma_quadro();
+}
+
+void hw_matriz_publicar(void) {
+    neopixel_dma_publicar();
+}
+
+void hw_matriz_estatisticas(uint32_t *transmitidos, uint32_t *substituidos) {
+    neopixel_dma_estatisticas(transmitidos, substituidos);
+}
+
+void hw_watchdog_iniciar(uint32_t timeout_ms) {
+    // Contagem pausada enquanto o depurador segura a CPU
+    watchdog_enable(timeout_ms, true);
+}
+
+void hw_watchdog_alimentar(void) {
+    watchdog_update();
+}
+
+bool hw_watchdog_causou_reset(void) {
+    return watchdog_caused_reboot();
+}
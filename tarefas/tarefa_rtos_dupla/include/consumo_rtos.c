@@ -0,0 +1,185 @@
+// Perfil de consumo do sistema de caldeira e tickless idle para o RP2040
+// Os contadores são atualizados na troca de contexto (saída da idle) e no
+// tick hook; no modo tickless o SysTick é parado durante o sono e o alarme de
+// 64 bits do timer (1 MHz) acorda a CPU no próximo desbloqueio, sem o limite
+// de ~134 ms do SysTick de 24 bits a 125 MHz da implementação padrão do port
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include "consumo_rtos.h"
+
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pico/stdlib.h"
+
+#if configUSE_TICKLESS_IDLE
+#include "hardware/timer.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#include "hardware/regs/m0plus.h"
+#endif
+
+#define US_POR_TICK             (1000000u / configTICK_RATE_HZ)
+
+#if configNUMBER_OF_CORES > 1
+#define CONSUMO_NUCLEO()        get_core_num()
+#else
+#define CONSUMO_NUCLEO()        0
+#endif
+
+// Contadores de um núcleo; só o próprio núcleo escreve, dentro da troca de contexto
+typedef struct {
+    uint32_t ultima_troca_us;         // Instante da última troca de contexto
+    uint32_t despertares;             // Saídas da tarefa idle
+    uint64_t ocioso_us;               // Tempo total na tarefa idle
+} consumo_nucleo_t;
+
+static consumo_nucleo_t nucleos[configNUMBER_OF_CORES];
+static uint64_t inicio_us;
+static volatile uint32_t ticks_processados;   // Interrupções de tick atendidas
+
+#if configUSE_TICKLESS_IDLE
+static int alarme_tickless = -1;
+static uint32_t sonos;                // Entradas em WFI com o tick suprimido
+static uint64_t dormindo_us;          // Tempo total com o tick suprimido
+#endif
+
+#if CALDEIRA_CONSUMO
+
+void consumo_troca_saida(int ocioso) {
+    consumo_nucleo_t *n = &nucleos[CONSUMO_NUCLEO()];
+    uint32_t agora_us = time_us_32();
+
+    if (ocioso) {
+        n->ocioso_us += agora_us - n->ultima_troca_us;
+        n->despertares++;
+    }
+    n->ultima_troca_us = agora_us;
+}
+
+// Conta só os ticks que interromperam a CPU; os suprimidos entram por
+// vTaskStepTick, que não chama o hook
+void vApplicationTickHook(void) {
+    ticks_processados++;
+}
+
+#endif // CALDEIRA_CONSUMO
+
+#if configUSE_TICKLESS_IDLE
+
+// O alarme só precisa tirar a CPU do WFI; o ajuste do tick é feito abaixo
+static void consumo_alarme(uint alarme) {
+    (void)alarme;
+}
+
+// Substitui a implementação fraca do port (SysTick de 24 bits)
+// Chamada pela idle com o escalonador suspenso
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime) {
+    const uint32_t contagens_por_us = clock_get_hz(clk_sys) / 1000000u;
+
+    __asm volatile ("cpsid i" ::: "memory");
+    __asm volatile ("dsb");
+    __asm volatile ("isb");
+
+    // Tarefa ficou pronta ou troca pendente desde a decisão da idle: não dorme
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        __asm volatile ("cpsie i" ::: "memory");
+        return;
+    }
+
+    // Para o tick e converte o que falta do tick corrente em us
+    systick_hw->csr &= ~M0PLUS_SYST_CSR_ENABLE_BITS;
+    uint32_t restante_us = systick_hw->cvr / contagens_por_us;
+    uint64_t inicio = time_us_64();
+
+    // Alarme no instante do último tick esperado; se já passou, não dorme
+    uint64_t alvo = inicio + restante_us + (uint64_t)(xExpectedIdleTime - 1) * US_POR_TICK;
+    if (!hardware_alarm_set_target(alarme_tickless, from_us_since_boot(alvo))) {
+        __asm volatile ("dsb" ::: "memory");
+        __asm volatile ("wfi");
+        __asm volatile ("isb");
+    }
+
+    // Deixa a interrupção que acordou a CPU executar e volta a mascarar
+    __asm volatile ("cpsie i" ::: "memory");
+    __asm volatile ("dsb");
+    __asm volatile ("isb");
+    __asm volatile ("cpsid i" ::: "memory");
+    hardware_alarm_cancel(alarme_tickless);
+
+    // Ticks completos durante o sono e fração restante do tick corrente
+    uint64_t dormido = time_us_64() - inicio;
+    TickType_t ticks = 0;
+    uint32_t proximo_us;
+    if (dormido >= restante_us) {
+        uint64_t apos_tick = dormido - restante_us;
+        ticks = (TickType_t)(1 + apos_tick / US_POR_TICK);
+        proximo_us = US_POR_TICK - (uint32_t)(apos_tick % US_POR_TICK);
+    } else {
+        proximo_us = restante_us - (uint32_t)dormido;
+    }
+    if (ticks > xExpectedIdleTime) {
+        ticks = xExpectedIdleTime;    // Latência do despertar além do desbloqueio
+    }
+    if (proximo_us == 0) {
+        proximo_us = 1;
+    }
+
+    // Reinicia o SysTick com o restante do tick corrente; o período normal
+    // volta a valer a partir da próxima recarga
+    systick_hw->rvr = proximo_us * contagens_por_us - 1;
+    systick_hw->cvr = 0;
+    systick_hw->csr |= M0PLUS_SYST_CSR_ENABLE_BITS;
+    systick_hw->rvr = US_POR_TICK * contagens_por_us - 1;
+
+    sonos++;
+    dormindo_us += dormido;
+    if (ticks > 0) {
+        vTaskStepTick(ticks);
+    }
+
+    __asm volatile ("cpsie i" ::: "memory");
+}
+
+#endif // configUSE_TICKLESS_IDLE
+
+void consumo_iniciar(void) {
+    inicio_us = time_us_64();
+    for (int i = 0; i < configNUMBER_OF_CORES; i++) {
+        nucleos[i].ultima_troca_us = (uint32_t)inicio_us;
+    }
+
+#if configUSE_TICKLESS_IDLE
+    alarme_tickless = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarme_tickless, consumo_alarme);
+#endif
+}
+
+void consumo_imprimir(void) {
+#if CALDEIRA_CONSUMO
+    uint64_t decorrido_us = time_us_64() - inicio_us;
+    uint64_t cpu_us = decorrido_us * configNUMBER_OF_CORES;   // Tempo de CPU disponível
+    if (decorrido_us == 0) {
+        return;
+    }
+
+    uint32_t despertares = 0;
+    uint64_t ocioso_us = 0;
+    for (int i = 0; i < configNUMBER_OF_CORES; i++) {
+        despertares += nucleos[i].despertares;
+        ocioso_us += nucleos[i].ocioso_us;
+    }
+
+    // Fração ociosa em décimos de porcento, sem ponto flutuante
+    uint32_t ocioso_permil = (uint32_t)(ocioso_us * 1000u / cpu_us);
+    printf("Consumo: %lu despertares/s saindo da idle, %lu ticks/s | ocioso %lu.%lu%%\n",
+           (unsigned long)((uint64_t)despertares * 1000000u / decorrido_us),
+           (unsigned long)((uint64_t)ticks_processados * 1000000u / decorrido_us),
+           (unsigned long)(ocioso_permil / 10), (unsigned long)(ocioso_permil % 10));
+#if configUSE_TICKLESS_IDLE
+    printf("Tickless: %lu sonos/s, tick suprimido %lu%% do tempo\n",
+           (unsigned long)((uint64_t)sonos * 1000000u / decorrido_us),
+           (unsigned long)(dormindo_us * 100u / decorrido_us));
+#endif
+#endif // CALDEIRA_CONSUMO
+}
@@ -0,0 +1,31 @@
+// Perfil de consumo do sistema de caldeira: despertares da CPU e tempo ocioso
+// Um despertar é cada saída da tarefa idle (o núcleo estava parado em WFI e
+// uma tarefa ficou pronta); com o tick fixo a CPU também acorda a cada tick,
+// com -DCALDEIRA_TICKLESS=ON os ticks ociosos são suprimidos pelo alarme do
+// timer do RP2040 (vPortSuppressTicksAndSleep em consumo_rtos.c)
+// A contagem funciona também na porta POSIX, para comparar cenários no host
+// Só é compilada com CALDEIRA_CONSUMO (tickless, profiling ou o simulador do
+// host; ver FreeRTOSConfig.h); sem ela consumo_imprimir não imprime nada
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef CONSUMO_RTOS_H
+#define CONSUMO_RTOS_H
+
+#include <stdint.h>
+
+#ifndef CALDEIRA_TICKLESS
+#define CALDEIRA_TICKLESS       0
+#endif
+
+// Chamada pelo traceTASK_SWITCHED_OUT do FreeRTOSConfig.h a cada troca de
+// contexto; 'ocioso' indica que a tarefa que sai é a idle
+void consumo_troca_saida(int ocioso);
+
+// Marca o início da medição e, no modo tickless, reserva o alarme do timer
+// (chamar antes de vTaskStartScheduler)
+void consumo_iniciar(void);
+
+// Imprime despertares/s, ticks/s e fração ociosa desde consumo_iniciar()
+void consumo_imprimir(void);
+
+#endif // CONSUMO_RTOS_H
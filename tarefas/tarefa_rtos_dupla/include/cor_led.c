@@ -0,0 +1,107 @@
+// Pipeline de cor da matriz LED (ver cor_led.h)
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include "cor_led.h"
+
+#include <string.h>
+#include "caldeira_hw.h"
+
+// Gama 2,2 em 16 bits: round(65535 * (i / 255)^2,2)
+static const uint16_t gama_2_2[256] = {
+        0,     0,     2,     4,     7,    11,    17,    24,
+       32,    42,    53,    65,    79,    94,   111,   129,
+      148,   169,   192,   216,   242,   270,   299,   330,
+      362,   396,   432,   469,   508,   549,   591,   635,
+      681,   729,   779,   830,   883,   938,   995,  1053,
+     1113,  1175,  1239,  1305,  1373,  1443,  1514,  1587,
+     1663,  1740,  1819,  1900,  1983,  2068,  2155,  2243,
+     2334,  2427,  2521,  2618,  2717,  2817,  2920,  3024,
+     3131,  3240,  3350,  3463,  3578,  3694,  3813,  3934,
+     4057,  4182,  4309,  4438,  4570,  4703,  4838,  4976,
+     5115,  5257,  5401,  5547,  5695,  5845,  5998,  6152,
+     6309,  6468,  6629,  6792,  6957,  7124,  7294,  7466,
+     7640,  7816,  7994,  8175,  8358,  8543,  8730,  8919,
+     9111,  9305,  9501,  9699,  9900, 10102, 10307, 10515,
+    10724, 10936, 11150, 11366, 11585, 11806, 12029, 12254,
+    12482, 12712, 12944, 13179, 13416, 13655, 13896, 14140,
+    14386, 14635, 14885, 15138, 15394, 15652, 15912, 16174,
+    16439, 16706, 16975, 17247, 17521, 17798, 18077, 18358,
+    18642, 18928, 19216, 19507, 19800, 20095, 20393, 20694,
+    20996, 21301, 21609, 21919, 22231, 22546, 22863, 23182,
+    23504, 23829, 24156, 24485, 24817, 25151, 25487, 25826,
+    26168, 26512, 26858, 27207, 27558, 27912, 28268, 28627,
+    28988, 29351, 29717, 30086, 30457, 30830, 31206, 31585,
+    31966, 32349, 32735, 33124, 33514, 33908, 34304, 34702,
+    35103, 35507, 35913, 36321, 36732, 37146, 37562, 37981,
+    38402, 38825, 39252, 39680, 40112, 40546, 40982, 41421,
+    41862, 42306, 42753, 43202, 43654, 44108, 44565, 45025,
+    45487, 45951, 46418, 46888, 47360, 47835, 48313, 48793,
+    49275, 49761, 50249, 50739, 51232, 51728, 52226, 52727,
+    53230, 53736, 54245, 54756, 55270, 55787, 56306, 56828,
+    57352, 57879, 58409, 58941, 59476, 60014, 60554, 61097,
+    61642, 62190, 62741, 63295, 63851, 64410, 64971, 65535,
+};
+
+void cor_led_iniciar(cor_led_t *c, uint16_t brilho_permil, uint8_t *residuos, unsigned int pixels) {
+    c->residuos = residuos;
+    if (residuos != NULL) {
+        memset(residuos, 0, 3u * pixels);
+    }
+    c->brilho_permil = COR_LED_BRILHO_MAX + 1;   // Força o cálculo da tabela
+    cor_led_definir_brilho(c, brilho_permil);
+}
+
+void cor_led_definir_brilho(cor_led_t *c, uint16_t brilho_permil) {
+    if (brilho_permil > COR_LED_BRILHO_MAX) {
+        brilho_permil = COR_LED_BRILHO_MAX;
+    }
+    if (brilho_permil == c->brilho_permil) {
+        return;
+    }
+
+    // 65535 no gama corresponde a 255,996 níveis em 8.8
+    for (int i = 0; i < 256; i++) {
+        c->tabela[i] = (uint16_t)((uint32_t)gama_2_2[i] * brilho_permil / COR_LED_BRILHO_MAX);
+    }
+    c->brilho_permil = brilho_permil;
+}
+
+// Nível de saída de um canal; com resíduo, a fração soma ao acumulado do
+// pixel e o que passar de um nível inteiro sai neste quadro
+static inline uint32_t canal(const cor_led_t *c, uint8_t valor, uint8_t *residuo, uint32_t *fracao) {
+    uint32_t nivel = c->tabela[valor];
+
+    if (residuo != NULL) {
+        nivel += *residuo;
+        *residuo = (uint8_t)nivel;
+    } else {
+        nivel += 128;                          // Arredondamento
+    }
+    *fracao |= c->tabela[valor] & 0xFFu;
+    nivel >>= 8;
+    return nivel > 255 ? 255 : nivel;
+}
+
+bool cor_led_empacotar(cor_led_t *c, const pixel_t *pixels, uint32_t *quadro,
+                       unsigned int quantidade) {
+    uint32_t fracao = 0;
+    uint8_t *r = c->residuos;
+
+    for (unsigned int i = 0; i < quantidade; i++) {
+        const pixel_t *p = &pixels[i];
+        uint32_t vr, vg, vb;
+
+        if (r != NULL) {
+            vr = canal(c, p->R, &r[0], &fracao);
+            vg = canal(c, p->G, &r[1], &fracao);
+            vb = canal(c, p->B, &r[2], &fracao);
+            r += 3;
+        } else {
+            vr = canal(c, p->R, NULL, &fracao);
+            vg = canal(c, p->G, NULL, &fracao);
+            vb = canal(c, p->B, NULL, &fracao);
+        }
+        quadro[i] = HW_MATRIZ_GRB(vr, vg, vb);
+    }
+    return fracao != 0;
+}
@@ -0,0 +1,47 @@
+// Pipeline de cor da matriz LED: gama + brilho por tabela e dithering temporal
+// Sem ponto flutuante por pixel (o RP2040 não tem FPU): cada canal passa por
+// uma tabela de 256 posições com gama 2,2 e brilho já aplicados, em ponto
+// fixo 8.8 (nível * 256); a tabela só é refeita quando o brilho muda
+// Com brilho baixo a maior parte das cores cai em 0-2 níveis; o dithering
+// temporal acumula por pixel a fração perdida e a devolve nos quadros
+// seguintes, recuperando a resolução na média (exige quadros periódicos)
+// Empacota as palavras GRB do quadro (HW_MATRIZ_GRB) numa única passada
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef COR_LED_H
+#define COR_LED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Brilho em milésimos da intensidade máxima
+#define COR_LED_BRILHO_MAX      1000
+
+// Estrutura de pixel para matriz LED WS2812B
+// Ordenação GRB conforme protocolo nativo do controlador; valores sem gama
+// nem brilho (a cor "pedida"), convertidos só no empacotamento
+typedef struct {
+    uint8_t G, R, B;           // Verde, Vermelho, Azul (8 bits cada)
+} pixel_t;
+
+// Estado do pipeline
+typedef struct {
+    uint16_t brilho_permil;    // Brilho da tabela atual
+    uint16_t tabela[256];      // Nível de saída em ponto fixo 8.8 por valor de entrada
+    uint8_t *residuos;         // Fração acumulada por pixel e canal (NULL: sem dithering)
+} cor_led_t;
+
+// Prepara o pipeline; 'residuos' tem 3 bytes por pixel para o dithering
+// temporal, ou NULL para arredondar cada quadro
+void cor_led_iniciar(cor_led_t *c, uint16_t brilho_permil, uint8_t *residuos, unsigned int pixels);
+
+// Troca o brilho; a tabela só é recalculada se o valor mudou
+void cor_led_definir_brilho(cor_led_t *c, uint16_t brilho_permil);
+
+// Converte 'quantidade' pixels em palavras HW_MATRIZ_GRB no 'quadro'
+// Retorna true se algum canal tem fração: com dithering, o próximo quadro
+// sai diferente e a matriz precisa continuar sendo atualizada
+bool cor_led_empacotar(cor_led_t *c, const pixel_t *pixels, uint32_t *quadro,
+                       unsigned int quantidade);
+
+#endif // COR_LED_H
@@ -0,0 +1,157 @@
+// Motor de efeitos da matriz LED 5x5 (ver efeitos_led.h)
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include "efeitos_led.h"
+
+// Comprimento da cauda da perseguição; cada LED da cauda tem metade do
+// brilho do anterior
+#define PERSEGUICAO_CAUDA       3
+
+// Tabelas de quadros-chave dos efeitos
+static const efeito_chave_t chaves_apagado[] = {
+    {    0,   0,   0,   0, EFEITO_CURVA_DEGRAU },
+};
+
+// Respiração: verde oscila entre ~40% e 100% em 3 s
+static const efeito_chave_t chaves_ok[] = {
+    {    0,   0, 100,   0, EFEITO_CURVA_SUAVE },
+    { 1500,   0, 255,   0, EFEITO_CURVA_SUAVE },
+};
+
+static const efeito_chave_t chaves_nivel[] = {
+    {    0, 255, 255,   0, EFEITO_CURVA_DEGRAU },
+};
+
+static const efeito_chave_t chaves_temperatura[] = {
+    {    0, 255, 165,   0, EFEITO_CURVA_DEGRAU },
+};
+
+// Emergência: vermelho pleno na seleção, alternando com vermelho fraco
+static const efeito_chave_t chaves_pressao[] = {
+    {    0, 255,   0,   0, EFEITO_CURVA_DEGRAU },
+    {  250,  32,   0,   0, EFEITO_CURVA_DEGRAU },
+};
+
+#define CHAVES(tabela)          (tabela), (uint8_t)(sizeof(tabela) / sizeof((tabela)[0]))
+
+static const efeito_t efeitos[EFEITOS_TOTAL] = {
+    [EFEITO_APAGADO]      = { CHAVES(chaves_apagado),     EFEITO_PADRAO_SOLIDO,      1000 },
+    [EFEITO_OK]           = { CHAVES(chaves_ok),          EFEITO_PADRAO_SOLIDO,      3000 },
+    [EFEITO_NIVEL_BAIXO]  = { CHAVES(chaves_nivel),       EFEITO_PADRAO_BARRA,       1000 },
+    [EFEITO_TEMP_ALTA]    = { CHAVES(chaves_temperatura), EFEITO_PADRAO_PERSEGUICAO,  800 },
+    [EFEITO_PRESSAO_ALTA] = { CHAVES(chaves_pressao),     EFEITO_PADRAO_SOLIDO,       500 },
+};
+
+// Borda da matriz em sentido horário a partir do canto superior esquerdo (x, y)
+#define BORDA_TOTAL             (4 * (EFEITOS_LADO - 1))
+static const uint8_t borda[BORDA_TOTAL][2] = {
+    {0, 0}, {1, 0}, {2, 0}, {3, 0}, {4, 0},
+    {4, 1}, {4, 2}, {4, 3}, {4, 4},
+    {3, 4}, {2, 4}, {1, 4}, {0, 4},
+    {0, 3}, {0, 2}, {0, 1},
+};
+
+// Converte coordenadas cartesianas (x,y) para índice linear da matriz
+// Implementa mapeamento serpentina para disposição física dos LEDs
+int get_led_index(int x, int y) {
+    if (y % 2 == 0) {
+        // Linhas pares: da esquerda para direita
+        return 24 - (y * 5 + x);
+    } else {
+        // Linhas ímpares: da direita para esquerda (padrão serpentina)
+        return 24 - (y * 5 + (4 - x));
+    }
+}
+
+// Canal interpolado entre a e b pela fração f (0 a EFEITOS_FRACAO_UM)
+static uint8_t interpolar(uint8_t a, uint8_t b, uint32_t f) {
+    return (uint8_t)((int32_t)a + ((int32_t)b - (int32_t)a) * (int32_t)f / EFEITOS_FRACAO_UM);
+}
+
+// Cor do efeito no instante t (já reduzido ao período)
+static void avaliar_chaves(const efeito_t *e, uint32_t t, uint8_t cor[3]) {
+    uint32_t i = 0;
+
+    while (i + 1 < e->total_chaves && e->chaves[i + 1].instante_ms <= t) {
+        i++;
+    }
+    const efeito_chave_t *a = &e->chaves[i];
+    const efeito_chave_t *b = &e->chaves[(i + 1) % e->total_chaves];
+    uint32_t fim_ms = (i + 1 < e->total_chaves) ? b->instante_ms : e->periodo_ms;
+    uint32_t f = 0;
+
+    if (a->curva != EFEITO_CURVA_DEGRAU && fim_ms > a->instante_ms) {
+        f = (t - a->instante_ms) * EFEITOS_FRACAO_UM / (fim_ms - a->instante_ms);
+        if (a->curva == EFEITO_CURVA_SUAVE) {
+            // f² (3 - 2f), com f em 1/256
+            f = f * f * (3 * EFEITOS_FRACAO_UM - 2 * f) / (EFEITOS_FRACAO_UM * EFEITOS_FRACAO_UM);
+        }
+    }
+    cor[0] = interpolar(a->r, b->r, f);
+    cor[1] = interpolar(a->g, b->g, f);
+    cor[2] = interpolar(a->b, b->b, f);
+}
+
+// Define um pixel com a cor escalada pela fração f
+static void pixel_escalado(pixel_t *p, const uint8_t cor[3], uint32_t f) {
+    p->R = (uint8_t)(cor[0] * f / EFEITOS_FRACAO_UM);
+    p->G = (uint8_t)(cor[1] * f / EFEITOS_FRACAO_UM);
+    p->B = (uint8_t)(cor[2] * f / EFEITOS_FRACAO_UM);
+}
+
+bool efeito_animado(efeito_id_t id) {
+    const efeito_t *e = &efeitos[id];
+    return e->total_chaves > 1 || e->padrao != EFEITO_PADRAO_SOLIDO;
+}
+
+void efeito_renderizar(efeito_id_t id, uint32_t tempo_ms, uint32_t nivel_pct, pixel_t *leds) {
+    const efeito_t *e = &efeitos[id];
+    uint32_t t = tempo_ms % e->periodo_ms;
+    uint8_t cor[3];
+
+    avaliar_chaves(e, t, cor);
+
+    switch (e->padrao) {
+        case EFEITO_PADRAO_PERSEGUICAO: {
+            // Uma volta na borda por período; o miolo fica apagado
+            uint32_t cabeca = t * BORDA_TOTAL / e->periodo_ms;
+            for (int i = 0; i < EFEITOS_PIXELS; i++) {
+                pixel_escalado(&leds[i], cor, 0);
+            }
+            for (uint32_t k = 0; k <= PERSEGUICAO_CAUDA; k++) {
+                const uint8_t *xy = borda[(cabeca + BORDA_TOTAL - k) % BORDA_TOTAL];
+                pixel_escalado(&leds[get_led_index(xy[0], xy[1])], cor, EFEITOS_FRACAO_UM >> k);
+            }
+            break;
+        }
+
+        case EFEITO_PADRAO_BARRA: {
+            // Altura em linhas (ponto fixo): a linha do topo da barra acende
+            // proporcional à fração que falta para completá-la
+            if (nivel_pct > 100) {
+                nivel_pct = 100;
+            }
+            uint32_t altura = nivel_pct * EFEITOS_LADO * EFEITOS_FRACAO_UM / 100;
+            for (int linha = 0; linha < EFEITOS_LADO; linha++) {
+                uint32_t base = (uint32_t)linha * EFEITOS_FRACAO_UM;   // linha 0 = de baixo
+                uint32_t f = 0;
+                if (altura >= base + EFEITOS_FRACAO_UM) {
+                    f = EFEITOS_FRACAO_UM;
+                } else if (altura > base) {
+                    f = altura - base;
+                }
+                for (int x = 0; x < EFEITOS_LADO; x++) {
+                    pixel_escalado(&leds[get_led_index(x, EFEITOS_LADO - 1 - linha)], cor, f);
+                }
+            }
+            break;
+        }
+
+        case EFEITO_PADRAO_SOLIDO:
+        default:
+            for (int i = 0; i < EFEITOS_PIXELS; i++) {
+                pixel_escalado(&leds[i], cor, EFEITOS_FRACAO_UM);
+            }
+            break;
+    }
+}
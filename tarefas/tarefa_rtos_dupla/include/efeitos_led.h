@@ -0,0 +1,76 @@
+// Motor de efeitos da matriz LED 5x5
+// Cada efeito é uma tabela pequena de quadros-chave (instante, cor e curva até
+// a chave seguinte) percorrida em laço, mais um padrão espacial que distribui
+// a cor pelos LEDs através do mapeamento serpentina de get_led_index()
+// A interpolação é em ponto fixo (fração de 0 a EFEITOS_FRACAO_UM), sem float
+// A avaliação é pura: dado o efeito, o tempo desde a seleção e o nível de água
+// da telemetria, escreve os 25 pixels; a taxa de quadros fica com quem chama
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef EFEITOS_LED_H
+#define EFEITOS_LED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cor_led.h"
+
+// Geometria da matriz
+#define EFEITOS_LADO            5
+#define EFEITOS_PIXELS          (EFEITOS_LADO * EFEITOS_LADO)
+
+// Fração inteira da interpolação (1,0 em ponto fixo)
+#define EFEITOS_FRACAO_UM       256
+
+// Efeitos disponíveis; as tarefas de estado só escolhem um identificador
+typedef enum {
+    EFEITO_APAGADO = 0,        // Matriz desligada
+    EFEITO_OK,                 // Verde respirando (pulso lento)
+    EFEITO_NIVEL_BAIXO,        // Barra amarela com o nível de água
+    EFEITO_TEMP_ALTA,          // Laranja percorrendo a borda
+    EFEITO_PRESSAO_ALTA,       // Vermelho piscando a 2 Hz
+    EFEITOS_TOTAL
+} efeito_id_t;
+
+// Curva de transição de uma chave até a seguinte
+typedef enum {
+    EFEITO_CURVA_LINEAR = 0,
+    EFEITO_CURVA_SUAVE,        // Smoothstep: começa e termina devagar
+    EFEITO_CURVA_DEGRAU        // Mantém a cor até a chave seguinte
+} efeito_curva_t;
+
+// Padrão espacial: como a cor do instante é distribuída pelos LEDs
+typedef enum {
+    EFEITO_PADRAO_SOLIDO = 0,  // Todos os LEDs com a cor
+    EFEITO_PADRAO_PERSEGUICAO, // Cabeça com cauda dando uma volta na borda por período
+    EFEITO_PADRAO_BARRA        // Linhas acesas de baixo para cima conforme o nível
+} efeito_padrao_t;
+
+// Quadro-chave: cor no instante (ms desde o início do período)
+typedef struct {
+    uint16_t instante_ms;
+    uint8_t r, g, b;
+    uint8_t curva;             // efeito_curva_t até a chave seguinte
+} efeito_chave_t;
+
+// Efeito: chaves em ordem crescente de instante, a primeira em 0; depois da
+// última a interpolação volta à primeira no fim do período
+typedef struct {
+    const efeito_chave_t *chaves;
+    uint8_t total_chaves;
+    uint8_t padrao;            // efeito_padrao_t
+    uint16_t periodo_ms;
+} efeito_t;
+
+// Converte coordenadas (x,y) em índice linear da matriz (mapeamento
+// serpentina da placa; y = 0 é a linha de cima)
+int get_led_index(int x, int y);
+
+// Indica se o efeito muda com o tempo ou com a telemetria (precisa de
+// quadros periódicos); um efeito estático basta ser desenhado uma vez
+bool efeito_animado(efeito_id_t id);
+
+// Escreve os EFEITOS_PIXELS pixels do efeito no instante 'tempo_ms' desde a
+// seleção; 'nivel_pct' (0 a 100) alimenta o padrão de barra
+void efeito_renderizar(efeito_id_t id, uint32_t tempo_ms, uint32_t nivel_pct, pixel_t *leds);
+
+#endif // EFEITOS_LED_H
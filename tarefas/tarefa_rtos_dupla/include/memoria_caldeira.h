@@ -0,0 +1,36 @@
+// Orçamento de memória estática do sistema de caldeira
+// Tarefas são criadas com xTaskCreateStatic e as tarefas do kernel (idle,
+// timer) usam a memória fornecida pelo próprio kernel
+// (configKERNEL_PROVIDED_STATIC_MEMORY); o heap do FreeRTOS fica quase vazio
+// Os tamanhos abaixo são a única fonte: criação das tarefas, verificação do
+// orçamento em tempo de compilação e relatório de memória no boot
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef MEMORIA_CALDEIRA_H
+#define MEMORIA_CALDEIRA_H
+
+// Pilhas das tarefas, em palavras de StackType_t (4 bytes no RP2040)
+// Ajuste: com -DCALDEIRA_PROFILING=ON a coluna "Pilha" do relatório mostra a
+// menor folga já observada; manter pelo menos 25 % da pilha livre
+// O estouro é detectado pelo kernel (configCHECK_FOR_STACK_OVERFLOW 2)
+#define PILHA_CONTROLE          256     // Modelo em float, sem printf
+#define PILHA_JOYSTICK          384     // printf de texto
+#define PILHA_ESTADO_OK         512     // printf + resumo de métricas
+#define PILHA_ESTADO            384     // Nível, temperatura e pressão: printf de inteiros
+#define PILHA_DISPLAY           384     // Formatação inteira + desenho no framebuffer
+#define PILHA_MATRIZ            256     // Efeito, empacotamento e cópia da telemetria, sem printf
+#define PILHA_PERFIL            384     // Tabelas do relatório são estáticas
+#define PILHA_TRACE             384     // Lote e tabela de nomes são estáticos
+#define PILHA_SUPERVISOR        384     // printf das falhas e do relatório
+
+// Tarefas criadas por caldeira_main.c e soma das suas pilhas
+#define MEMORIA_TAREFAS_APP     9
+#define MEMORIA_PILHAS_APP      (PILHA_CONTROLE + PILHA_JOYSTICK + PILHA_ESTADO_OK + \
+                                 3 * PILHA_ESTADO + PILHA_DISPLAY + PILHA_MATRIZ + \
+                                 PILHA_SUPERVISOR)
+
+// Teto de RAM para os objetos do RTOS: pilhas, TCBs, heap e anéis de
+// trace (o RP2040 tem 264 KB; o restante fica para SDK, USB e framebuffer)
+#define MEMORIA_ORCAMENTO_BYTES (96 * 1024)
+
+#endif // MEMORIA_CALDEIRA_H
@@ -0,0 +1,163 @@
+// Modelo físico da caldeira e lógica de controle dos atuadores
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include "modelo_caldeira.h"
+
+// -----------------------------------------------------------------------------
+// Parâmetros do processo (unidades normalizadas, dinâmica de poucos segundos
+// para que cada perturbação seja visível na bancada)
+// -----------------------------------------------------------------------------
+#define T_AMBIENTE              25.0f   // °C
+#define T_EBULICAO              100.0f  // °C: abaixo disso não há geração de vapor
+#define P_ATMOSFERICA           100.0f  // kPa
+
+#define CALOR_AQUECEDOR         35.0f   // Potência do aquecedor (°C/s com massa unitária)
+#define CALOR_QUEIMADOR         50.0f   // Calor extra do queimador travado
+#define COEF_PERDA              0.05f   // Perda térmica para o ambiente
+#define COEF_AGUA_FRIA          0.08f   // Resfriamento pela água de alimentação
+#define COEF_VAPOR              0.9f    // Geração de vapor por °C acima da ebulição (kPa/s)
+#define CALOR_VAPORIZACAO       0.8f    // Energia retirada por unidade de vapor gerado
+#define COEF_CONSUMO            0.12f   // Consumo de vapor pela saída aberta
+#define COEF_ALIVIO             0.3f    // Vazão da válvula de alívio
+#define VAZAO_BOMBA             4.0f    // %/s
+#define VAZAO_VAZAMENTO         10.0f   // %/s
+#define COEF_EVAPORACAO         0.02f   // Água convertida em vapor (%/s por kPa/s)
+
+// -----------------------------------------------------------------------------
+// Limiares do controle (liga / desliga)
+// -----------------------------------------------------------------------------
+#define PRESSAO_AQUECER         290.0f  // Aquecedor liga abaixo
+#define PRESSAO_DESAQUECER      310.0f  // Aquecedor desliga acima
+#define NIVEL_BOMBA_LIGA        45.0f
+#define NIVEL_BOMBA_DESLIGA     55.0f
+#define NIVEL_MAX_RESFRIAMENTO  80.0f   // Bomba para de resfriar acima deste nível
+
+#define ALARME_PRESSAO_ATIVA    450.0f
+#define ALARME_PRESSAO_LIMPA    350.0f
+#define ALARME_TEMP_ATIVA       145.0f
+#define ALARME_TEMP_LIMPA       135.0f
+#define ALARME_NIVEL_ATIVA      20.0f
+#define ALARME_NIVEL_LIMPA      30.0f
+
+// Histerese: ativa acima/abaixo de 'ativa', só desativa ao cruzar 'limpa'
+static bool histerese_acima(bool atual, float valor, float ativa, float limpa) {
+    if (valor > ativa) {
+        return true;
+    }
+    if (valor < limpa) {
+        return false;
+    }
+    return atual;
+}
+
+static bool histerese_abaixo(bool atual, float valor, float ativa, float limpa) {
+    if (valor < ativa) {
+        return true;
+    }
+    if (valor > limpa) {
+        return false;
+    }
+    return atual;
+}
+
+static float limitar(float valor, float minimo, float maximo) {
+    if (valor < minimo) {
+        return minimo;
+    }
+    if (valor > maximo) {
+        return maximo;
+    }
+    return valor;
+}
+
+void modelo_iniciar(modelo_caldeira_t *m) {
+    m->temperatura = 130.0f;
+    m->pressao = 300.0f;
+    m->nivel_agua = 54.0f;
+}
+
+void modelo_passo(modelo_caldeira_t *m, const atuadores_caldeira_t *a,
+                  uint32_t perturbacoes, float dt_s) {
+    // Massa de água: reservatório cheio aquece e esfria mais devagar
+    float massa = 1.0f + m->nivel_agua / 50.0f;
+    float sobrepressao = m->pressao - P_ATMOSFERICA;
+    
+    // Vapor gerado proporcional à temperatura acima da ebulição
+    float vapor = m->temperatura > T_EBULICAO ? COEF_VAPOR * (m->temperatura - T_EBULICAO) : 0.0f;
+    
+    // Balanço térmico: aquecedor + queimador - perdas - água fria - vaporização
+    float calor = a->aquecedor ? CALOR_AQUECEDOR : 0.0f;
+    if (perturbacoes & PERTURBACAO_QUEIMADOR) {
+        calor += CALOR_QUEIMADOR;
+    }
+    calor -= COEF_PERDA * (m->temperatura - T_AMBIENTE);
+    if (a->bomba) {
+        calor -= COEF_AGUA_FRIA * (m->temperatura - T_AMBIENTE);
+    }
+    calor -= CALOR_VAPORIZACAO * vapor;
+    
+    // Balanço de vapor: geração - consumo pela saída - válvula de alívio
+    float d_pressao = vapor;
+    if (!(perturbacoes & PERTURBACAO_SAIDA_BLOQUEADA)) {
+        d_pressao -= COEF_CONSUMO * sobrepressao;
+    }
+    if (a->alivio) {
+        d_pressao -= COEF_ALIVIO * sobrepressao;
+    }
+    
+    // Balanço de água: bomba - evaporação - vazamento
+    float d_nivel = (a->bomba ? VAZAO_BOMBA : 0.0f) - COEF_EVAPORACAO * vapor;
+    if (perturbacoes & PERTURBACAO_VAZAMENTO) {
+        d_nivel -= VAZAO_VAZAMENTO;
+    }
+    
+    m->temperatura += (calor / massa) * dt_s;
+    m->pressao = limitar(m->pressao + d_pressao * dt_s, P_ATMOSFERICA, 1000.0f);
+    m->nivel_agua = limitar(m->nivel_agua + d_nivel * dt_s, 0.0f, 100.0f);
+}
+
+void controle_iniciar(controle_caldeira_t *c) {
+    c->atuadores.aquecedor = true;
+    c->atuadores.bomba = false;
+    c->atuadores.alivio = false;
+    c->alarme_nivel = false;
+    c->alarme_temperatura = false;
+    c->alarme_pressao = false;
+}
+
+estado_caldeira_t controle_passo(controle_caldeira_t *c, const modelo_caldeira_t *m) {
+    atuadores_caldeira_t *a = &c->atuadores;
+    
+    c->alarme_pressao = histerese_acima(c->alarme_pressao, m->pressao,
+                                        ALARME_PRESSAO_ATIVA, ALARME_PRESSAO_LIMPA);
+    c->alarme_temperatura = histerese_acima(c->alarme_temperatura, m->temperatura,
+                                            ALARME_TEMP_ATIVA, ALARME_TEMP_LIMPA);
+    c->alarme_nivel = histerese_abaixo(c->alarme_nivel, m->nivel_agua,
+                                       ALARME_NIVEL_ATIVA, ALARME_NIVEL_LIMPA);
+    
+    // Aquecedor regula a pressão; qualquer alarme o desliga
+    a->aquecedor = histerese_abaixo(a->aquecedor, m->pressao, PRESSAO_AQUECER, PRESSAO_DESAQUECER);
+    if (c->alarme_pressao || c->alarme_temperatura || c->alarme_nivel) {
+        a->aquecedor = false;
+    }
+    
+    // Bomba regula o nível e, no superaquecimento, injeta água fria
+    a->bomba = histerese_abaixo(a->bomba, m->nivel_agua, NIVEL_BOMBA_LIGA, NIVEL_BOMBA_DESLIGA);
+    if (c->alarme_temperatura && m->nivel_agua < NIVEL_MAX_RESFRIAMENTO) {
+        a->bomba = true;
+    }
+    
+    // Alívio aberto enquanto durar o alarme de pressão
+    a->alivio = c->alarme_pressao;
+    
+    if (c->alarme_pressao) {
+        return CALDEIRA_PRESSAO_ALTA;
+    }
+    if (c->alarme_temperatura) {
+        return CALDEIRA_TEMP_ALTA;
+    }
+    if (c->alarme_nivel) {
+        return CALDEIRA_NIVEL_BAIXO;
+    }
+    return CALDEIRA_OK;
+}
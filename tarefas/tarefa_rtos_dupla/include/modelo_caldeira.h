@@ -0,0 +1,65 @@
+// Modelo físico da caldeira e lógica de controle dos atuadores
+// Temperatura da água, pressão do vapor e nível do reservatório evoluem por
+// equações diferenciais integradas em passo fixo (Euler); o controle decide
+// aquecedor, bomba e válvula de alívio por limiares com histerese
+// Não depende do SDK do Pico nem do FreeRTOS (testável no host)
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef MODELO_CALDEIRA_H
+#define MODELO_CALDEIRA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Enumeração dos estados críticos da caldeira industrial
+// Organizados por prioridade crescente para escalonamento RTOS
+typedef enum {
+    CALDEIRA_OK = 0,           // Prioridade 1: operação normal (baixa)
+    CALDEIRA_NIVEL_BAIXO,      // Prioridade 2: água insuficiente (baixa)
+    CALDEIRA_TEMP_ALTA,        // Prioridade 3: superaquecimento (média)
+    CALDEIRA_PRESSAO_ALTA      // Prioridade 4: emergência crítica (máxima)
+} estado_caldeira_t;
+
+// Perturbações injetadas pelo joystick (podem ser combinadas)
+#define PERTURBACAO_NENHUMA         0u
+#define PERTURBACAO_VAZAMENTO       (1u << 0)   // Perda de água maior que a vazão da bomba
+#define PERTURBACAO_QUEIMADOR       (1u << 1)   // Queimador travado aceso (calor extra)
+#define PERTURBACAO_SAIDA_BLOQUEADA (1u << 2)   // Consumo de vapor interrompido
+
+// Variáveis de processo
+typedef struct {
+    float temperatura;         // Temperatura da água em °C
+    float pressao;             // Pressão absoluta do vapor em kPa
+    float nivel_agua;          // Nível do reservatório em %
+} modelo_caldeira_t;
+
+// Saídas do controle
+typedef struct {
+    bool aquecedor;            // Aquecedor principal
+    bool bomba;                // Bomba de água de alimentação (fria)
+    bool alivio;               // Válvula de alívio de pressão
+} atuadores_caldeira_t;
+
+// Estado do controle: atuadores e alarmes, ambos com histerese
+typedef struct {
+    atuadores_caldeira_t atuadores;
+    bool alarme_nivel;
+    bool alarme_temperatura;
+    bool alarme_pressao;
+} controle_caldeira_t;
+
+// Ponto de operação nominal: 130 °C, 300 kPa, 54 %
+void modelo_iniciar(modelo_caldeira_t *m);
+
+// Integra o modelo por 'dt_s' segundos com os atuadores e perturbações dados
+void modelo_passo(modelo_caldeira_t *m, const atuadores_caldeira_t *a,
+                  uint32_t perturbacoes, float dt_s);
+
+// Aquecedor ligado, demais atuadores desligados, sem alarmes
+void controle_iniciar(controle_caldeira_t *c);
+
+// Atualiza alarmes e atuadores a partir das medidas; retorna o estado mais
+// crítico ativo (pressão > temperatura > nível > OK)
+estado_caldeira_t controle_passo(controle_caldeira_t *c, const modelo_caldeira_t *m);
+
+#endif // MODELO_CALDEIRA_H
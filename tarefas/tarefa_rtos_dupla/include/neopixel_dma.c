@@ -0,0 +1,121 @@
+// Driver WS2812B por DMA para o RP2040
+// A linha passa por três fases: livre, DMA (palavras indo para o FIFO TX) e
+// reset (últimas palavras saindo do FIFO + nível baixo do latch). A IRQ do DMA
+// arma o alarme e o alarme libera a linha, iniciando o quadro pendente
+// Escritor, IRQ do DMA e alarme trocam o estado sob um spinlock do SDK, que
+// também mascara as interrupções (vale entre núcleos no build SMP)
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include "neopixel_dma.h"
+
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+
+// Fase da linha de dados
+typedef enum {
+    LINHA_LIVRE = 0,
+    LINHA_DMA,
+    LINHA_RESET
+} linha_t;
+
+static uint32_t *quadros_pixels[2];
+static int canal_dma = -1;
+static int alarme_reset = -1;
+static spin_lock_t *trava;
+static volatile linha_t linha = LINHA_LIVRE;
+static uint escrita;                  // Quadro do escritor; o outro é o da linha
+static bool pendente;                 // Quadro de escrita publicado, à espera da linha
+static uint32_t transmitidos;
+static uint32_t substituidos;
+
+// Inicia o DMA do quadro publicado e entrega o outro ao escritor (trava adquirida)
+static void iniciar_transmissao(void) {
+    linha = LINHA_DMA;
+    pendente = false;
+    dma_channel_set_read_addr(canal_dma, quadros_pixels[escrita], true);
+    escrita ^= 1u;
+    transmitidos++;
+}
+
+// Alarme do fim do reset: linha livre, quadro pendente sai em seguida
+static void fim_reset(uint alarme) {
+    (void)alarme;
+    uint32_t irq = spin_lock_blocking(trava);
+    linha = LINHA_LIVRE;
+    if (pendente) {
+        iniciar_transmissao();
+    }
+    spin_unlock(trava, irq);
+}
+
+// IRQ do DMA (compartilhada): última palavra entregue ao FIFO
+static void fim_dma(void) {
+    if (!dma_channel_get_irq0_status(canal_dma)) {
+        return;
+    }
+    dma_channel_acknowledge_irq0(canal_dma);
+
+    uint32_t irq = spin_lock_blocking(trava);
+    linha = LINHA_RESET;
+    spin_unlock(trava, irq);
+
+    // Esvaziamento do FIFO e OSR mais o nível baixo do latch
+    absolute_time_t alvo = make_timeout_time_us(NEOPIXEL_FIFO_PALAVRAS * NEOPIXEL_PIXEL_US +
+                                                NEOPIXEL_RESET_US);
+    if (hardware_alarm_set_target(alarme_reset, alvo)) {
+        fim_reset(alarme_reset);              // Alvo já passou
+    }
+}
+
+void neopixel_dma_iniciar(PIO pio, uint sm, uint32_t *quadros, uint quantidade) {
+    quadros_pixels[0] = quadros;
+    quadros_pixels[1] = quadros + quantidade;
+    trava = spin_lock_init(spin_lock_claim_unused(true));
+
+    // 32 bits por pixel, do quadro para o FIFO TX, no ritmo do DREQ da máquina
+    canal_dma = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(canal_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(canal_dma, &c, &pio->txf[sm], quadros_pixels[0], quantidade, false);
+
+    dma_channel_set_irq0_enabled(canal_dma, true);
+    irq_add_shared_handler(DMA_IRQ_0, fim_dma, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    alarme_reset = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarme_reset, fim_reset);
+}
+
+uint32_t *neopixel_dma_quadro(void) {
+    uint32_t irq = spin_lock_blocking(trava);
+    if (pendente) {
+        pendente = false;                     // Ainda não saiu: o escritor o refaz
+        substituidos++;
+    }
+    uint32_t *quadro = quadros_pixels[escrita];
+    spin_unlock(trava, irq);
+    return quadro;
+}
+
+void neopixel_dma_publicar(void) {
+    uint32_t irq = spin_lock_blocking(trava);
+    if (linha == LINHA_LIVRE) {
+        iniciar_transmissao();
+    } else {
+        pendente = true;
+    }
+    spin_unlock(trava, irq);
+}
+
+void neopixel_dma_estatisticas(uint32_t *quadros_transmitidos, uint32_t *quadros_substituidos) {
+    uint32_t irq = spin_lock_blocking(trava);
+    *quadros_transmitidos = transmitidos;
+    *quadros_substituidos = substituidos;
+    spin_unlock(trava, irq);
+}
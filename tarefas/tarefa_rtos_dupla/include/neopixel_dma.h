@@ -0,0 +1,40 @@
+// Driver WS2812B por DMA para o RP2040
+// Dois quadros de palavras GRB já no formato do PIO: um é transmitido pelo
+// DMA para o FIFO TX enquanto o outro é escrito; publicar um quadro troca os
+// dois sem bloquear. O fim da transferência chega por IRQ do DMA e o tempo de
+// reset (latch) é contado por um alarme do timer, sem sleep_ms na tarefa
+// O custo de CPU por quadro não depende do número de pixels: a escrita do
+// quadro fica com quem chama e o envio é todo do DMA
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef NEOPIXEL_DMA_H
+#define NEOPIXEL_DMA_H
+
+#include <stdint.h>
+#include "hardware/pio.h"
+
+// Tempo de um pixel (24 bits a 800 kHz) e reset mínimo com a linha em nível baixo
+#define NEOPIXEL_PIXEL_US       30
+#define NEOPIXEL_RESET_US       300
+
+// Palavras que ainda saem depois do fim do DMA: FIFO TX unido (8) + OSR
+#define NEOPIXEL_FIFO_PALAVRAS  9
+
+// Prepara DMA, IRQ e alarme para a máquina de estado já configurada
+// 'quadros' deve ter 2 * 'quantidade' palavras e viver enquanto o driver for
+// usado; cada palavra é um pixel com G, R, B nos 24 bits altos (ws2818b.pio
+// desloca pela esquerda)
+void neopixel_dma_iniciar(PIO pio, uint sm, uint32_t *quadros, uint quantidade);
+
+// Quadro livre para escrita; um quadro publicado e ainda não iniciado volta a
+// ser do escritor (será substituído pelo próximo publicar)
+uint32_t *neopixel_dma_quadro(void);
+
+// Publica o quadro escrito: inicia o DMA se a linha estiver livre, senão o
+// deixa pendente para o fim do reset em curso; nunca bloqueia
+void neopixel_dma_publicar(void);
+
+// Quadros transmitidos e quadros substituídos antes de começarem a sair
+void neopixel_dma_estatisticas(uint32_t *transmitidos, uint32_t *substituidos);
+
+#endif // NEOPIXEL_DMA_H
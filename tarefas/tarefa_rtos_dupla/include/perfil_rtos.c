@@ -0,0 +1,123 @@
+// Perfil de execução do sistema de caldeira
+// Estatísticas de CPU vêm do contador de run-time do FreeRTOS, alimentado pelo
+// timer de 1 MHz do RP2040 (time_us_64); a pilha livre vem de
+// uxTaskGetSystemState; as latências de despertar são medidas aqui
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include "perfil_rtos.h"
+
+#if CALDEIRA_PROFILING
+
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pico/stdlib.h"
+#include "memoria_caldeira.h"
+#include "supervisor_rtos.h"
+
+// Máximo de tarefas listadas no relatório
+#define PERFIL_MAX_TAREFAS      16
+
+// Histograma de latência de uma tarefa acordada por notificação
+typedef struct {
+    const char *nome;                         // Nome exibido no relatório
+    volatile uint32_t instante_notificacao;   // time_us_32() do último xTaskNotify
+    uint32_t faixas[PERFIL_FAIXAS];           // Contagem por faixa de potência de 2
+    uint32_t max_us;                          // Pior latência observada
+} perfil_despertar_t;
+
+static perfil_despertar_t despertares[PERFIL_MAX_DESPERTARES];
+
+// Contadores de run-time do relatório anterior, por número da tarefa,
+// para mostrar a carga do último período e não a acumulada desde o boot
+static configRUN_TIME_COUNTER_TYPE tempo_anterior[PERFIL_MAX_TAREFAS];
+static configRUN_TIME_COUNTER_TYPE total_anterior;
+
+void perfil_marcar_notificacao(uint32_t indice) {
+    if (indice < PERFIL_MAX_DESPERTARES) {
+        despertares[indice].instante_notificacao = time_us_32();
+    }
+}
+
+void perfil_registrar_despertar(uint32_t indice, const char *nome) {
+    if (indice >= PERFIL_MAX_DESPERTARES) {
+        return;
+    }
+
+    perfil_despertar_t *d = &despertares[indice];
+    uint32_t latencia_us = time_us_32() - d->instante_notificacao;
+
+    // Faixa = posição do bit mais significativo + 1 (0 us cai na faixa 0)
+    uint32_t faixa = (latencia_us == 0) ? 0 : 32 - __builtin_clz(latencia_us);
+    if (faixa >= PERFIL_FAIXAS) {
+        faixa = PERFIL_FAIXAS - 1;
+    }
+
+    d->nome = nome;
+    d->faixas[faixa]++;
+    if (latencia_us > d->max_us) {
+        d->max_us = latencia_us;
+    }
+}
+
+// Imprime CPU do último período e pilha livre mínima de cada tarefa
+static void perfil_imprimir_tarefas(void) {
+    static TaskStatus_t status[PERFIL_MAX_TAREFAS];
+    configRUN_TIME_COUNTER_TYPE total;
+    UBaseType_t n = uxTaskGetSystemState(status, PERFIL_MAX_TAREFAS, &total);
+    configRUN_TIME_COUNTER_TYPE periodo = total - total_anterior;
+
+    printf("\n%-22s %4s %6s %8s\n", "Tarefa", "Prio", "CPU%", "Pilha");
+    for (UBaseType_t i = 0; i < n; i++) {
+        UBaseType_t num = status[i].xTaskNumber % PERFIL_MAX_TAREFAS;
+        configRUN_TIME_COUNTER_TYPE usado = status[i].ulRunTimeCounter - tempo_anterior[num];
+        tempo_anterior[num] = status[i].ulRunTimeCounter;
+
+        // CPU em décimos de porcento, sem aritmética de ponto flutuante
+        uint32_t permil = periodo ? (uint32_t)((usado * 1000u) / periodo) : 0;
+
+        printf("%-22s %4lu %4lu.%lu %8lu\n", status[i].pcTaskName,
+               (unsigned long)status[i].uxCurrentPriority,
+               (unsigned long)(permil / 10), (unsigned long)(permil % 10),
+               (unsigned long)status[i].usStackHighWaterMark);
+    }
+    total_anterior = total;
+}
+
+// Imprime os histogramas de latência notificação -> execução
+static void perfil_imprimir_despertares(void) {
+    printf("Despertar (us): faixas <1 <2 <4 ... <%u, max\n", 1u << (PERFIL_FAIXAS - 2));
+    for (int i = 0; i < PERFIL_MAX_DESPERTARES; i++) {
+        perfil_despertar_t *d = &despertares[i];
+        if (d->nome == NULL) {
+            continue;
+        }
+
+        printf("%-22s", d->nome);
+        for (int f = 0; f < PERFIL_FAIXAS; f++) {
+            printf(" %lu", (unsigned long)d->faixas[f]);
+        }
+        printf(" | max %lu\n", (unsigned long)d->max_us);
+    }
+}
+
+// Tarefa de relatório: prioridade 1, só imprime; não interfere no controle
+static void tarefa_perfil(void *pvParameters) {
+    TickType_t ultimo = xTaskGetTickCount();
+
+    while (true) {
+        vTaskDelayUntil(&ultimo, pdMS_TO_TICKS(PERFIL_PERIODO_MS));
+        perfil_imprimir_tarefas();
+        perfil_imprimir_despertares();
+        supervisor_imprimir();                // Prazos e WCRT ao lado da CPU por tarefa
+    }
+}
+
+void perfil_iniciar(void) {
+    static StackType_t pilha[PILHA_PERFIL];
+    static StaticTask_t tcb;
+
+    xTaskCreateStatic(tarefa_perfil, "Perfil_Task", PILHA_PERFIL, NULL, 1, pilha, &tcb);
+}
+
+#endif // CALDEIRA_PROFILING
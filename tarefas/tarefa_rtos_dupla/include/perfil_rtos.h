@@ -0,0 +1,49 @@
+// Perfil de execução do sistema de caldeira (CPU, pilha e latência de despertar)
+// Habilitado em tempo de compilação com -DCALDEIRA_PROFILING=ON; desligado, as
+// macros PERFIL_* viram no-op e nenhum código ou RAM é adicionado
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef PERFIL_RTOS_H
+#define PERFIL_RTOS_H
+
+#include <stdint.h>
+
+#ifndef CALDEIRA_PROFILING
+#define CALDEIRA_PROFILING      0
+#endif
+
+// Quantidade de tarefas acordadas por notificação com histograma próprio
+#define PERFIL_MAX_DESPERTARES  4
+
+// Faixas do histograma de latência: faixa i conta valores < 2^i us
+// (a última acumula tudo acima de 2^(PERFIL_FAIXAS-2) us)
+#define PERFIL_FAIXAS           16
+
+// Período do relatório impresso pela tarefa de perfil
+#define PERFIL_PERIODO_MS       5000
+
+#if CALDEIRA_PROFILING
+
+// Registra o instante do xTaskNotify destinado à tarefa de índice 'indice'
+void perfil_marcar_notificacao(uint32_t indice);
+
+// Registra o despertar da tarefa de índice 'indice' (chamar logo após o
+// retorno de xTaskNotifyWait) e acumula a latência notificação -> execução
+void perfil_registrar_despertar(uint32_t indice, const char *nome);
+
+// Cria a tarefa de baixa prioridade que imprime o relatório periódico via USB
+void perfil_iniciar(void);
+
+#define PERFIL_MARCAR_NOTIFICACAO(indice)           perfil_marcar_notificacao(indice)
+#define PERFIL_REGISTRAR_DESPERTAR(indice, nome)    perfil_registrar_despertar((indice), (nome))
+#define PERFIL_INICIAR()                            perfil_iniciar()
+
+#else
+
+#define PERFIL_MARCAR_NOTIFICACAO(indice)           ((void)0)
+#define PERFIL_REGISTRAR_DESPERTAR(indice, nome)    ((void)0)
+#define PERFIL_INICIAR()                            ((void)0)
+
+#endif // CALDEIRA_PROFILING
+
+#endif // PERFIL_RTOS_H
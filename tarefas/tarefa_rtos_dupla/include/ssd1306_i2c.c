@@ -26,16 +26,19 @@ void ssd1306_send_command_list(uint8_t *ssd, int number) {
     }
 }
 
-// Copia buffer de referência num novo buffer, a fim de adicionar o byte de controle desde o início
+// Copia buffer de referência num buffer estático, a fim de adicionar o byte de controle desde o início
+// Sem malloc por quadro; não reentrante (o display tem um único escritor)
 void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
-    uint8_t *temp_buffer = malloc(buffer_length + 1);
+    static uint8_t temp_buffer[ssd1306_buffer_length + 1];
+
+    if (buffer_length > ssd1306_buffer_length) {
+        buffer_length = ssd1306_buffer_length;
+    }
 
     temp_buffer[0] = 0x40;
     memcpy(temp_buffer + 1, ssd, buffer_length);
 
     i2c_write_blocking(i2c1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
-
-    free(temp_buffer);
 }
 
 // Cria a lista de comandos (com base nos endereços definidos em ssd1306_i2c.h) para a inicialização do display
@@ -0,0 +1,187 @@
+// Supervisor de prazos e watchdog do sistema de caldeira
+// Liberação e conclusão são marcadas pelas próprias tarefas (ou por quem as
+// aciona) dentro de seção crítica; a tarefa supervisora só lê os registros,
+// conta cada falha uma única vez e decide se alimenta o watchdog
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include "supervisor_rtos.h"
+
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pico/stdlib.h"
+#include "caldeira_hw.h"
+
+// Registro de uma tarefa monitorada
+typedef struct {
+    const char *nome;
+    uint32_t prazo_us;
+    uint32_t batimento_max_us;        // 0: tarefa por evento
+    bool critica;
+    bool pendente;                    // Trabalho liberado e ainda não concluído
+    bool perda_contada;               // Trabalho pendente já contado como perdido
+    bool sem_batimento;               // Falha de batimento em curso já contada
+    uint32_t liberacao_us;            // Instante da liberação do trabalho pendente
+    uint32_t batimento_us;            // Instante da última conclusão
+    uint32_t trabalhos;               // Trabalhos concluídos
+    uint32_t perdidos;                // Prazos perdidos (concluídos tarde ou travados)
+    uint32_t falhas_batimento;        // Intervalos sem batimento acima do máximo
+    uint32_t wcrt_us;                 // Pior tempo de resposta observado
+    uint64_t soma_us;
+} supervisionada_t;
+
+static supervisionada_t tarefas[SUPERVISOR_MAX_TAREFAS];
+static int total_tarefas;
+static uint32_t alimentacoes;         // Verificações com o watchdog alimentado
+static uint32_t retencoes;            // Verificações com alguma tarefa crítica em falha
+
+int supervisor_registrar(const char *nome, uint32_t prazo_us,
+                         uint32_t batimento_max_us, bool critica) {
+    configASSERT(total_tarefas < SUPERVISOR_MAX_TAREFAS);
+    supervisionada_t *t = &tarefas[total_tarefas];
+
+    t->nome = nome;
+    t->prazo_us = prazo_us;
+    t->batimento_max_us = batimento_max_us;
+    t->critica = critica;
+    return total_tarefas++;
+}
+
+void supervisor_liberar(int id, uint32_t instante_us) {
+    supervisionada_t *t = &tarefas[id];
+
+    taskENTER_CRITICAL();
+    if (!t->pendente) {
+        t->pendente = true;
+        t->perda_contada = false;
+        t->liberacao_us = instante_us;
+    }
+    taskEXIT_CRITICAL();
+}
+
+void supervisor_concluir(int id) {
+    supervisionada_t *t = &tarefas[id];
+    uint32_t agora_us = time_us_32();
+
+    taskENTER_CRITICAL();
+    if (t->pendente) {
+        uint32_t resposta_us = agora_us - t->liberacao_us;
+        if (resposta_us > t->wcrt_us) {
+            t->wcrt_us = resposta_us;
+        }
+        t->soma_us += resposta_us;
+        t->trabalhos++;
+        if (resposta_us > t->prazo_us && !t->perda_contada) {
+            t->perdidos++;
+        }
+        t->pendente = false;
+    }
+    t->batimento_us = agora_us;
+    t->sem_batimento = false;
+    taskEXIT_CRITICAL();
+}
+
+// Verifica todas as tarefas; retorna true se as críticas estão saudáveis
+// As mensagens saem uma vez por falha, fora da seção crítica
+static bool supervisor_verificar(void) {
+    bool saudavel = true;
+
+    for (int i = 0; i < total_tarefas; i++) {
+        supervisionada_t *t = &tarefas[i];
+        uint32_t agora_us = time_us_32();
+        uint32_t pendente_us = 0, parado_us = 0;
+        bool atrasada, parada, nova_perda = false, nova_parada = false;
+
+        taskENTER_CRITICAL();
+        if (t->pendente) {
+            pendente_us = agora_us - t->liberacao_us;
+        }
+        parado_us = agora_us - t->batimento_us;
+        atrasada = t->pendente && pendente_us > t->prazo_us;
+        parada = t->batimento_max_us != 0 && parado_us > t->batimento_max_us;
+        if (atrasada && !t->perda_contada) {
+            t->perda_contada = true;
+            t->perdidos++;
+            nova_perda = true;
+        }
+        if (parada && !t->sem_batimento) {
+            t->sem_batimento = true;
+            t->falhas_batimento++;
+            nova_parada = true;
+        }
+        taskEXIT_CRITICAL();
+
+        if (nova_perda) {
+            printf("Supervisor: %s com trabalho pendente ha %lu us (prazo %lu us)\n",
+                   t->nome, (unsigned long)pendente_us, (unsigned long)t->prazo_us);
+        }
+        if (nova_parada) {
+            printf("Supervisor: %s sem batimento ha %lu us\n", t->nome, (unsigned long)parado_us);
+        }
+        if (t->critica && (atrasada || parada)) {
+            saudavel = false;
+        }
+    }
+    return saudavel;
+}
+
+// Tarefa supervisora: prioridade acima do controle, para enxergar inclusive o
+// controle travado; se ela própria não rodar, o watchdog também expira
+void tarefa_supervisor(void *pvParameters) {
+    bool retido = false;
+
+    if (hw_watchdog_causou_reset()) {
+        printf("Supervisor: reinicio anterior causado pelo watchdog\n");
+    }
+
+    // Batimentos contados a partir da partida do escalonador
+    uint32_t agora_us = time_us_32();
+    for (int i = 0; i < total_tarefas; i++) {
+        tarefas[i].batimento_us = agora_us;
+    }
+    hw_watchdog_iniciar(SUPERVISOR_WATCHDOG_MS);
+
+    TickType_t ultimo = xTaskGetTickCount();
+    while (true) {
+        vTaskDelayUntil(&ultimo, pdMS_TO_TICKS(SUPERVISOR_PERIODO_MS));
+
+        if (supervisor_verificar()) {
+            hw_watchdog_alimentar();
+            alimentacoes++;
+            if (retido) {
+                printf("Supervisor: tarefas criticas recuperadas, watchdog alimentado\n");
+            }
+            retido = false;
+        } else {
+            retencoes++;
+            if (!retido) {
+                printf("Supervisor: tarefa critica em falha, watchdog nao alimentado\n");
+            }
+            retido = true;
+        }
+    }
+}
+
+uint32_t supervisor_imprimir(void) {
+    uint32_t falhas = 0;
+
+    printf("Supervisor: watchdog %d ms, %lu verificacoes alimentadas, %lu retidas\n",
+           SUPERVISOR_WATCHDOG_MS, (unsigned long)alimentacoes, (unsigned long)retencoes);
+    printf("%-22s %4s %6s %8s %8s %8s %5s %6s\n",
+           "Tarefa", "Crit", "Trab", "Prazo us", "Media us", "WCRT us", "Perd", "SemBat");
+    for (int i = 0; i < total_tarefas; i++) {
+        supervisionada_t t;
+
+        taskENTER_CRITICAL();
+        t = tarefas[i];
+        taskEXIT_CRITICAL();
+
+        printf("%-22s %4s %6lu %8lu %8lu %8lu %5lu %6lu\n", t.nome, t.critica ? "sim" : "nao",
+               (unsigned long)t.trabalhos, (unsigned long)t.prazo_us,
+               (unsigned long)(t.trabalhos ? t.soma_us / t.trabalhos : 0),
+               (unsigned long)t.wcrt_us, (unsigned long)t.perdidos,
+               (unsigned long)t.falhas_batimento);
+        falhas += t.perdidos + t.falhas_batimento;
+    }
+    return falhas;
+}
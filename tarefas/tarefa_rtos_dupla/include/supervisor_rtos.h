@@ -0,0 +1,46 @@
+// Supervisor de prazos e watchdog do sistema de caldeira
+// Cada tarefa monitorada marca a liberação de um trabalho (período iniciado,
+// comando despachado, versão publicada) e a sua conclusão, que é também o
+// batimento da tarefa; o tempo entre as duas é o tempo de resposta
+// A tarefa supervisora roda acima do controle e, a cada SUPERVISOR_PERIODO_MS,
+// procura trabalhos pendentes além do prazo (tarefa travada ou sem CPU) e
+// tarefas periódicas sem batimento; o watchdog do RP2040 só é alimentado com
+// todas as tarefas críticas saudáveis, então uma falha persistente reinicia a placa
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef SUPERVISOR_RTOS_H
+#define SUPERVISOR_RTOS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Quantidade máxima de tarefas monitoradas
+#define SUPERVISOR_MAX_TAREFAS  8
+
+// Período de verificação e timeout do watchdog de hardware: uma tarefa
+// crítica pode ficar até ~SUPERVISOR_WATCHDOG_MS em falha antes do reset
+#define SUPERVISOR_PERIODO_MS   100
+#define SUPERVISOR_WATCHDOG_MS  1000
+
+// Registra uma tarefa e retorna o seu identificador (chamar antes do escalonador)
+// prazo_us: tempo máximo da liberação à conclusão de um trabalho
+// batimento_max_us: intervalo máximo entre conclusões (0: tarefa por evento)
+// critica: falha da tarefa suspende a alimentação do watchdog
+int supervisor_registrar(const char *nome, uint32_t prazo_us,
+                         uint32_t batimento_max_us, bool critica);
+
+// Marca a liberação de um trabalho no instante indicado (time_us_32)
+// Com um trabalho já pendente vale a liberação mais antiga
+void supervisor_liberar(int id, uint32_t instante_us);
+
+// Marca a conclusão do trabalho pendente e registra o batimento da tarefa
+void supervisor_concluir(int id);
+
+// Tarefa supervisora: habilita o watchdog e verifica as tarefas periodicamente
+void tarefa_supervisor(void *pvParameters);
+
+// Imprime prazos perdidos, tempo de resposta médio e pior caso (WCRT) de cada
+// tarefa; retorna o total de prazos perdidos e falhas de batimento
+uint32_t supervisor_imprimir(void);
+
+#endif // SUPERVISOR_RTOS_H
@@ -0,0 +1,79 @@
+// Formato binário do trace do sistema de caldeira
+// Compartilhado entre o firmware (trace_rtos.c) e o decodificador no host
+// (host/trace_decode.c); não depende do SDK do Pico nem do FreeRTOS
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef TRACE_FORMATO_H
+#define TRACE_FORMATO_H
+
+#include <stdint.h>
+
+// Início de cada bloco no fluxo USB ("CTRC" em little-endian)
+#define TRACE_MAGICO            0x43525443u
+
+// Tipos de bloco
+#define TRACE_BLOCO_EVENTOS     1       // Registros trace_registro_t de um núcleo
+#define TRACE_BLOCO_NOMES       2       // Registros trace_nome_t (número -> nome da tarefa)
+
+// Maior quantidade de registros em um único bloco
+#define TRACE_MAX_POR_BLOCO     64
+
+// Tamanho do nome de tarefa no bloco de nomes (truncado, com '\0')
+#define TRACE_NOME_MAX          16
+
+// Só são registradas as filas que a aplicação numera com TRACE_NOMEAR_FILA
+// (vQueueSetQueueNumber); filas com número 0 (semáforos e mutexes internos)
+// ficam de fora
+
+// Identificadores de evento
+typedef enum {
+    // Escalonador (macros trace* do FreeRTOS)
+    TRACE_TAREFA_ENTRA = 1,     // arg: número da tarefa que passa a executar
+    TRACE_NOTIFICA,             // arg: número da tarefa notificada
+    TRACE_NOTIFICA_ISR,         // arg: número da tarefa notificada a partir de ISR
+    TRACE_FILA_ENVIO,           // arg: número da fila
+    TRACE_FILA_RECEBE,          // arg: número da fila
+
+    // Aplicação (TRACE_EVT)
+    TRACE_APP_JOYSTICK = 32,    // arg: direção detectada (joystick_dir_t)
+    TRACE_APP_DESPACHO,         // arg: estado despachado
+    TRACE_APP_ATUACAO,          // arg: latência joystick -> atuação em us
+    TRACE_APP_TELEMETRIA,       // arg: estado publicado
+} trace_evento_t;
+
+// Registro de evento: 12 bytes, instante do timer de 1 MHz do RP2040
+typedef struct {
+    uint32_t instante_us;       // time_us_32() no momento do evento
+    uint8_t  evento;            // trace_evento_t
+    uint8_t  reservado[3];      // Sempre 0: o decodificador descarta o bloco se não for
+    uint32_t arg;
+} trace_registro_t;
+
+// Entrada da tabela de nomes
+typedef struct {
+    uint32_t numero;            // xTaskNumber da tarefa
+    char     nome[TRACE_NOME_MAX];
+} trace_nome_t;
+
+// Cabeçalho de bloco: seguido de 'quantidade' registros do tipo indicado
+typedef struct {
+    uint32_t magico;            // TRACE_MAGICO
+    uint8_t  tipo;              // TRACE_BLOCO_*
+    uint8_t  nucleo;            // Núcleo de origem (blocos de eventos)
+    uint16_t quantidade;
+    uint32_t perdidos;          // Total de eventos descartados com o anel cheio
+    uint32_t soma;              // FNV-1a do conteúdo após o cabeçalho
+} trace_bloco_t;
+
+// FNV-1a de 32 bits: detecta blocos corrompidos por texto de printf
+// intercalado no mesmo canal USB
+static inline uint32_t trace_soma(const void *dados, uint32_t tamanho) {
+    const uint8_t *p = (const uint8_t *)dados;
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < tamanho; i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    return h;
+}
+
+#endif // TRACE_FORMATO_H
@@ -0,0 +1,141 @@
+// Trace binário de eventos do escalonador e da aplicação
+// Um anel SPSC por núcleo: o produtor é sempre o próprio núcleo (com as
+// interrupções mascaradas por poucos ciclos, pois ISRs também registram) e o
+// consumidor é a tarefa de trace; nenhum spinlock entre núcleos é necessário
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#include "trace_rtos.h"
+
+#if CALDEIRA_TRACE
+
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "memoria_caldeira.h"
+
+#define TRACE_MASCARA           (TRACE_REGISTROS_POR_NUCLEO - 1)
+
+// Máximo de tarefas na tabela de nomes
+#define TRACE_MAX_TAREFAS       16
+
+// Anel de um núcleo: 'cabeca' só é escrita pelo produtor, 'cauda' só pelo consumidor
+typedef struct {
+    volatile uint32_t cabeca;
+    volatile uint32_t cauda;
+    volatile uint32_t perdidos;
+    trace_registro_t registros[TRACE_REGISTROS_POR_NUCLEO];
+} trace_anel_t;
+
+static trace_anel_t aneis[TRACE_NUCLEOS];
+
+// Executa da RAM: chamada dentro da troca de contexto, não pode esperar pelo XIP
+void __not_in_flash_func(trace_registrar)(uint8_t evento, uint32_t arg) {
+    uint32_t status = save_and_disable_interrupts();
+    trace_anel_t *a = &aneis[get_core_num()];
+    uint32_t cabeca = a->cabeca;
+
+    if (cabeca - a->cauda >= TRACE_REGISTROS_POR_NUCLEO) {
+        a->perdidos++;
+    } else {
+        trace_registro_t *r = &a->registros[cabeca & TRACE_MASCARA];
+        r->instante_us = time_us_32();
+        r->evento = evento;
+        r->reservado[0] = 0;    // Escrito a cada registro: nada de bytes velhos na USB
+        r->reservado[1] = 0;
+        r->reservado[2] = 0;
+        r->arg = arg;
+        __dmb();                // Registro visível antes da nova cabeça
+        a->cabeca = cabeca + 1;
+    }
+
+    restore_interrupts(status);
+}
+
+// Escreve bytes crus na USB (sem conversão LF -> CRLF)
+static void trace_escrever(const void *dados, uint32_t tamanho) {
+    const uint8_t *p = (const uint8_t *)dados;
+    for (uint32_t i = 0; i < tamanho; i++) {
+        putchar_raw(p[i]);
+    }
+}
+
+static void trace_enviar_bloco(uint8_t tipo, uint8_t nucleo, uint32_t perdidos,
+                               const void *conteudo, uint16_t quantidade, uint32_t tamanho) {
+    trace_bloco_t bloco = {
+        .magico = TRACE_MAGICO,
+        .tipo = tipo,
+        .nucleo = nucleo,
+        .quantidade = quantidade,
+        .perdidos = perdidos,
+        .soma = trace_soma(conteudo, tamanho),
+    };
+    trace_escrever(&bloco, sizeof(bloco));
+    trace_escrever(conteudo, tamanho);
+}
+
+// Tabela número -> nome, para o decodificador rotular as trocas de contexto
+static void trace_enviar_nomes(void) {
+    static TaskStatus_t status[TRACE_MAX_TAREFAS];
+    static trace_nome_t nomes[TRACE_MAX_TAREFAS];
+    UBaseType_t n = uxTaskGetSystemState(status, TRACE_MAX_TAREFAS, NULL);
+
+    memset(nomes, 0, sizeof(nomes));
+    for (UBaseType_t i = 0; i < n; i++) {
+        nomes[i].numero = status[i].xTaskNumber;
+        strncpy(nomes[i].nome, status[i].pcTaskName, TRACE_NOME_MAX - 1);
+    }
+    trace_enviar_bloco(TRACE_BLOCO_NOMES, 0, 0, nomes, n, n * sizeof(trace_nome_t));
+}
+
+// Copia o que o produtor já publicou e libera o espaço antes de transmitir,
+// para que a USB lenta não segure o anel ocupado
+static void trace_drenar(uint8_t nucleo) {
+    static trace_registro_t lote[TRACE_MAX_POR_BLOCO];
+    trace_anel_t *a = &aneis[nucleo];
+    uint32_t cabeca = a->cabeca;
+    __dmb();                    // Lê os registros só depois da cabeça
+
+    while (a->cauda != cabeca) {
+        uint32_t cauda = a->cauda;
+        uint32_t quantidade = cabeca - cauda;
+        if (quantidade > TRACE_MAX_POR_BLOCO) {
+            quantidade = TRACE_MAX_POR_BLOCO;
+        }
+
+        for (uint32_t i = 0; i < quantidade; i++) {
+            lote[i] = a->registros[(cauda + i) & TRACE_MASCARA];
+        }
+        __dmb();                // Cópia concluída antes de devolver os slots
+        a->cauda = cauda + quantidade;
+
+        trace_enviar_bloco(TRACE_BLOCO_EVENTOS, nucleo, a->perdidos, lote,
+                           quantidade, quantidade * sizeof(trace_registro_t));
+    }
+}
+
+static void tarefa_trace(void *pvParameters) {
+    uint32_t drenagens = 0;
+
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(TRACE_PERIODO_MS));
+
+        if (drenagens++ % TRACE_NOMES_A_CADA == 0) {
+            trace_enviar_nomes();
+        }
+        for (uint8_t nucleo = 0; nucleo < TRACE_NUCLEOS; nucleo++) {
+            trace_drenar(nucleo);
+        }
+    }
+}
+
+void trace_iniciar(void) {
+    static StackType_t pilha[PILHA_TRACE];
+    static StaticTask_t tcb;
+
+    xTaskCreateStatic(tarefa_trace, "Trace_Task", PILHA_TRACE, NULL, 1, pilha, &tcb);
+}
+
+#endif // CALDEIRA_TRACE
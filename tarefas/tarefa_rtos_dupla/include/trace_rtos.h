@@ -0,0 +1,63 @@
+// Trace binário de eventos do escalonador e da aplicação
+// Habilitado com -DCALDEIRA_TRACE=ON: o FreeRTOSConfig.h inclui este arquivo e
+// as macros trace* do kernel passam a gravar registros de 12 bytes em um anel
+// por núcleo, sem bloqueio entre núcleos; a tarefa de trace (prioridade 1)
+// drena os anéis em blocos binários pela USB
+// Desligado, TRACE_EVT e demais macros viram no-op
+// Autor: Jorge Wilker Mamede de Andrade e Roger - EmbarcaTech 2025
+
+#ifndef TRACE_RTOS_H
+#define TRACE_RTOS_H
+
+#include <stdint.h>
+#include "trace_formato.h"
+
+#ifndef CALDEIRA_TRACE
+#define CALDEIRA_TRACE          0
+#endif
+
+// Registros por núcleo (potência de 2): 2048 * 12 bytes = 24 KB por núcleo,
+// RAM que antes ficava reservada no heap do FreeRTOS
+#define TRACE_NUCLEOS               2
+#define TRACE_REGISTROS_POR_NUCLEO  2048
+#define TRACE_RAM_BYTES             (TRACE_NUCLEOS * TRACE_REGISTROS_POR_NUCLEO * sizeof(trace_registro_t))
+
+// Período de drenagem e de reenvio da tabela de nomes
+#define TRACE_PERIODO_MS        100
+#define TRACE_NOMES_A_CADA      50      // Drenagens entre tabelas de nomes (~5 s)
+
+#if CALDEIRA_TRACE
+
+// Grava um registro no anel do núcleo atual (tarefa, seção crítica ou ISR)
+// Com o anel cheio o registro é descartado e contado em 'perdidos'
+void trace_registrar(uint8_t evento, uint32_t arg);
+
+// Cria a tarefa que drena os anéis pela USB
+void trace_iniciar(void);
+
+#define TRACE_EVT(id, arg)                  trace_registrar((id), (uint32_t)(arg))
+#define TRACE_INICIAR()                     trace_iniciar()
+#define TRACE_NOMEAR_FILA(fila, numero)     vQueueSetQueueNumber((fila), (numero))
+
+// Macros de trace do kernel: expandidas dentro de tasks.c e queue.c, onde
+// pxCurrentTCB, pxTCB e pxQueue estão em escopo
+#define traceTASK_SWITCHED_IN() \
+    trace_registrar(TRACE_TAREFA_ENTRA, pxCurrentTCB->uxTCBNumber)
+#define traceTASK_NOTIFY(uxIndexToNotify) \
+    trace_registrar(TRACE_NOTIFICA, pxTCB->uxTCBNumber)
+#define traceTASK_NOTIFY_FROM_ISR(uxIndexToNotify) \
+    trace_registrar(TRACE_NOTIFICA_ISR, pxTCB->uxTCBNumber)
+#define traceQUEUE_SEND(pxQueue) \
+    do { if ((pxQueue)->uxQueueNumber != 0) trace_registrar(TRACE_FILA_ENVIO, (pxQueue)->uxQueueNumber); } while (0)
+#define traceQUEUE_RECEIVE(pxQueue) \
+    do { if ((pxQueue)->uxQueueNumber != 0) trace_registrar(TRACE_FILA_RECEBE, (pxQueue)->uxQueueNumber); } while (0)
+
+#else
+
+#define TRACE_EVT(id, arg)                  ((void)0)
+#define TRACE_INICIAR()                     ((void)0)
+#define TRACE_NOMEAR_FILA(fila, numero)     ((void)0)
+
+#endif // CALDEIRA_TRACE
+
+#endif // TRACE_RTOS_H